@@ -72,6 +72,9 @@ int alloc0_a(struct state_struct *state) {
        dfdmu0_file,
        ode_kq_file,
        ode_skq_file,
+       ode_adj_target_file,
+       codegen_dir,
+       codegen_cc,
        arxn_mat_file,
        solvent_string
   */
@@ -84,7 +87,7 @@ int alloc0_a(struct state_struct *state) {
   int success;
   success = 1;
   max_file_name_len = (int64_t)128;
-  num_state_files   = (int64_t)40;
+  num_state_files   = (int64_t)43;
   one_l             = (int64_t)1;
   usage             = state->usage;
   state->num_files        =  num_state_files;
@@ -28,6 +28,8 @@ specific language governing permissions and limitations under the License.
 #include "boltzmann_init.h"
 #include "boltzmann_build_agent_data_block.h"
 #include "boltzmann_run.h"
+#include "boltzmann_fork_agents.h"
+#include "boltzmann_print_agent_arena.h"
 #include "print_boundary_flux.h"
 #include "print_restart_file.h"
 int main(int argc, char **argv)
@@ -36,13 +38,17 @@ int main(int argc, char **argv)
     Calls:
       boltzmann_init
       boltzmann_run
+      boltzmann_fork_agents
+      boltzmann_print_agent_arena
   */
   struct state_struct *state;
   void *agent_data;
+  void *agent_arena;
   char *param_file_name;
   int success;
   int padi;
 
+  agent_arena = NULL;
   if (argc > 1) {
     param_file_name = argv[1];
   } else {
@@ -53,9 +59,22 @@ int main(int argc, char **argv)
     boltzmann_build_agent_data_block(state,&agent_data);
   }
   if (success) {
-    success = boltzmann_run(state,agent_data);
+    if (state->num_agents > 0) {
+      /*
+	Agent runs leave their results in the agent arena, the
+	state itself is not advanced, so the output is one row
+	per agent printed from the arena.
+      */
+      success = boltzmann_fork_agents(state,&agent_arena);
+      if (agent_arena) {
+	boltzmann_print_agent_arena(state,agent_arena);
+	agent_arena = NULL;
+      }
+    } else {
+      success = boltzmann_run(state,agent_data);
+    }
   }
-  if (state->print_output == 0) {
+  if ((state->print_output == 0) && (state->num_agents == 0)) {
     if (state->num_fixed_concs > (int64_t)0) {
       state->bndry_flux_fp = fopen(state->bndry_flux_file,"w");
       print_boundary_flux(state);
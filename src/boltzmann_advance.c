@@ -0,0 +1,138 @@
+#include "boltzmann_structs.h"
+#include "blas.h"
+#include "update_rxn_log_likelihoods.h"
+#include "choose_rxn.h"
+#include "boltzmann_advance.h"
+int boltzmann_advance(struct state_struct *state,
+		      int64_t max_steps,
+		      double lklhd_budget,
+		      double *interval_bndry_flux,
+		      int64_t *steps_taken_p,
+		      double *lklhd_used_p) {
+  /*
+    Advance state by up to max_steps reaction steps, or until the
+    sum over the steps of the reciprocal total reaction likelihood
+    (the r_sum_likelihood of choose_rxn, the mean waiting time of a
+    step) reaches lklhd_budget, for an outer agent based model that
+    steps the chemistry of each agent every tick.
+    Unlike boltzmann_run there is no agent data load or save, no
+    free_energy reset, deq_run or warmup, and the boundary flux
+    counts are not zeroed. The reaction likelihoods are left current
+    with the counts at the end of each call, so the next call starts
+    without recomputing them. Set state->advance_warm to 0 after
+    changing current_counts outside of boltzmann_advance (as
+    boltzmann_load_agent_data does) so the likelihoods are recomputed
+    at the next call.
+    The steps are the record steps of boltzmann_run without the
+    printing and free energy updates.
+
+    Called by: agent based model drivers
+    Calls:     update_rxn_log_likelihoods, choose_rxn, dcopy_,
+               fprintf, fflush
+
+    Arguments:
+    Name                TMF   Description
+    state               G*B   Pointer to the state structure,
+                              current_counts, bndry_flux_counts and the
+			      reaction likelihoods are advanced.
+    max_steps           JSI   Steps to take, no step limit if < 1.
+    lklhd_budget        DSI   Likelihood budget, no budget if <= 0.
+                              One of max_steps and lklhd_budget must be
+			      positive.
+    interval_bndry_flux D1O   If not NULL, set to the boundary flux
+                              counts of this call's steps only, of
+			      length nunique_molecules.
+    steps_taken_p       J*O   Number of steps taken.
+    lklhd_used_p        D*O   Sum of r_sum_likelihood over the steps.
+  */
+  double *current_counts;
+  double *future_counts;
+  double *bndry_flux_counts;
+  double r_sum_likelihood;
+  double lklhd_used;
+  int64_t steps;
+  int64_t i;
+  int unique_molecules;
+  int incx;
+  int rxn_choice;
+  int success;
+  int padi;
+  FILE *lfp;
+  FILE *efp;
+  success           = 1;
+  lfp               = state->lfp;
+  current_counts    = state->current_counts;
+  future_counts     = state->future_counts;
+  bndry_flux_counts = state->bndry_flux_counts;
+  unique_molecules  = (int)state->nunique_molecules;
+  incx              = 1;
+  steps             = (int64_t)0;
+  lklhd_used        = 0.0;
+  if ((max_steps < (int64_t)1) && (lklhd_budget <= 0.0)) {
+    success = 0;
+    if (lfp) {
+      fprintf(lfp,"boltzmann_advance: Error one of max_steps, %ld, and "
+	      "lklhd_budget, %le, must be positive\n",max_steps,lklhd_budget);
+      fflush(lfp);
+    }
+  }
+  if (success) {
+    if (interval_bndry_flux) {
+      for (i=0;i<unique_molecules;i++) {
+	interval_bndry_flux[i] = 0.0 - bndry_flux_counts[i];
+      }
+    }
+    if (state->advance_warm == (int64_t)0) {
+      success = update_rxn_log_likelihoods(state);
+      state->advance_warm = (int64_t)1;
+    }
+  }
+  if (success) {
+    for (;;) {
+      if ((max_steps > (int64_t)0) && (steps >= max_steps)) break;
+      if ((lklhd_budget > 0.0) && (lklhd_used >= lklhd_budget)) break;
+      /*
+	Choose a reaction, setting future_counts and the boundary
+	flux counts.
+      */
+      rxn_choice = choose_rxn(state,&r_sum_likelihood);
+      if (rxn_choice < 0) {
+	success = 0;
+	if (lfp) {
+	  fprintf(lfp,"boltzmann_advance: Error no reaction chosen after "
+		  "%ld steps\n",steps);
+	  fflush(lfp);
+	}
+	break;
+      }
+      dcopy_(&unique_molecules,future_counts,&incx,current_counts,&incx);
+      /*
+	Leave the likelihoods current for the next step or call.
+      */
+      success = update_rxn_log_likelihoods(state);
+      steps      += (int64_t)1;
+      lklhd_used += r_sum_likelihood;
+      if (success == 0) {
+	/*
+	  The step was taken, but the likelihoods are stale, so have
+	  the next call recompute them.
+	*/
+	state->advance_warm = (int64_t)0;
+	if (lfp) {
+	  fprintf(lfp,"boltzmann_advance: Error update_rxn_log_likelihoods "
+		  "failed after %ld steps\n",steps);
+	  fflush(lfp);
+	}
+	break;
+      }
+    }
+    if (interval_bndry_flux) {
+      for (i=0;i<unique_molecules;i++) {
+	interval_bndry_flux[i] += bndry_flux_counts[i];
+      }
+    }
+  }
+  *steps_taken_p = steps;
+  *lklhd_used_p  = lklhd_used;
+  return(success);
+}
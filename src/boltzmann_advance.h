@@ -0,0 +1,9 @@
+#ifndef _BOLTZMANN_ADVANCE_H_
+#define _BOLTZMANN_ADVANCE_H_ 1
+extern int boltzmann_advance(struct state_struct *state,
+			     int64_t max_steps,
+			     double lklhd_budget,
+			     double *interval_bndry_flux,
+			     int64_t *steps_taken_p,
+			     double *lklhd_used_p);
+#endif
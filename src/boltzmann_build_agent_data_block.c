@@ -6,6 +6,9 @@ int boltzmann_build_agent_data_block(struct state_struct *state,
   /*
     Allocate and fill an agent_data block from a boltzmann state_struct.
     Also sets the agent_data_length field of state.
+    With AGENT_DATA_COMPACT 1 the block is sized for the largest
+    boltzmann_pack_agent_counts encoding, and the current counts are
+    saved in agent_base_counts as the base of the count deltas.
 
     Called by: boltzmann_save_state, boltzmann_load_state
     Calls:     boltzmann_save_agent_data
@@ -15,6 +18,7 @@ int boltzmann_build_agent_data_block(struct state_struct *state,
   int64_t nunique_molecules;
   int64_t number_reactions;
   int64_t one_l;
+  int64_t i;
   int  success;
   int  padi;
   FILE *lfp;
@@ -25,15 +29,37 @@ int boltzmann_build_agent_data_block(struct state_struct *state,
   number_reactions  = state->number_reactions;
   lfp               = state->lfp;
   one_l             = (int64_t)1;
-  agent_data_length = (32 + (3*nunique_molecules) + number_reactions) * ((int64_t)8);
-  agent_data = (void*)calloc(one_l,agent_data_length);
-  if (agent_data == NULL) {
+  if (state->agent_data_compact) {
+    agent_data_length = (35 + (3*nunique_molecules) + number_reactions) *
+      ((int64_t)8);
+    if (state->agent_base_counts == NULL) {
+      state->agent_base_counts = (double*)calloc(one_l,
+						 nunique_molecules * ((int64_t)8));
+    }
+    if (state->agent_base_counts == NULL) {
+      success = 0;
+      if (lfp) {
+	fprintf(lfp,"boltzmann_build_agent_data_block: Error could not allocate %ld bytes for agent_base_counts\n",nunique_molecules*((int64_t)8));
+	fflush(lfp);
+      }
+    } else {
+      for (i=0;i<nunique_molecules;i++) {
+	state->agent_base_counts[i] = state->current_counts[i];
+      }
+    }
+  } else {
+    agent_data_length = (32 + (3*nunique_molecules) + number_reactions) * ((int64_t)8);
+  }
+  if (success) {
+    agent_data = (void*)calloc(one_l,agent_data_length);
+  }
+  if (success && (agent_data == NULL)) {
     success = 0;
     if (lfp) {
       fprintf(lfp,"boltzmann_build_agent_data_block: Error could not allocate %ld bytes for agent_state\n",agent_data_length);
       fflush(lfp);
     }
-  } else {
+  } else if (success) {
     state->agent_data_length = agent_data_length;
     success = boltzmann_save_agent_data(state,agent_data);
     if (success) {
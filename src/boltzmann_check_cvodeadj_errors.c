@@ -0,0 +1 @@
+cvodes_interface/boltzmann_check_cvodeadj_errors.c
\ No newline at end of file
@@ -0,0 +1 @@
+cvodes_interface/boltzmann_cvodes_adj_init.c
\ No newline at end of file
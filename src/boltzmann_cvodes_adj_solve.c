@@ -0,0 +1 @@
+cvodes_interface/boltzmann_cvodes_adj_solve.c
\ No newline at end of file
@@ -0,0 +1 @@
+cvodes_interface/boltzmann_cvodes_bsolve_t.c
\ No newline at end of file
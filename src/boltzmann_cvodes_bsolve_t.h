@@ -0,0 +1 @@
+cvodes_interface/boltzmann_cvodes_bsolve_t.h
\ No newline at end of file
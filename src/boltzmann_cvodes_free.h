@@ -0,0 +1 @@
+cvodes_interface/boltzmann_cvodes_free.h
\ No newline at end of file
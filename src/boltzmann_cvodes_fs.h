@@ -0,0 +1 @@
+cvodes_interface/boltzmann_cvodes_fs.h
\ No newline at end of file
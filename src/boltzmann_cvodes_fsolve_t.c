@@ -0,0 +1 @@
+cvodes_interface/boltzmann_cvodes_fsolve_t.c
\ No newline at end of file
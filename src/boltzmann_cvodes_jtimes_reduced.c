@@ -0,0 +1 @@
+cvodes_interface/boltzmann_cvodes_jtimes_reduced.c
\ No newline at end of file
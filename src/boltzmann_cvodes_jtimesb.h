@@ -0,0 +1 @@
+cvodes_interface/boltzmann_cvodes_jtimesb.h
\ No newline at end of file
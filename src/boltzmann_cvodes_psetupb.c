@@ -0,0 +1 @@
+cvodes_interface/boltzmann_cvodes_psetupb.c
\ No newline at end of file
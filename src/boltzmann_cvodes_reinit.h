@@ -0,0 +1 @@
+cvodes_interface/boltzmann_cvodes_reinit.h
\ No newline at end of file
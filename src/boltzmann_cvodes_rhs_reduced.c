@@ -0,0 +1 @@
+cvodes_interface/boltzmann_cvodes_rhs_reduced.c
\ No newline at end of file
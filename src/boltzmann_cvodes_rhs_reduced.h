@@ -0,0 +1 @@
+cvodes_interface/boltzmann_cvodes_rhs_reduced.h
\ No newline at end of file
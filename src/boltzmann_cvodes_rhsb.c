@@ -0,0 +1 @@
+cvodes_interface/boltzmann_cvodes_rhsb.c
\ No newline at end of file
@@ -0,0 +1 @@
+cvodes_interface/boltzmann_cvodes_rhsqb.c
\ No newline at end of file
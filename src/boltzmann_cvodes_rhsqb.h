@@ -0,0 +1 @@
+cvodes_interface/boltzmann_cvodes_rhsqb.h
\ No newline at end of file
@@ -0,0 +1 @@
+cvodes_interface/boltzmann_cvodes_slu_setup.c
\ No newline at end of file
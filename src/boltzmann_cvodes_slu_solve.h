@@ -0,0 +1 @@
+cvodes_interface/boltzmann_cvodes_slu_solve.h
\ No newline at end of file
@@ -0,0 +1 @@
+cvodes_interface/boltzmann_cvodes_ss_root.c
\ No newline at end of file
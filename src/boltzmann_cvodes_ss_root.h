@@ -0,0 +1 @@
+cvodes_interface/boltzmann_cvodes_ss_root.h
\ No newline at end of file
@@ -0,0 +1,263 @@
+#include "boltzmann_structs.h"
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+#include "vgrng.h"
+#include "boltzmann_save_agent_data.h"
+#include "boltzmann_run.h"
+#include "boltzmann_fork_agents.h"
+int boltzmann_fork_agents(struct state_struct *state, void **agent_arena_p) {
+  /*
+    Run state->num_agents agents with a pool of state->num_workers
+    forked worker processes on this node, no MPI needed.
+    Each agent has its own agent_data block (see
+    boltzmann_build_agent_data_block) in a shared anonymous arena that
+    every worker maps, so the results are in the arena when the workers
+    exit. The arena is
+      int64_t header[8]  header[0] next agent to run (the work queue),
+                         header[1] num_agents,
+                         header[2] agent_data_length,
+                         header[3] offset in bytes of agent block 0,
+                         header[4] number of failed agents,
+                         header[5] length in bytes of each agent block,
+      int64_t status[num_agents]  worker rank + 1 that ran the agent,
+                                  negated if boltzmann_run failed,
+                                  0 if not run,
+      num_agents agent_data blocks of agent_data_length bytes, each
+      on a 64 byte boundary.
+    Every block starts from the current counts of state, agent 0 with
+    the random number generator state of state and the others with
+    generator histories drawn from it so the agents run distinct
+    streams.
+    A worker claims the next agent with an atomic add on header[0] and
+    runs it with boltzmann_run on its fork copy of state, the state
+    and the reaction and concentration data are shared read only, copy
+    on write, with the parent. Each worker sets its mpi_rank and
+    thread_id to its worker rank and runs with print_output 0, so only
+    the arena and the log file are written.
+    If num_workers is < 1 the number of online processors is used, and
+    the pool is never larger than num_agents. If no worker can be
+    forked the agents are run in this process.
+    On return *agent_arena_p is the arena, agent a's block starts at
+    byte header[3] + a * header[5], munmap it with length
+    header[3] + num_agents * header[5].
+    Called by: boltzmann
+    Calls:     boltzmann_save_agent_data, boltzmann_run, vgrng, mmap,
+               sysconf, fork, waitpid, _exit, calloc, free, fprintf, fflush
+  */
+  void    *agent_arena;
+  char    *agent_blocks;
+  void    *agent_data;
+  int64_t *header;
+  int64_t *status;
+  int64_t *fvgrng_state;
+  int64_t *fvgrng2_state;
+  int64_t *pids;
+  int64_t num_agents;
+  int64_t num_workers;
+  int64_t agent_data_length;
+  int64_t block_length;
+  int64_t blocks_offset;
+  int64_t arena_length;
+  int64_t ask_for;
+  int64_t one_l;
+  int64_t a;
+  int64_t w;
+  int64_t k;
+  int64_t mask;
+  int64_t num_forked;
+  int64_t num_failed;
+  int64_t print_output;
+  int success;
+  int run_ok;
+  int wstatus;
+  int padi;
+  FILE *lfp;
+  FILE *efp;
+  success           = 1;
+  lfp               = state->lfp;
+  one_l             = (int64_t)1;
+  num_agents        = state->num_agents;
+  num_workers       = state->num_workers;
+  agent_data_length = state->agent_data_length;
+  agent_arena       = NULL;
+  pids              = NULL;
+  num_forked        = (int64_t)0;
+  *agent_arena_p    = NULL;
+  if (num_agents < one_l) {
+    success = 0;
+    if (lfp) {
+      fprintf(lfp,"boltzmann_fork_agents: Error num_agents, %ld, must be "
+	      "positive\n",num_agents);
+      fflush(lfp);
+    }
+  }
+  if (success) {
+    if (num_workers < one_l) {
+      num_workers = (int64_t)sysconf(_SC_NPROCESSORS_ONLN);
+      if (num_workers < one_l) {
+	num_workers = one_l;
+      }
+    }
+    if (num_workers > num_agents) {
+      num_workers = num_agents;
+    }
+    block_length  = (agent_data_length + (int64_t)63) & (~((int64_t)63));
+    blocks_offset = ((int64_t)8 + num_agents) * ((int64_t)sizeof(int64_t));
+    blocks_offset = (blocks_offset + (int64_t)63) & (~((int64_t)63));
+    arena_length  = blocks_offset + (num_agents * block_length);
+    agent_arena   = mmap(NULL,(size_t)arena_length,PROT_READ | PROT_WRITE,
+			 MAP_SHARED | MAP_ANONYMOUS,-1,0);
+    if (agent_arena == MAP_FAILED) {
+      agent_arena = NULL;
+      success = 0;
+      if (lfp) {
+	fprintf(lfp,"boltzmann_fork_agents: Error could not map %ld bytes "
+		"for the agent arena\n",arena_length);
+	fflush(lfp);
+      }
+    }
+  }
+  if (success) {
+    ask_for = num_workers * ((int64_t)sizeof(int64_t));
+    pids = (int64_t *)calloc(one_l,ask_for);
+    if (pids == NULL) {
+      success = 0;
+      if (lfp) {
+	fprintf(lfp,"boltzmann_fork_agents: Error could not allocate %ld "
+		"bytes for pids\n",ask_for);
+	fflush(lfp);
+      }
+    }
+  }
+  if (success) {
+    /*
+      The anonymous mapping is zero filled, so only the header and the
+      agent blocks need setting.
+    */
+    header        = (int64_t *)agent_arena;
+    status        = (int64_t *)&header[8];
+    agent_blocks  = (char *)agent_arena + blocks_offset;
+    header[1]     = num_agents;
+    header[2]     = agent_data_length;
+    header[3]     = blocks_offset;
+    header[5]     = block_length;
+    mask = state->vgrng_state->mask;
+    for (a=0;((a<num_agents) && success);a++) {
+      agent_data = (void *)(agent_blocks + (a * block_length));
+      success = boltzmann_save_agent_data(state,agent_data);
+      if (success && (a > 0)) {
+	fvgrng_state  = (int64_t *)agent_data;
+	fvgrng2_state = (int64_t *)&fvgrng_state[16];
+	for (k=0;k<3;k++) {
+	  /*
+	    boltzmann_load_agent_data treats a 0 history as not set.
+	  */
+	  fvgrng_state[k]  = (vgrng(state->vgrng_state) & mask) | one_l;
+	  fvgrng2_state[k] = (vgrng(state->vgrng2_state) & mask) | one_l;
+	}
+      }
+    }
+  }
+  if (success) {
+    if (lfp) {
+      fprintf(lfp,"boltzmann_fork_agents: running %ld agents on %ld "
+	      "workers\n",num_agents,num_workers);
+      fflush(lfp);
+    }
+    /*
+      Flush so the workers do not inherit and repeat buffered output.
+    */
+    fflush(NULL);
+    print_output        = state->print_output;
+    state->print_output = (int64_t)0;
+    for (w=0;w<num_workers;w++) {
+      pids[w] = (int64_t)fork();
+      if (pids[w] == (int64_t)0) {
+	state->mpi_rank  = w;
+	state->thread_id = w;
+	for (;;) {
+	  a = __sync_fetch_and_add(&header[0],one_l);
+	  if (a >= num_agents) break;
+	  agent_data = (void *)(agent_blocks + (a * block_length));
+	  run_ok = boltzmann_run(state,agent_data);
+	  if (run_ok) {
+	    status[a] = w + one_l;
+	  } else {
+	    status[a] = (int64_t)0 - (w + one_l);
+	    __sync_fetch_and_add(&header[4],one_l);
+	  }
+	}
+	if (lfp) {
+	  fflush(lfp);
+	}
+	_exit(0);
+      }
+      if (pids[w] < (int64_t)0) {
+	if (lfp) {
+	  fprintf(lfp,"boltzmann_fork_agents: Error fork failed for "
+		  "worker %ld\n",w);
+	  fflush(lfp);
+	}
+      } else {
+	num_forked += one_l;
+      }
+    }
+    if (num_forked == (int64_t)0) {
+      /*
+	No workers, run the queue here as rank 0.
+      */
+      state->mpi_rank  = (int64_t)0;
+      state->thread_id = (int64_t)0;
+      for (a=0;a<num_agents;a++) {
+	agent_data = (void *)(agent_blocks + (a * block_length));
+	run_ok = boltzmann_run(state,agent_data);
+	if (run_ok) {
+	  status[a] = one_l;
+	} else {
+	  status[a] = (int64_t)-1;
+	  header[4] += one_l;
+	}
+      }
+      header[0] = num_agents;
+    }
+    for (w=0;w<num_workers;w++) {
+      if (pids[w] > (int64_t)0) {
+	if (waitpid((pid_t)pids[w],&wstatus,0) < 0) {
+	  wstatus = 1;
+	}
+	if ((WIFEXITED(wstatus) == 0) || (WEXITSTATUS(wstatus) != 0)) {
+	  if (lfp) {
+	    fprintf(lfp,"boltzmann_fork_agents: Error worker %ld did not "
+		    "exit cleanly\n",w);
+	    fflush(lfp);
+	  }
+	}
+      }
+    }
+    /*
+      Agents claimed by a worker that died are left with status 0.
+    */
+    num_failed = (int64_t)0;
+    for (a=0;a<num_agents;a++) {
+      if (status[a] <= (int64_t)0) {
+	num_failed += one_l;
+      }
+    }
+    header[4] = num_failed;
+    state->print_output = print_output;
+    if (num_failed > (int64_t)0) {
+      success = 0;
+    }
+    if (lfp) {
+      fprintf(lfp,"boltzmann_fork_agents: %ld of %ld agents completed\n",
+	      num_agents - num_failed,num_agents);
+      fflush(lfp);
+    }
+  }
+  if (pids) {
+    free(pids);
+  }
+  *agent_arena_p = agent_arena;
+  return(success);
+}
@@ -0,0 +1,5 @@
+#ifndef _BOLTZMANN_FORK_AGENTS_H_
+#define _BOLTZMANN_FORK_AGENTS_H_ 1
+extern int boltzmann_fork_agents(struct state_struct *state, 
+				 void **agent_arena_p);
+#endif
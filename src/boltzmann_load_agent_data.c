@@ -1,12 +1,14 @@
 #include "boltzmann_structs.h"
 #include "boltzmann_flatten_vgrng_state.h"
+#include "boltzmann_unpack_agent_counts.h"
 #include "boltzmann_load_agent_data.h"
 int boltzmann_load_agent_data(struct state_struct *state, void *agent_data) {
   /*
     Transfer agent data into the state struct. This routine is to 
     facilitate the agent_data interface to biocellion.
     Called by: boltzmann_run
-    Calls      boltzmann_flatten_vgrng_state
+    Calls      boltzmann_flatten_vgrng_state,
+               boltzmann_unpack_agent_counts
     
   */
   struct vgrng_state_struct *vgrng_state;
@@ -55,10 +57,16 @@ int boltzmann_load_agent_data(struct state_struct *state, void *agent_data) {
     /*
       Load the input counts from the agent data.
     */
-    input_counts = (double*)&dagent_data[32];
     current_counts = state->current_counts;
-    for (i=0;i<nunique_molecules;i++) {
-      current_counts[i] = input_counts[i];
+    state->advance_warm = zero_l;
+    if (state->agent_data_compact) {
+      success = boltzmann_unpack_agent_counts(state,agent_data,
+					      current_counts,NULL,NULL,NULL);
+    } else {
+      input_counts = (double*)&dagent_data[32];
+      for (i=0;i<nunique_molecules;i++) {
+	current_counts[i] = input_counts[i];
+      }
     }
   }
   return(success);
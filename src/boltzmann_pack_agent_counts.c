@@ -0,0 +1,139 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_pack_agent_counts.h"
+int boltzmann_pack_agent_counts(struct state_struct *state, void *agent_data) {
+  /*
+    Compact (AGENT_DATA_COMPACT 1) encoding of the agent_data counts.
+    The 32 generator words at the start of agent_data are written by
+    boltzmann_save_agent_data as for the full block, this routine
+    fills what follows them:
+      int64_t word 32   encoded length in bytes from the start of
+                        agent_data,
+    then two sections, current_counts relative to agent_base_counts
+    and bndry_flux_counts relative to 0, each an 8 byte aligned
+      int32_t format, int32_t n
+    followed by
+      format 0  n (int32_t species, float delta) pairs, only the
+                species whose count changed,
+      format 1  nunique_molecules float deltas,
+      format 2  nunique_molecules double counts.
+    A section is format 0 or 1 only if every count is recovered
+    exactly from its float delta (counts are integers, so this holds
+    for deltas up to 2^24), format 0 when it is no longer than
+    format 1. The two sections are followed by the
+    net_lklhd_bndry_flux (nunique_molecules) and net_likelihood
+    (number_reactions) vectors of the full block as doubles, as they
+    are not exactly representable as float deltas.
+    The largest encoding is
+    8*(35 + 3*nunique_molecules + number_reactions) bytes, the
+    agent_data_length boltzmann_build_agent_data_block uses.
+    Called by: boltzmann_save_agent_data
+    Calls:     none
+  */
+  double  *counts;
+  double  *base;
+  double  *dvals;
+  float   *fvals;
+  int32_t *ivals;
+  int32_t *shdr;
+  int64_t *lagent_data;
+  char    *p;
+  double  b;
+  double  delta;
+  float   fdelta;
+  int64_t ny;
+  int64_t nrxns;
+  int64_t i;
+  int64_t nz;
+  int64_t section_length;
+  int section;
+  int narrow;
+  int format;
+  int success;
+  success     = 1;
+  ny          = state->nunique_molecules;
+  nrxns       = state->number_reactions;
+  lagent_data = (int64_t*)agent_data;
+  p           = (char*)&lagent_data[33];
+  for (section=0;section<2;section++) {
+    if (section == 0) {
+      counts = state->current_counts;
+      base   = state->agent_base_counts;
+    } else {
+      counts = state->bndry_flux_counts;
+      base   = NULL;
+    }
+    nz     = (int64_t)0;
+    narrow = 1;
+    b      = 0.0;
+    for (i=0;i<ny;i++) {
+      if (base) {
+	b = base[i];
+      }
+      delta  = counts[i] - b;
+      fdelta = (float)delta;
+      if (delta != 0.0) {
+	nz += 1;
+      }
+      if ((b + (double)fdelta) != counts[i]) {
+	narrow = 0;
+      }
+    }
+    if (narrow) {
+      if ((nz + nz) <= ny) {
+	format = 0;
+      } else {
+	format = 1;
+      }
+    } else {
+      format = 2;
+    }
+    shdr    = (int32_t*)p;
+    shdr[0] = (int32_t)format;
+    shdr[1] = (int32_t)nz;
+    p      += 8;
+    if (format == 0) {
+      ivals = (int32_t*)p;
+      fvals = (float*)p;
+      nz    = (int64_t)0;
+      for (i=0;i<ny;i++) {
+	if (base) {
+	  b = base[i];
+	}
+	delta = counts[i] - b;
+	if (delta != 0.0) {
+	  ivals[nz+nz]            = (int32_t)i;
+	  fvals[nz+nz+(int64_t)1] = (float)delta;
+	  nz += 1;
+	}
+      }
+      section_length = nz * 8;
+    } else if (format == 1) {
+      fvals = (float*)p;
+      for (i=0;i<ny;i++) {
+	if (base) {
+	  b = base[i];
+	}
+	fvals[i] = (float)(counts[i] - b);
+      }
+      section_length = ((ny + (int64_t)1) >> 1) * 8;
+    } else {
+      dvals = (double*)p;
+      for (i=0;i<ny;i++) {
+	dvals[i] = counts[i];
+      }
+      section_length = ny * 8;
+    }
+    p += section_length;
+  }
+  dvals = (double*)p;
+  for (i=0;i<ny;i++) {
+    dvals[i] = state->net_lklhd_bndry_flux[i];
+  }
+  dvals = (double*)&dvals[ny];
+  for (i=0;i<nrxns;i++) {
+    dvals[i] = state->net_likelihood[i];
+  }
+  p += (ny + nrxns) * 8;
+  lagent_data[32] = (int64_t)(p - (char*)agent_data);
+  return(success);
+}
@@ -0,0 +1,5 @@
+#ifndef _BOLTZMANN_PACK_AGENT_COUNTS_H_
+#define _BOLTZMANN_PACK_AGENT_COUNTS_H_ 1
+extern int boltzmann_pack_agent_counts(struct state_struct *state, 
+				       void *agent_data);
+#endif
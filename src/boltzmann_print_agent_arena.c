@@ -0,0 +1,206 @@
+#include "boltzmann_structs.h"
+#include <sys/mman.h>
+
+#include "boltzmann_unpack_agent_counts.h"
+#include "boltzmann_print_agent_arena.h"
+int boltzmann_print_agent_arena(struct state_struct *state,
+				void *agent_arena) {
+  /*
+    Print the results of the agents run by boltzmann_fork_agents from
+    its arena, then munmap the arena.
+    Each agent that completed gets one row in the counts_out_file,
+      agent_number counts
+    with the same columns as print_counts, and when there are fixed
+    concentrations one row in the bndry_flux_file,
+      agent_number flux
+    one column per fixed molecule, after a header row of the
+    molecule:compartment names. Agents that failed are listed in the
+    log file only.
+    The counts are read from word 32 of each agent_data block, with
+    the boundary fluxes following them, or decoded by
+    boltzmann_unpack_agent_counts when agent_data_compact is set.
+    Output files already opened by open_output_files are used,
+    otherwise they are opened here and closed on return.
+    Called by: boltzmann
+    Calls:     boltzmann_unpack_agent_counts, fopen, fclose, fprintf,
+               fflush, calloc, free, munmap
+  */
+  struct molecule_struct *sorted_molecules;
+  struct molecule_struct *molecule;
+  struct compartment_struct *sorted_compartments;
+  struct compartment_struct *cur_cmpt;
+  int64_t *header;
+  int64_t *status;
+  char    *agent_blocks;
+  void    *agent_data;
+  double  *counts;
+  double  *bndry_flux_counts;
+  double  *scratch;
+  char    *molecules_text;
+  char    *compartment_text;
+  char    *molecule_str;
+  FILE    *counts_fp;
+  FILE    *bndry_flux_fp;
+  int64_t num_agents;
+  int64_t block_length;
+  int64_t arena_length;
+  int64_t ask_for;
+  int64_t one_l;
+  int64_t a;
+  int64_t ny;
+  int64_t j;
+  int success;
+  int close_counts;
+  int close_bndry_flux;
+  int ci;
+  int padi;
+  FILE *lfp;
+  FILE *efp;
+  success          = 1;
+  lfp              = state->lfp;
+  one_l            = (int64_t)1;
+  ny               = state->nunique_molecules;
+  sorted_molecules = state->sorted_molecules;
+  sorted_compartments = state->sorted_compartments;
+  molecules_text   = state->molecules_text;
+  compartment_text = state->compartment_text;
+  header           = (int64_t *)agent_arena;
+  status           = (int64_t *)&header[8];
+  num_agents       = header[1];
+  block_length     = header[5];
+  agent_blocks     = (char *)agent_arena + header[3];
+  arena_length     = header[3] + (num_agents * block_length);
+  scratch          = NULL;
+  close_counts     = 0;
+  close_bndry_flux = 0;
+  counts_fp        = state->counts_out_fp;
+  bndry_flux_fp    = state->bndry_flux_fp;
+  if (state->agent_data_compact) {
+    ask_for = ny * ((int64_t)16);
+    scratch = (double *)calloc(one_l,ask_for);
+    if (scratch == NULL) {
+      success = 0;
+      if (lfp) {
+	fprintf(lfp,"boltzmann_print_agent_arena: Error could not allocate "
+		"%ld bytes for scratch\n",ask_for);
+	fflush(lfp);
+      }
+    }
+  }
+  if (success && (counts_fp == NULL) && (state->counts_out_file[0] != '\0')) {
+    counts_fp = fopen(state->counts_out_file,"w");
+    if (counts_fp == NULL) {
+      success = 0;
+      if (lfp) {
+	fprintf(lfp,"boltzmann_print_agent_arena: Error could not open "
+		"counts_out_file, %s\n",state->counts_out_file);
+	fflush(lfp);
+      }
+    } else {
+      close_counts = 1;
+    }
+  }
+  if (success && (state->num_fixed_concs > (int64_t)0)) {
+    if (bndry_flux_fp == NULL) {
+      bndry_flux_fp = fopen(state->bndry_flux_file,"w");
+      if (bndry_flux_fp == NULL) {
+	success = 0;
+	if (lfp) {
+	  fprintf(lfp,"boltzmann_print_agent_arena: Error could not open "
+		  "bndry_flux_file, %s\n",state->bndry_flux_file);
+	  fflush(lfp);
+	}
+      } else {
+	close_bndry_flux = 1;
+      }
+    }
+    if (bndry_flux_fp) {
+      fprintf(bndry_flux_fp,"agent");
+      molecule = sorted_molecules;
+      for (j=0;j<ny;j++) {
+	if (molecule->variable == 0) {
+	  molecule_str = (char *)&molecules_text[molecule->string];
+	  ci = molecule->c_index;
+	  if (ci > 0) {
+	    cur_cmpt = (struct compartment_struct *)&(sorted_compartments[ci]);
+	    fprintf(bndry_flux_fp,"\t%s:%s",molecule_str,
+		    (char *)&compartment_text[cur_cmpt->string]);
+	  } else {
+	    fprintf(bndry_flux_fp,"\t%s",molecule_str);
+	  }
+	}
+	molecule += 1; /* Caution address arithmetic.*/
+      }
+      fprintf(bndry_flux_fp,"\n");
+    }
+  } else {
+    bndry_flux_fp = NULL;
+  }
+  if (success) {
+    for (a=0;a<num_agents;a++) {
+      if (status[a] <= (int64_t)0) {
+	if (lfp) {
+	  fprintf(lfp,"boltzmann_print_agent_arena: agent %ld did not "
+		  "complete, no output\n",a);
+	}
+	continue;
+      }
+      agent_data = (void *)(agent_blocks + (a * block_length));
+      if (state->agent_data_compact) {
+	counts            = scratch;
+	bndry_flux_counts = &scratch[ny];
+	if (boltzmann_unpack_agent_counts(state,agent_data,counts,
+					  bndry_flux_counts,NULL,NULL) == 0) {
+	  if (lfp) {
+	    fprintf(lfp,"boltzmann_print_agent_arena: could not decode "
+		    "agent %ld, no output\n",a);
+	  }
+	  continue;
+	}
+      } else {
+	counts            = (double *)&((int64_t *)agent_data)[32];
+	bndry_flux_counts = &counts[ny];
+      }
+      if (counts_fp) {
+	fprintf(counts_fp,"%ld",a);
+	molecule = sorted_molecules;
+	for (j=0;j<ny;j++) {
+	  if ((molecule->solvent == 0) || (molecule->variable == 1)) {
+	    fprintf(counts_fp,"\t%le",counts[j]);
+	  }
+	  molecule += 1; /* Caution address arithmetic.*/
+	}
+	fprintf(counts_fp,"\n");
+      }
+      if (bndry_flux_fp) {
+	fprintf(bndry_flux_fp,"%ld",a);
+	molecule = sorted_molecules;
+	for (j=0;j<ny;j++) {
+	  if (molecule->variable == 0) {
+	    fprintf(bndry_flux_fp,"\t%le",bndry_flux_counts[j]);
+	  }
+	  molecule += 1; /* Caution address arithmetic.*/
+	}
+	fprintf(bndry_flux_fp,"\n");
+      }
+    }
+    if (lfp) {
+      fflush(lfp);
+    }
+  }
+  if (close_counts) {
+    fclose(counts_fp);
+  } else if (counts_fp) {
+    fflush(counts_fp);
+  }
+  if (close_bndry_flux) {
+    fclose(bndry_flux_fp);
+  } else if (bndry_flux_fp) {
+    fflush(bndry_flux_fp);
+  }
+  if (scratch) {
+    free(scratch);
+  }
+  munmap(agent_arena,(size_t)arena_length);
+  return(success);
+}
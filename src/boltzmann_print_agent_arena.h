@@ -0,0 +1,5 @@
+#ifndef _BOLTZMANN_PRINT_AGENT_ARENA_H_
+#define _BOLTZMANN_PRINT_AGENT_ARENA_H_ 1
+extern int boltzmann_print_agent_arena(struct state_struct *state,
+				       void *agent_arena);
+#endif
@@ -4,8 +4,23 @@
 #include "boltzmann_check_cvodesens_errors.h"
 #include "boltzmann_print_sensitivities.h"
 void boltzmann_print_sensitivities(struct state_struct *state) {
+  /*
+    Print the sensitivities at the end of a cvodes integration.
+    For forward sensitivities (compute_sensitivities == 1) the
+    ode_sens_file gets the matrix of dy/dke and the ode_dsens_file its
+    time derivative, one row per reaction.
+    For adjoint sensitivities (compute_sensitivities == 2) the 
+    ode_sens_file gets the objective value and the gradient dG/dke 
+    computed by boltzmann_cvodes_adj_solve, one row per reaction.
+
+    Called by: boltzmann_cvodes
+    Calls:     CVodeGetSens, CVodeGetSensDky, 
+               boltzmann_check_cvodesens_errors,
+               fopen, fprintf, fclose, fflush
+  */
   struct cvodes_params_struct *cvodes_params;
   double *vdata;
+  double *adj_grad;
   N_Vector *ys0;
   N_Vector *dys;
   void *cvode_mem;
@@ -32,63 +47,82 @@ void boltzmann_print_sensitivities(struct state_struct *state) {
   ys0            = cvodes_params->ys0;
   dys            = cvodes_params->dys;
   cvode_mem      = cvodes_params->cvode_mem;
-  sens_fp        = fopen(ode_sens_file,"w");
-  if (sens_fp) {
-    /*
-      Retrieve the sensitivites matrix.
-    */
-    flag = CVodeGetSens(cvode_mem,&tret,ys0);
-    success = boltzmann_check_cvodesens_errors(flag,cvode_mem,state,"GetSens");
-    if (success) {
-      fprintf(sens_fp,"prop\\mlcl");
-      for (j=0;j<ny;j++) {
-	fprintf(sens_fp,"\t%d",j);
-      }
-      fprintf(sens_fp,"\n");
+  if (state->compute_sensitivities == 2) {
+    adj_grad = cvodes_params->adj_grad;
+    sens_fp  = fopen(ode_sens_file,"w");
+    if (sens_fp) {
+      fprintf(sens_fp,"objective\t%le\n",cvodes_params->adj_objective);
+      fprintf(sens_fp,"t_final\t%le\n",cvodes_params->adj_t_final);
+      fprintf(sens_fp,"prop\tdG/dke\n");
       for (i=0;i<ns;i++) {
-	fprintf(sens_fp,"%d",i);
-	vdata = NV_DATA_S(ys0[i]);
+	fprintf(sens_fp,"%d\t%le\n",i,adj_grad[i]);
+      }
+      fclose(sens_fp);
+    } else {
+      if (lfp) {
+	fprintf(lfp,"Boltmzann_print_sensitivities: Error unable to open file %s for writing.\n",ode_sens_file);
+	fflush(lfp);
+      }
+    }
+  } else {
+    sens_fp        = fopen(ode_sens_file,"w");
+    if (sens_fp) {
+      /*
+	Retrieve the sensitivites matrix.
+      */
+      flag = CVodeGetSens(cvode_mem,&tret,ys0);
+      success = boltzmann_check_cvodesens_errors(flag,cvode_mem,state,"GetSens");
+      if (success) {
+	fprintf(sens_fp,"prop\\mlcl");
 	for (j=0;j<ny;j++) {
-	  fprintf(sens_fp,"\t%le",vdata[j]);
+	  fprintf(sens_fp,"\t%d",j);
 	}
 	fprintf(sens_fp,"\n");
+	for (i=0;i<ns;i++) {
+	  fprintf(sens_fp,"%d",i);
+	  vdata = BOLTZMANN_NV_DATA(ys0[i]);
+	  for (j=0;j<ny;j++) {
+	    fprintf(sens_fp,"\t%le",vdata[j]);
+	  }
+	  fprintf(sens_fp,"\n");
+	}
       }
-    }
-    fclose(sens_fp);
-  } else {
-    if (lfp) {
-      fprintf(lfp,"Boltmzann_print_sensitivities: Error unable to open file %s for writing.\n",ode_sens_file);
-      fflush(lfp);
-    }
-  }
-  dsens_fp       = fopen(ode_dsens_file,"w");
-  if (dsens_fp) {
-    /*
-      Retrieve the derivatives of the sensitivites matrix.
-    */
-    i = 1;
-    flag = CVodeGetSensDky(cvode_mem,tret,i,dys);
-    success = boltzmann_check_cvodesens_errors(flag,cvode_mem,state,"GetSensDky");
-    if (success) {
-      fprintf(dsens_fp,"prop\\mlcl");
-      for (j=0;j<ny;j++) {
-	fprintf(dsens_fp,"\t%d",j);
+      fclose(sens_fp);
+    } else {
+      if (lfp) {
+	fprintf(lfp,"Boltmzann_print_sensitivities: Error unable to open file %s for writing.\n",ode_sens_file);
+	fflush(lfp);
       }
-      fprintf(dsens_fp,"\n");
-      for (i=0;i<ns;i++) {
-	fprintf(dsens_fp,"%d",i);
-	vdata = NV_DATA_S(dys[i]);
+    }
+    dsens_fp       = fopen(ode_dsens_file,"w");
+    if (dsens_fp) {
+      /*
+	Retrieve the derivatives of the sensitivites matrix.
+      */
+      i = 1;
+      flag = CVodeGetSensDky(cvode_mem,tret,i,dys);
+      success = boltzmann_check_cvodesens_errors(flag,cvode_mem,state,"GetSensDky");
+      if (success) {
+	fprintf(dsens_fp,"prop\\mlcl");
 	for (j=0;j<ny;j++) {
-	  fprintf(dsens_fp,"\t%le",vdata[j]);
+	  fprintf(dsens_fp,"\t%d",j);
 	}
 	fprintf(dsens_fp,"\n");
+	for (i=0;i<ns;i++) {
+	  fprintf(dsens_fp,"%d",i);
+	  vdata = BOLTZMANN_NV_DATA(dys[i]);
+	  for (j=0;j<ny;j++) {
+	    fprintf(dsens_fp,"\t%le",vdata[j]);
+	  }
+	  fprintf(dsens_fp,"\n");
+	}
+      }
+      fclose(dsens_fp);
+    } else {
+      if (lfp) {
+	fprintf(lfp,"Boltmzann_print_sensitivities: Error unable to open file %s for writing.\n",ode_dsens_file);
+	fflush(lfp);
       }
-    }
-    fclose(dsens_fp);
-  } else {
-    if (lfp) {
-      fprintf(lfp,"Boltmzann_print_sensitivities: Error unable to open file %s for writing.\n",ode_dsens_file);
-      fflush(lfp);
     }
   }
 }
@@ -30,6 +30,7 @@ specific language governing permissions and limitations under the License.
 #include "choose_rxn.h"
 #include "boltzmann_load_agent_data.h"
 #include "deq_run.h"
+#include "hybrid_run.h"
 #include "compute_delta_g_forward_entropy_free_energy.h"
 #include "print_rxn_choice.h"
 #include "print_counts.h"
@@ -55,6 +56,7 @@ int boltzmann_run(struct state_struct *state, void *agent_data) {
     Calls:     update_rxn_log_likelihoods,
 	       choose_rxn,
                deq_run,
+               hybrid_run,
 	       vec_set_concstant,
 	       dcopy_,
 	       compute_delta_g_forward_entropy_free_energy
@@ -180,10 +182,20 @@ int boltzmann_run(struct state_struct *state, void *agent_data) {
 	      "reverse_likelihood\n");
     }
   }
-  if (use_deq != zero_l) {
+  if (state->hybrid != zero_l) {
     /*
-      Use ode solver to move from initial concentrations to
-      steady state.
+      Advance to ode_t_final with the fast reactions integrated as
+      odes and the slow reactions fired stochastically.
+    */
+    success = hybrid_run(state);
+    i = -1;
+    if (print_output) {
+      print_counts(state,i);
+    }
+  } else if ((use_deq != zero_l) || (state->use_lsqnonlin != zero_l)) {
+    /*
+      Use ode solver, or the steady state solver if use_lsqnonlin
+      is set, to move from initial concentrations to steady state.
     state->print_ode_concs = 0;
     */
     success = deq_run(state);
@@ -1,12 +1,14 @@
 #include "boltzmann_structs.h"
 #include "boltzmann_flatten_vgrng_state.h"
+#include "boltzmann_pack_agent_counts.h"
 #include "boltzmann_save_agent_data.h"
 int boltzmann_save_agent_data(struct state_struct *state, void *agent_data) {
   /*
     Transfer agent data from  the state struct. This routine is to 
     facilitate the agent_data interface to biocellion.
     Called by: boltzmann_run, boltzmann_build_agent_data_block
-    Calls      boltzmann_flatten_vgrng_state
+    Calls      boltzmann_flatten_vgrng_state,
+               boltzmann_pack_agent_counts
     
   */
   double *dagent_data;
@@ -44,7 +46,9 @@ int boltzmann_save_agent_data(struct state_struct *state, void *agent_data) {
     success = boltzmann_flatten_vgrng_state(fvgrng2_state,state->vgrng2_state,
 					    direction,&vgrng_state_length);
   }
-  if (success) {
+  if (success && state->agent_data_compact) {
+    success = boltzmann_pack_agent_counts(state,agent_data);
+  } else if (success) {
   /*
     Save the output counts to the agent data.
   */
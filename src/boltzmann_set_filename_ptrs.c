@@ -74,4 +74,7 @@ void boltzmann_set_filename_ptrs(struct state_struct *statep) {
   statep->cmpts_echo_file    = statep->arxn_mat_file + max_file_name_len;
   statep->ode_kq_file        = statep->cmpts_echo_file + max_file_name_len;
   statep->ode_skq_file       = statep->ode_kq_file + max_file_name_len;
+  statep->ode_adj_target_file = statep->ode_skq_file + max_file_name_len;
+  statep->codegen_dir        = statep->ode_adj_target_file + max_file_name_len;
+  statep->codegen_cc         = statep->codegen_dir + max_file_name_len;
 }
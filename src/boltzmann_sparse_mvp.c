@@ -6,7 +6,8 @@ int  boltzmann_sparse_mvp(int n, double *a, int *ia, int *ja, double *v,
     Form matirx vector product av = A*v where A is stored in compressed
     row sparse matrix format represented by a,ia,ja.
 
-    Called by: boltzmann_cvodes_jtimes
+    Called by: boltzmann_cvodes_jtimes, boltzmann_cvodes_fs,
+               boltzmann_cvodes_jtimes_reduced
     Calls:
   */
   double avi;
@@ -0,0 +1,32 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_sparse_tmvp.h"
+int  boltzmann_sparse_tmvp(int n, double *a, int *ia, int *ja, double *v, 
+			   double *atv) {
+  /*
+    Form transposed matrix vector product atv = A^T*v where A is an
+    n by n matrix stored in compressed row sparse matrix format 
+    represented by a,ia,ja.
+
+    Called by: boltzmann_cvodes_rhsb, boltzmann_cvodes_jtimesb
+    Calls:
+  */
+  double vi;
+  int i;
+  int j;
+  int k;
+  int success;
+  success = 1;
+  for (i=0;i<n;i++) {
+    atv[i] = 0.0;
+  }
+  for (i=0;i<n;i++) {
+    vi = v[i];
+    if (vi != 0.0) {
+      for (k=ia[i];k<ia[i+1];k++) {
+	j = ja[k];
+	atv[j] += a[k] * vi;
+      }
+    }
+  }
+  return(success);
+}
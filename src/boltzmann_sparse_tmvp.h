@@ -0,0 +1,5 @@
+#ifndef _BOLTZMANN_SPARSE_TMVP_H_
+#define _BOLTZMANN_SPARSE_TMVP_H_ 1
+extern int boltzmann_sparse_tmvp(int n, double *a, int *ia, int *ja, double *v, 
+				 double *atv);
+#endif
@@ -0,0 +1,127 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_unpack_agent_counts.h"
+int boltzmann_unpack_agent_counts(struct state_struct *state,
+				  void *agent_data,
+				  double *counts,
+				  double *bndry_flux_counts,
+				  double *net_lklhd_bndry_flux,
+				  double *net_likelihood) {
+  /*
+    Decode the compact agent_data counts written by
+    boltzmann_pack_agent_counts into counts, and into
+    bndry_flux_counts unless it is NULL, both of length
+    nunique_molecules. The stored net_lklhd_bndry_flux
+    (nunique_molecules) and net_likelihood (number_reactions)
+    vectors are copied out unless the corresponding argument is NULL.
+    For a format 0 section only the changed species are touched after
+    the copy of the base counts.
+    Called by: boltzmann_load_agent_data, boltzmann_print_agent_arena
+    Calls:     fprintf, fflush
+  */
+  double  *base;
+  double  *dvals;
+  double  *out;
+  float   *fvals;
+  int32_t *ivals;
+  int32_t *shdr;
+  int64_t *lagent_data;
+  char    *p;
+  int64_t ny;
+  int64_t nrxns;
+  int64_t i;
+  int64_t k;
+  int64_t nz;
+  int section;
+  int format;
+  int success;
+  int padi;
+  FILE *lfp;
+  FILE *efp;
+  success     = 1;
+  lfp         = state->lfp;
+  ny          = state->nunique_molecules;
+  nrxns       = state->number_reactions;
+  lagent_data = (int64_t*)agent_data;
+  p           = (char*)&lagent_data[33];
+  for (section=0;((section<2) && success);section++) {
+    if (section == 0) {
+      out  = counts;
+      base = state->agent_base_counts;
+    } else {
+      out  = bndry_flux_counts;
+      base = NULL;
+    }
+    shdr   = (int32_t*)p;
+    format = (int)shdr[0];
+    nz     = (int64_t)shdr[1];
+    p     += 8;
+    if (out == NULL) {
+      /*
+	Skip over the section, the likelihood vectors follow it.
+      */
+      if (format == 0) {
+	p += nz * 8;
+      } else if (format == 1) {
+	p += ((ny + (int64_t)1) >> 1) * 8;
+      } else {
+	p += ny * 8;
+      }
+    } else if (format == 0) {
+      if (base) {
+	for (i=0;i<ny;i++) {
+	  out[i] = base[i];
+	}
+      } else {
+	for (i=0;i<ny;i++) {
+	  out[i] = 0.0;
+	}
+      }
+      ivals = (int32_t*)p;
+      fvals = (float*)p;
+      for (k=0;k<nz;k++) {
+	out[ivals[k+k]] += (double)fvals[k+k+(int64_t)1];
+      }
+      p += nz * 8;
+    } else if (format == 1) {
+      fvals = (float*)p;
+      if (base) {
+	for (i=0;i<ny;i++) {
+	  out[i] = base[i] + (double)fvals[i];
+	}
+      } else {
+	for (i=0;i<ny;i++) {
+	  out[i] = (double)fvals[i];
+	}
+      }
+      p += ((ny + (int64_t)1) >> 1) * 8;
+    } else if (format == 2) {
+      dvals = (double*)p;
+      for (i=0;i<ny;i++) {
+	out[i] = dvals[i];
+      }
+      p += ny * 8;
+    } else {
+      success = 0;
+      if (lfp) {
+	fprintf(lfp,"boltzmann_unpack_agent_counts: Error unknown format "
+		"%d in section %d\n",format,section);
+	fflush(lfp);
+      }
+    }
+  }
+  if (success) {
+    dvals = (double*)p;
+    if (net_lklhd_bndry_flux) {
+      for (i=0;i<ny;i++) {
+	net_lklhd_bndry_flux[i] = dvals[i];
+      }
+    }
+    dvals = (double*)&dvals[ny];
+    if (net_likelihood) {
+      for (i=0;i<nrxns;i++) {
+	net_likelihood[i] = dvals[i];
+      }
+    }
+  }
+  return(success);
+}
@@ -0,0 +1,9 @@
+#ifndef _BOLTZMANN_UNPACK_AGENT_COUNTS_H_
+#define _BOLTZMANN_UNPACK_AGENT_COUNTS_H_ 1
+extern int boltzmann_unpack_agent_counts(struct state_struct *state,
+					 void *agent_data,
+					 double *counts,
+					 double *bndry_flux_counts,
+					 double *net_lklhd_bndry_flux,
+					 double *net_likelihood);
+#endif
@@ -0,0 +1 @@
+tools/bsweep.c
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "boltzmann_cvodes_headers.h"
 #include "cvodes_params_struct.h"
 /*#include "blas.h"*/
+#include "crs_column_sort_rows.h"
 #include "build_newton_matrix.h"
 int  build_newton_matrix(struct state_struct *state,
 			 double gamma,
@@ -10,7 +11,12 @@ int  build_newton_matrix(struct state_struct *state,
     Build a sparse Newton iteration matrix from the
     sparse jacobian stored in dfdy_a, dfdy_ia, dfdy_ja, and gamma
     M = I - gamma J
+    If the sparse_matrix_ordering_alg field of cvodes_params is nonzero
+    the symmetrically permuted matrix P M P^T is formed instead where
+    row i of the permuted matrix is row perm[i] of M, and its rows are
+    column sorted using the dfdy_at, dfdy_iat and dfdy_jat workspace.
     Called by: boltzmann_cvodes_psetup
+    Calls:     dscal_, crs_column_sort_rows
   */
   struct cvodes_params_struct *cvodes_params;
   double *miter_m;
@@ -21,6 +27,8 @@ int  build_newton_matrix(struct state_struct *state,
   int    *miter_jm;
   int    *dfdy_ia;
   int    *dfdy_ja;
+  int    *perm;
+  int    *iperm;
 
   int    nnz;
   int    ny;
@@ -37,6 +45,12 @@ int  build_newton_matrix(struct state_struct *state,
   int    j;
   int    k;
 
+  int    old;
+  int    pos;
+
+  int    alg;
+  int    padi;
+
   success       = 1;
   ny            = state->nunique_molecules;
   cvodes_params = state->cvodes_params;
@@ -52,24 +66,48 @@ int  build_newton_matrix(struct state_struct *state,
   a_len         = nnz << 3;
   ja_len        = nnz << 2;
   ia_len        = (ny+1) << 2;
-  memcpy(miter_m,dfdy_a,a_len);
-  memcpy(miter_im,dfdy_ia,ia_len);
-  memcpy(miter_jm,dfdy_ja,ja_len);
-  /*
-    Scale copy of a in m by -gamma;.
-  */
-  inc1 = 1;
-  dscal_(&nnz,&mgamma,miter_m,&inc1);
-  /*
-    Add 1 to the diagonal.
-  */
-  for (i=0;i<ny;i++) {
-    for (k=miter_im[i];i<miter_im[i+1];k++) {
-      j = miter_jm[k];
-      if (j == i) {
-	miter_m[k] += 1.0;
+  alg           = cvodes_params->sparse_matrix_ordering_alg;
+  if (alg == 0) {
+    memcpy(miter_m,dfdy_a,a_len);
+    memcpy(miter_im,dfdy_ia,ia_len);
+    memcpy(miter_jm,dfdy_ja,ja_len);
+    /*
+      Scale copy of a in m by -gamma;.
+    */
+    inc1 = 1;
+    dscal_(&nnz,&mgamma,miter_m,&inc1);
+    /*
+      Add 1 to the diagonal.
+    */
+    for (i=0;i<ny;i++) {
+      for (k=miter_im[i];k<miter_im[i+1];k++) {
+	j = miter_jm[k];
+	if (j == i) {
+	  miter_m[k] += 1.0;
+	}
+      }
+    }
+  } else {
+    perm  = cvodes_params->perm;
+    iperm = cvodes_params->iperm;
+    pos   = 0;
+    miter_im[0] = 0;
+    for (i=0;i<ny;i++) {
+      old = perm[i];
+      for (k=dfdy_ia[old];k<dfdy_ia[old+1];k++) {
+	j = dfdy_ja[k];
+	miter_m[pos]  = mgamma * dfdy_a[k];
+	if (j == old) {
+	  miter_m[pos] += 1.0;
+	}
+	miter_jm[pos] = iperm[j];
+	pos += 1;
       }
+      miter_im[i+1] = pos;
     }
+    crs_column_sort_rows(ny,ny,miter_m,miter_im,miter_jm,
+			 cvodes_params->dfdy_at,cvodes_params->dfdy_iat,
+			 cvodes_params->dfdy_jat);
   }
   return(success);
 }
@@ -0,0 +1,268 @@
+#include "boltzmann_structs.h"
+#include "codegen_lr8_source.h"
+#include "codegen_init.h"
+#include <stdint.h>
+#include <dlfcn.h>
+static int64_t codegen_init_seq = 0;
+int codegen_init(struct state_struct *state) {
+  /*
+    CODEGEN 1: generate the network specific lr8 kernels with
+    codegen_lr8_source, compile them into a shared object with the
+    CODEGEN_CC compiler and load them, setting state->codegen_rfc,
+    codegen_flux and codegen_drfc which lr8_gradient and
+    lr8_approximate_jacobian then call in place of their reaction and
+    species loops.
+    The source and shared object are kept in CODEGEN_DIR as
+    bz_lr8_<h>.c and bz_lr8_<h>.so where h is the 64 bit FNV-1a hash
+    of the source, a later run of the same network loads the cached
+    shared object without compiling, after checking that the cached
+    source is the same.
+    Any failure (no compiler, unwritable directory, dlopen error) is
+    logged and leaves the kernel pointers NULL so the interpreted loops
+    are used, so codegen_init always returns 1.
+    The shared object stays loaded for the life of the process, and
+    states cloned for parameter sweeps share the kernels (bsweep loads
+    them on the base state before cloning).
+    The temporary files are named with the process id and a per call
+    sequence number, so neither other processes nor other threads of
+    this one ever write the same temporary object.
+    Called by: deq_run, bsweep
+    Calls:     codegen_lr8_source, open_memstream, fopen, fread, fwrite,
+               fclose, access, mkdir, system, rename, unlink, dlopen, dlsym,
+	       dlerror, dlclose, calloc, free, fprintf, fflush
+  */
+  void     *handle;
+  void     *sym;
+  char     *source;
+  char     *cached;
+  char     *names;
+  char     *c_file;
+  char     *so_file;
+  char     *tmp_c_file;
+  char     *tmp_so_file;
+  char     *command;
+  char     *codegen_dir;
+  char     *codegen_cc;
+  int      *sizes;
+  size_t   source_len;
+  size_t   nr;
+  size_t   i;
+  uint64_t hash;
+  int64_t  ask_for;
+  int64_t  one_l;
+  int64_t  name_len;
+  int64_t  seq;
+  int      reuse;
+  int      success;
+  int      ok;
+  int      pid;
+  int      rc;
+  FILE *sfp;
+  FILE *lfp;
+  FILE *efp;
+  success     = 1;
+  lfp         = state->lfp;
+  one_l       = (int64_t)1;
+  codegen_dir = state->codegen_dir;
+  codegen_cc  = state->codegen_cc;
+  if ((state->codegen == 0) || (state->codegen_rfc != NULL)) {
+    /*
+      Not asked for, or already loaded by an earlier deq_run call.
+    */
+    return(success);
+  }
+  if ((state->gradient_choice != 8) && (state->ode_jacobian_choice != 8)) {
+    if (lfp) {
+      fprintf(lfp,"codegen_init: generated kernels are only for "
+	      "DELTA_CONCS_CHOICE 8 and ODE_JACOBIAN_CHOICE 8, CODEGEN ignored\n");
+      fflush(lfp);
+    }
+    return(success);
+  }
+  ok      = 1;
+  source  = NULL;
+  cached  = NULL;
+  names   = NULL;
+  command = NULL;
+  handle  = NULL;
+  sfp     = open_memstream(&source,&source_len);
+  if (sfp == NULL) {
+    ok = 0;
+    if (lfp) {
+      fprintf(lfp,"codegen_init: Error open_memstream failed\n");
+      fflush(lfp);
+    }
+  }
+  if (ok) {
+    codegen_lr8_source(state,sfp);
+    fclose(sfp);
+    hash = (uint64_t)14695981039346656037UL;
+    for (i=0;i<source_len;i++) {
+      hash = (hash ^ (uint64_t)((unsigned char)source[i])) *
+	(uint64_t)1099511628211UL;
+    }
+    /*
+      c_file, so_file, tmp_c_file and tmp_so_file, then the compile
+      command.
+    */
+    name_len = (int64_t)strlen(codegen_dir) + (int64_t)64;
+    ask_for  = name_len * 4;
+    names    = (char *)calloc(one_l,ask_for);
+    if (names) {
+      ask_for = (name_len * 2) + (int64_t)strlen(codegen_cc) + (int64_t)64;
+      command = (char *)calloc(one_l,ask_for);
+    }
+    if ((names == NULL) || (command == NULL)) {
+      ok = 0;
+      if (lfp) {
+	fprintf(lfp,"codegen_init: Error unable to allocate %ld bytes "
+		"for file names\n",ask_for);
+	fflush(lfp);
+      }
+    }
+  }
+  if (ok) {
+    pid         = (int)getpid();
+    seq         = __sync_fetch_and_add(&codegen_init_seq,one_l);
+    c_file      = names;
+    so_file     = c_file + name_len;
+    tmp_c_file  = so_file + name_len;
+    tmp_so_file = tmp_c_file + name_len;
+    sprintf(c_file,"%s/bz_lr8_%016lx.c",codegen_dir,hash);
+    sprintf(so_file,"%s/bz_lr8_%016lx.so",codegen_dir,hash);
+    sprintf(tmp_c_file,"%s/bz_lr8_%016lx_%d_%ld.c",codegen_dir,hash,pid,seq);
+    sprintf(tmp_so_file,"%s/bz_lr8_%016lx_%d_%ld.so",codegen_dir,hash,
+	    pid,seq);
+    /*
+      A cached shared object is used only if its source matches.
+    */
+    reuse = 0;
+    if (access(so_file,R_OK) == 0) {
+      sfp = fopen(c_file,"r");
+      if (sfp) {
+	cached = (char *)calloc(one_l,(int64_t)source_len + one_l);
+	if (cached) {
+	  nr = fread(cached,1,source_len+1,sfp);
+	  if ((nr == source_len) && (memcmp(cached,source,source_len) == 0)) {
+	    reuse = 1;
+	  }
+	  free(cached);
+	}
+	fclose(sfp);
+      }
+    }
+    if (reuse == 0) {
+      /*
+	Compile into per process and per call names then rename, so
+	concurrent runs or threads compiling the same network do not
+	load a partly written object.
+      */
+      mkdir(codegen_dir,0755);
+      sfp = fopen(tmp_c_file,"w");
+      if (sfp == NULL) {
+	ok = 0;
+	if (lfp) {
+	  fprintf(lfp,"codegen_init: Error unable to open %s\n",tmp_c_file);
+	  fflush(lfp);
+	}
+      } else {
+	nr = fwrite(source,1,source_len,sfp);
+	fclose(sfp);
+	if (nr != source_len) {
+	  ok = 0;
+	  if (lfp) {
+	    fprintf(lfp,"codegen_init: Error writing %s\n",tmp_c_file);
+	    fflush(lfp);
+	  }
+	}
+      }
+      if (ok) {
+	sprintf(command,"%s -O2 -fPIC -shared -o %s %s",codegen_cc,
+		tmp_so_file,tmp_c_file);
+	rc = system(command);
+	if (rc != 0) {
+	  ok = 0;
+	  if (lfp) {
+	    fprintf(lfp,"codegen_init: Error \"%s\" returned %d\n",command,rc);
+	    fflush(lfp);
+	  }
+	}
+      }
+      if (ok) {
+	if ((rename(tmp_so_file,so_file) != 0) ||
+	    (rename(tmp_c_file,c_file) != 0)) {
+	  ok = 0;
+	  if (lfp) {
+	    fprintf(lfp,"codegen_init: Error unable to rename %s\n",
+		    tmp_so_file);
+	    fflush(lfp);
+	  }
+	}
+      }
+      if (ok == 0) {
+	unlink(tmp_c_file);
+	unlink(tmp_so_file);
+      }
+    }
+  }
+  if (ok) {
+    handle = dlopen(so_file,RTLD_NOW | RTLD_LOCAL);
+    if (handle == NULL) {
+      ok = 0;
+      if (lfp) {
+	fprintf(lfp,"codegen_init: Error dlopen %s: %s\n",so_file,dlerror());
+	fflush(lfp);
+      }
+    }
+  }
+  if (ok) {
+    sizes = (int *)dlsym(handle,"bz_lr8_num_rxns");
+    if ((sizes == NULL) || (*sizes != (int)state->number_reactions)) {
+      ok = 0;
+    }
+    sizes = (int *)dlsym(handle,"bz_lr8_ny");
+    if ((sizes == NULL) || (*sizes != (int)state->nunique_molecules)) {
+      ok = 0;
+    }
+    sym = dlsym(handle,"bz_lr8_rfc");
+    *(void **)(&state->codegen_rfc) = sym;
+    sym = dlsym(handle,"bz_lr8_flux");
+    *(void **)(&state->codegen_flux) = sym;
+    sym = dlsym(handle,"bz_lr8_drfc");
+    *(void **)(&state->codegen_drfc) = sym;
+    if ((state->codegen_rfc == NULL) || (state->codegen_flux == NULL) ||
+	(state->codegen_drfc == NULL)) {
+      ok = 0;
+    }
+    if (ok == 0) {
+      state->codegen_rfc  = NULL;
+      state->codegen_flux = NULL;
+      state->codegen_drfc = NULL;
+      dlclose(handle);
+      if (lfp) {
+	fprintf(lfp,"codegen_init: Error %s does not match the network\n",
+		so_file);
+	fflush(lfp);
+      }
+    }
+  }
+  if (lfp) {
+    if (ok) {
+      fprintf(lfp,"codegen_init: %s lr8 kernels %s\n",
+	      reuse ? "loaded cached" : "compiled and loaded",so_file);
+    } else {
+      fprintf(lfp,"codegen_init: using the interpreted lr8 loops\n");
+    }
+    fflush(lfp);
+  }
+  if (command) {
+    free(command);
+  }
+  if (names) {
+    free(names);
+  }
+  if (source) {
+    free(source);
+  }
+  return(success);
+}
@@ -0,0 +1,4 @@
+#ifndef _CODEGEN_INIT_H_
+#define _CODEGEN_INIT_H_ 1
+extern int codegen_init(struct state_struct *state);
+#endif
@@ -0,0 +1,166 @@
+#include "boltzmann_structs.h"
+#include "codegen_lr8_source.h"
+void codegen_lr8_source(struct state_struct *state, FILE *sfp) {
+  /*
+    Write the C source of the network specific lr8 kernels loaded by
+    codegen_init (CODEGEN 1) to sfp:
+
+      bz_lr8_rfc(counts,ke,rke,activities,forward_lklhd,reverse_lklhd,rfc)
+        the reaction loop of lr8_gradient,
+      bz_lr8_flux(rfc,flux)
+        the species flux sums of lr8_gradient,
+      bz_lr8_drfc(counts,concs,count_to_conc,ke,rke,activities,drfc)
+        the reaction loop of lr8_approximate_jacobian.
+
+    The reaction and species structure, the stoichiometric coefficients
+    and the fixed/variable species flags are written in as constants and
+    the loops are unrolled. The powers are written as the repeated
+    products conc_to_pow forms and every sum is in the order of the
+    interpreted loops, so the kernels give the same values as
+    lr8_gradient and lr8_approximate_jacobian.
+    ke, rke and activities stay arguments as sensitivity parameters,
+    regulation and parameter sweeps change them after initialization.
+    The source only depends on the network so it is also the key of
+    the codegen_init cache.
+
+    Called by: codegen_init
+    Calls:     fprintf
+  */
+  struct molecule_struct *molecules;
+  struct molecule_struct *molecule;
+  struct molecules_matrix_struct *molecules_matrix;
+  struct reactions_matrix_struct *rxn_matrix;
+  double  *coefficients;
+  double  *rcoefficients;
+  double  coef;
+  double  klim;
+  int64_t *molecules_ptrs;
+  int64_t *rxn_indices;
+  int64_t *rxn_ptrs;
+  int64_t *molecule_indices;
+  int64_t int_part;
+  int64_t k;
+  int64_t j;
+  int num_rxns;
+  int ny;
+  int i;
+  int mi;
+  int pass;
+  int padi;
+
+  num_rxns         = (int)state->number_reactions;
+  ny               = (int)state->nunique_molecules;
+  molecules        = state->sorted_molecules;
+  molecules_matrix = state->molecules_matrix;
+  molecules_ptrs   = molecules_matrix->molecules_ptrs;
+  rxn_indices      = molecules_matrix->reaction_indices;
+  coefficients     = molecules_matrix->coefficients;
+  rxn_matrix       = state->reactions_matrix;
+  rxn_ptrs         = rxn_matrix->rxn_ptrs;
+  molecule_indices = rxn_matrix->molecules_indices;
+  rcoefficients    = rxn_matrix->coefficients;
+  fprintf(sfp,"/* boltzmann lr8 kernels, %d reactions %d species. */\n",
+	  num_rxns,ny);
+  fprintf(sfp,"int bz_lr8_num_rxns = %d;\n",num_rxns);
+  fprintf(sfp,"int bz_lr8_ny = %d;\n",ny);
+  /*
+    pass 0 writes bz_lr8_rfc, pass 1 bz_lr8_drfc, they share the
+    likelihood products.
+  */
+  for (pass=0;pass<2;pass++) {
+    if (pass == 0) {
+      fprintf(sfp,"void bz_lr8_rfc(const double *n, const double *ke, "
+	      "const double *rke, const double *act, double *fl, "
+	      "double *rl, double *rfc) {\n");
+    } else {
+      fprintf(sfp,"void bz_lr8_drfc(const double *n, const double *y, "
+	      "const double *c2y, const double *ke, const double *rke, "
+	      "const double *act, double *d) {\n");
+      fprintf(sfp,"  double f;\n  double r;\n  double a;\n");
+    }
+    fprintf(sfp,"  double pt;\n  double rt;\n  double tr;\n  double tp;\n"
+	    "  double c;\n");
+    for (i=0;i<num_rxns;i++) {
+      fprintf(sfp,"  pt = 1.0;\n  rt = 1.0;\n  tr = 1.0;\n  tp = 1.0;\n");
+      for (j=rxn_ptrs[i];j<rxn_ptrs[i+1];j++) {
+	mi   = (int)molecule_indices[j];
+	klim = rcoefficients[j];
+	if (klim != 0.0) {
+	  if (klim < 0.0) {
+	    klim = 0.0 - klim;
+	  }
+	  int_part = (int64_t)klim;
+	  if (int_part > 0) {
+	    fprintf(sfp,"  c = n[%d] + %.17g;\n",mi,klim);
+	    fprintf(sfp,"  %s = %s * (n[%d]",
+		    (rcoefficients[j] < 0.0) ? "rt" : "pt",
+		    (rcoefficients[j] < 0.0) ? "rt" : "pt",mi);
+	    for (k=1;k<int_part;k++) {
+	      fprintf(sfp," * n[%d]",mi);
+	    }
+	    fprintf(sfp,");\n  %s = %s * (c",
+		    (rcoefficients[j] < 0.0) ? "tr" : "tp",
+		    (rcoefficients[j] < 0.0) ? "tr" : "tp");
+	    for (k=1;k<int_part;k++) {
+	      fprintf(sfp," * c");
+	    }
+	    fprintf(sfp,");\n");
+	  }
+	}
+      } /* end for (j...) */
+      if (pass == 0) {
+	fprintf(sfp,"  fl[%d] = ke[%d] * (rt/tp);\n",i,i);
+	fprintf(sfp,"  rl[%d] = rke[%d] * (pt/tr);\n",i,i);
+	fprintf(sfp,"  rfc[%d] = (fl[%d] - rl[%d]) * act[%d];\n",i,i,i,i);
+      } else {
+	fprintf(sfp,"  f = ke[%d] * (rt/tp);\n",i);
+	fprintf(sfp,"  r = rke[%d] * (pt/tr);\n",i);
+	fprintf(sfp,"  a = act[%d];\n",i);
+	for (j=rxn_ptrs[i];j<rxn_ptrs[i+1];j++) {
+	  mi       = (int)molecule_indices[j];
+	  coef     = rcoefficients[j];
+	  molecule = (struct molecule_struct *)&molecules[mi];
+	  if ((molecule->variable == 0) || (coef == 0.0)) {
+	    fprintf(sfp,"  d[%ld] = 0.0;\n",j);
+	  } else {
+	    if (coef < 0.0) {
+	      fprintf(sfp,"  if (n[%d] > 0.0) {\n"
+		      "    d[%ld] = 0.0 - (%.17g) * ((f/y[%d]) + "
+		      "(r/(y[%d] - ((%.17g)*c2y[%d])))) * a;\n"
+		      "  } else {\n"
+		      "    d[%ld] = (r/(c2y[%d])) * a;\n  }\n",
+		      mi,j,coef,mi,mi,coef,mi,j,mi);
+	    } else {
+	      fprintf(sfp,"  if (n[%d] > 0.0) {\n"
+		      "    d[%ld] = 0.0 - %.17g * ((f/(y[%d] + "
+		      "(%.17g*c2y[%d]))) + (r/y[%d])) * a;\n"
+		      "  } else {\n"
+		      "    d[%ld] = - (f/(c2y[%d])) * a;\n  }\n",
+		      mi,j,coef,mi,coef,mi,mi,j,mi);
+	    }
+	  }
+	} /* end for (j...) */
+      }
+    } /* end for (i...) */
+    fprintf(sfp,"}\n");
+  } /* end for (pass...) */
+  fprintf(sfp,"void bz_lr8_flux(const double *rfc, double *flux) {\n"
+	  "  double f;\n");
+  molecule = molecules;
+  for (i=0;i<ny;i++) {
+    if (molecule->variable == 1) {
+      fprintf(sfp,"  f = 0.0;\n");
+      for (j=molecules_ptrs[i];j<molecules_ptrs[i+1];j++) {
+	coef = coefficients[j];
+	if (coef != 0.0) {
+	  fprintf(sfp,"  f += (rfc[%ld]*(%.17g));\n",rxn_indices[j],coef);
+	}
+      }
+      fprintf(sfp,"  flux[%d] = f;\n",i);
+    } else {
+      fprintf(sfp,"  flux[%d] = 0.0;\n",i);
+    }
+    molecule += 1; /* Caution address arithmetic here. */
+  }
+  fprintf(sfp,"}\n");
+}
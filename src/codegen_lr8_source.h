@@ -0,0 +1,4 @@
+#ifndef _CODEGEN_LR8_SOURCE_H_
+#define _CODEGEN_LR8_SOURCE_H_ 1
+extern void codegen_lr8_source(struct state_struct *state, FILE *sfp);
+#endif
@@ -0,0 +1,75 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_cvodes_headers.h"
+#include "cvodes_params_struct.h"
+#include "compartment_block_matrix.h"
+int compartment_block_matrix(struct state_struct *state) {
+  /*
+    Drop the entries of the newton iteration matrix M, stored in
+    miter_m, miter_im, miter_jm, that couple species in different
+    compartments, leaving the compartment block diagonal part of M for
+    the compartment block preconditioner (CVODES_PREC_CHOICE 4).
+    Species are grouped by the c_index field of sorted_molecules.
+    M has already been symmetrically permuted by build_newton_matrix so
+    row and column i of M are species perm[i] when the
+    sparse_matrix_ordering_alg field of cvodes_params is nonzero.
+    The rows are compacted in place and stay column sorted.
+    Called by: precondition_newton_matrix
+    Calls:
+  */
+  struct cvodes_params_struct *cvodes_params;
+  struct molecule_struct *molecules;
+  double *miter_m;
+  int    *miter_im;
+  int    *miter_jm;
+  int    *perm;
+
+  int ny;
+  int alg;
+
+  int i;
+  int j;
+
+  int k;
+  int pos;
+
+  int row_start;
+  int row_c_index;
+
+  int col_c_index;
+  int success;
+
+  success       = 1;
+  ny            = state->nunique_molecules;
+  molecules     = state->sorted_molecules;
+  cvodes_params = state->cvodes_params;
+  miter_m       = cvodes_params->miter_m;
+  miter_im      = cvodes_params->miter_im;
+  miter_jm      = cvodes_params->miter_jm;
+  perm          = cvodes_params->perm;
+  alg           = cvodes_params->sparse_matrix_ordering_alg;
+  pos           = 0;
+  row_start     = 0;
+  for (i=0;i<ny;i++) {
+    if (alg == 0) {
+      row_c_index = molecules[i].c_index;
+    } else {
+      row_c_index = molecules[perm[i]].c_index;
+    }
+    for (k=row_start;k<miter_im[i+1];k++) {
+      j = miter_jm[k];
+      if (alg == 0) {
+	col_c_index = molecules[j].c_index;
+      } else {
+	col_c_index = molecules[perm[j]].c_index;
+      }
+      if (col_c_index == row_c_index) {
+	miter_m[pos]  = miter_m[k];
+	miter_jm[pos] = j;
+	pos += 1;
+      }
+    }
+    row_start     = miter_im[i+1];
+    miter_im[i+1] = pos;
+  }
+  return(success);
+}
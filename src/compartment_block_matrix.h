@@ -0,0 +1,4 @@
+#ifndef _COMPARTMENT_BLOCK_MATRIX_H_
+#define _COMPARTMENT_BLOCK_MATRIX_H_ 1
+extern int compartment_block_matrix(struct state_struct *state);
+#endif
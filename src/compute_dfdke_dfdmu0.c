@@ -1,6 +1,7 @@
 #include "boltzmann_structs.h"
 #include "vec_set_constant.h"
 #include "conc_to_pow.h"
+#include "get_counts.h"
 #include "compute_dfdke_dfdmu0.h"
 int compute_dfdke_dfdmu0(struct state_struct *state, double *concs) {
   /*
@@ -10,7 +11,7 @@ int compute_dfdke_dfdmu0(struct state_struct *state, double *concs) {
     scratch needs to be a vectro of length at least 3*nunique_molecules
 
     Called by ode_solver.c
-    Calls     vec_set_constant, conc_to_pow, fopen, fprintf, fclose
+    Calls     vec_set_constant, conc_to_pow, get_counts, fopen, fprintf, fclose
   */
   /*
     Open the .dfdke and dfdmu0 files.
@@ -140,6 +141,17 @@ int compute_dfdke_dfdmu0(struct state_struct *state, double *concs) {
     
   }
   switch (gradient_choice) {
+  case 15:
+    /*
+      lr15_gradient is the fused form of lr8_gradient, but does not
+      save the counts so form them here, then drop through.
+    */
+    get_counts(num_species,concs,conc_to_count,counts);
+  case 16:
+    /*
+      lr16_gradient is the log space form of lr8_gradient and
+      saves the counts.
+    */
   case 8:
     /*
       Here we have
@@ -30,6 +30,7 @@ int approximate_ys0(struct state_struct *state, double *concs) {
     }
     break;
   case 8:
+  case 16:
     success = lr8_approximate_ys0(state,ys0v,concs);
     break;
   }
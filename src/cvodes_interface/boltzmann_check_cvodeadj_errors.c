@@ -0,0 +1,79 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_cvodes_headers.h"
+#include "boltzmann_check_cvodeadj_errors.h"
+int boltzmann_check_cvodeadj_errors(int flag,
+				    void *cvode_mem,
+				    struct state_struct *state,
+				    const char *routine) {
+  /*
+    Check error return codes for the CVodeAdjInit and CVode*B routines.
+    Called by: boltzmann_cvodes_adj_init, boltzmann_cvodes_adj_solve
+    Calls:     fprint, fflush
+  */
+  FILE *lfp;
+  FILE *efp;
+  int success;
+  int padi;
+  success = 1;
+  if (flag < 0) {
+    success = 0;
+    lfp = state->lfp;
+    if (lfp) {
+      switch (flag) {
+      case CV_MEM_NULL:
+	fprintf(lfp,"boltzmann_cvodes: CVode%s: CV_MEM_NULL error\n",routine);
+	fflush(lfp);
+	break;
+      case CV_MEM_FAIL:
+	fprintf(lfp,"boltzmann_cvodes: CVode%s: CV_MEM_FAIL error\n",routine);
+	fflush(lfp);
+	break;
+      case CV_ILL_INPUT:
+	fprintf(lfp,"boltzmann_cvodes: CVode%s: CV_ILL_INPUT error\n",routine);
+	fflush(lfp);
+	break;
+      case CV_NO_ADJ:
+	fprintf(lfp,"boltzmann_cvodes: CVode%s: CVodeAdjInit not called previously\n",routine);
+	fflush(lfp);
+	break;
+      case CV_NO_FWD:
+	fprintf(lfp,"boltzmann_cvodes: CVode%s: CVodeF not called previously\n",routine);
+	fflush(lfp);
+	break;
+      case CV_NO_BCK:
+	fprintf(lfp,"boltzmann_cvodes: CVode%s: no backward problem defined\n",routine);
+	fflush(lfp);
+	break;
+      case CV_BAD_TB0:
+	fprintf(lfp,"boltzmann_cvodes: CVode%s: final time outside the forward integration interval\n",routine);
+	fflush(lfp);
+	break;
+      case CV_REIFWD_FAIL:
+	fprintf(lfp,"boltzmann_cvodes: CVode%s: reinitialization of the forward problem failed at a check point\n",routine);
+	fflush(lfp);
+	break;
+      case CV_FWD_FAIL:
+	fprintf(lfp,"boltzmann_cvodes: CVode%s: forward integration between check points failed\n",routine);
+	fflush(lfp);
+	break;
+      case CV_GETY_BADT:
+	fprintf(lfp,"boltzmann_cvodes: CVode%s: forward solution interpolation failed\n",routine);
+	fflush(lfp);
+	break;
+      case CV_NO_QUAD:
+	fprintf(lfp,"boltzmann_cvodes: CVode%s: quadratures were not initialized\n",routine);
+	fflush(lfp);
+	break;
+      case CV_BAD_T:
+	fprintf(lfp,"boltzmann_cvodes: CVode%s: invalid t argument\n",routine);
+	fflush(lfp);
+	break;
+      default:
+	fprintf(lfp,"boltzmann_cvodes: CVode%s: failed with flag %d\n",routine,flag);
+	fflush(lfp);
+	break;
+      }
+    }
+  }
+  return(success);
+}
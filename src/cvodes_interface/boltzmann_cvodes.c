@@ -3,28 +3,51 @@
 #include "cvodes_params_struct.h"
 #include "boltzmann_size_jacobian.h"
 #include "boltzmann_cvodes_rhs.h"
+#include "boltzmann_cvodes_rhs_reduced.h"
+#include "moiety_reduce.h"
+#include "moiety_expand.h"
 #include "boltzmann_print_cvodeinit_errors.h"
 #include "boltzmann_cvodes_init.h"
+#include "boltzmann_cvodes_reinit.h"
+#include "boltzmann_cvodes_free.h"
+#include "order_newton_matrix.h"
 #include "boltzmann_print_cvode_error.h"
 #include "boltzmann_monitor_ode.h"
+#include "ode_print_concs.h"
+#include "ode_dense_output_time.h"
 #include "boltzmann_print_sensitivities.h"
+#include "boltzmann_cvodes_adj_solve.h"
 #include "vec_set_constant.h"
 #include  "ode_test_steady_state.h"
 #include "boltzmann_cvodes.h"
 int boltzmann_cvodes(struct state_struct *state, double *concs) {
   /*
     Invoke the cvodes (from sundials out of llnl) ode solver.
+    With CVODES_REUSE_CONTEXT 1 the integrator context is kept in
+    cvodes_params after a successful integration and re-armed by
+    boltzmann_cvodes_reinit on the next call, instead of being built
+    and freed every time.
     Called by: ode_solver
     Calls:     N_VMake_Serial, 
                CVodeCreate,
 	       CVodeInit,
 	       CVode,
 	       boltzmann_cvodes_rhs,
+	       boltzmann_cvodes_rhs_reduced,
+	       moiety_reduce,
+	       moiety_expand,
 	       boltzmann_print_cvodeinit_errors,
 	       boltzmann_cvodes_init,
+	       boltzmann_cvodes_reinit,
+	       boltzmann_cvodes_free,
+	       CVodeF,
+	       boltzmann_cvodes_adj_solve,
+	       order_newton_matrix,
 	       boltzmann_print_cvode_error,
 	       boltzmann_monitor_ode,
-	       fprintf, fflush
+	       ode_print_concs,
+	       ode_dense_output_time,
+	       calloc, fprintf, fflush
   */
   struct cvodes_params_struct *cvodes_params;
   /*
@@ -55,7 +78,9 @@ int boltzmann_cvodes(struct state_struct *state, double *concs) {
   double *p;
   double *rp;
   double *pbar;
+  double *sens_dfdke;
   double *ys0v;
+  double *thread_rows;
   double *dfdy;
   double *fac;
   double *thresh;
@@ -85,6 +110,10 @@ int boltzmann_cvodes(struct state_struct *state, double *concs) {
   int    *sindex;
 
   int    *plist;
+  int    *perm;
+  int    *iperm;
+  int    *prec_ulev;
+  int    *thread_masks;
 
   double t0;
   double tfinal;
@@ -97,6 +126,7 @@ int boltzmann_cvodes(struct state_struct *state, double *concs) {
 
   int64_t ode_rxn_view_freq;
   int64_t ode_rxn_view_step;
+  int64_t dense_output;
 
   int64_t ask_for;
 
@@ -131,6 +161,16 @@ int boltzmann_cvodes(struct state_struct *state, double *concs) {
   int ns;
 
   int done;
+  int thread_len;
+
+  int nthreads;
+  int adjoint;
+
+  int ncheck;
+  int reduced;
+  int ny_ode;
+
+  int reused;
   int padi;
 
   FILE *lfp;
@@ -142,11 +182,17 @@ int boltzmann_cvodes(struct state_struct *state, double *concs) {
   drfc_len          = state->number_molecules;
   lfp               = state->lfp;
   ns                = state->number_reactions;
+  nthreads          = (int)state->num_threads;
+  adjoint           = (state->compute_sensitivities == 2);
   jacobian_choice   = state->ode_jacobian_choice;
   ode_rxn_view_freq = state->ode_rxn_view_freq;
   print_output  = state->print_output;
   cvodes_params = (struct cvodes_params_struct *)state->cvodes_params;
   ode23tb_params = NULL;
+  cvode_mem      = NULL;
+  y0             = NULL;
+  dfdy           = NULL;
+  f0             = NULL;
   if (jacobian_choice == 0) {
     ode23tb_params = (struct ode23tb_params_struct *)state->ode23tb_params;
   }
@@ -154,6 +200,38 @@ int boltzmann_cvodes(struct state_struct *state, double *concs) {
   lmm = cvodes_params->linear_multistep_method;
   iter = cvodes_params->iterative_method;
   cvode_mxsteps = cvodes_params->mxsteps;
+  /*
+    Integrate only the independent species if moiety reduction was
+    requested (init_moieties called in deq_run). The preconditioner and
+    sensitivity routines and the sparse direct solver work on the full
+    species vector so reduction is only done without them.
+  */
+  reduced = 0;
+  ny_ode  = ny;
+  if (state->reduce_moieties && (state->link_matrix != NULL) &&
+      (state->number_independent < (int64_t)ny)) {
+    if ((state->compute_sensitivities == 0) && 
+	(cvodes_params->pretype == PREC_NONE) &&
+	(cvodes_params->linear_solver_method != 10)) {
+      reduced = 1;
+      ny_ode  = (int)state->number_independent;
+    } else {
+      if (lfp) {
+	fprintf(lfp,"boltzmann_cvodes: moiety reduction is not available "
+		"with a preconditioner, the SLU solver or sensitivities, "
+		"integrating all species\n");
+	fflush(lfp);
+      }
+    }
+  }
+  cvodes_params->ny_ode = ny_ode;
+  /*
+    Re-arm the context kept from the last call if there is one.
+  */
+  reused = 0;
+  if (cvodes_params->cvode_mem != NULL) {
+    reused = boltzmann_cvodes_reinit(state,concs,reduced);
+  }
   /*
     The cvodes routines will need some space for formation of the jacobian,
     drfc[number_molecules)  jacobian formation workspace.
@@ -170,7 +248,9 @@ int boltzmann_cvodes(struct state_struct *state, double *concs) {
     frow (nunique_molecules)
     srow (nunique_molecules)
     pbar (number_reactions)
+    sens_dfdke (number_reactions)
     ys0v (nunqiue_molecules * number_reactions)
+    thread_rows (num_threads * nunique_molecules, only if num_threads > 1)
 
     ints 
     dfdy_ia(nunqiue_molecules+1)
@@ -190,6 +270,10 @@ int boltzmann_cvodes(struct state_struct *state, double *concs) {
     column_mask (unique_molecules)
     sindex (unique_molecules)
     plist  (number_reactions)
+    perm   (nunique_molecules)
+    iperm  (nunique_molecules)
+    prec_ulev (nnzu)
+    thread_masks (num_threads * nunique_molecules, only if num_threads > 1)
     
     Actually though much less space might be needed there 
     might be a formula to compute the needed size of dfdy based on the reaction
@@ -201,84 +285,116 @@ int boltzmann_cvodes(struct state_struct *state, double *concs) {
     2 scratch vectors of ny_ints for forming the factorizations.
     Hmm we also need space for the drfc vector of length number_molecules.
   */
-  boltzmann_size_jacobian(state);
-  nnz  = cvodes_params->nnz;
-  nnzm = cvodes_params->nnzm;
-  nnzl = cvodes_params->nnzl;
-  nnzu = cvodes_params->nnzu;
-  num_doubles = (nnz + nnz + nnzm + nnzl + nnzu + (5*ny) + (3*ns) + (ns*ny));
-  num_ints    = (num_doubles + 5*ny + 5 + ns);
-  num_doubles = num_doubles + (num_ints + (num_ints & 1))/2;
-  drfc_len    = state->number_molecules * 2;
-  ask_for = (num_doubles + drfc_len) << 3;
-  drfc    = (double *)calloc(one_l,ask_for);
-  if (drfc == NULL ) {
-    success = 0;
-    if (lfp) {
-      fprintf(lfp,"boltzmann_cvodes: Error unable to allocate %ld bytes needed for  jacobian workspace\n",ask_for);
-      fflush(lfp);
+  if (reused == 0) {
+    boltzmann_size_jacobian(state);
+    nnz  = cvodes_params->nnz;
+    nnzm = cvodes_params->nnzm;
+    nnzl = cvodes_params->nnzl;
+    nnzu = cvodes_params->nnzu;
+    thread_len = 0;
+#ifdef _OPENMP
+    if (state->num_threads > 1) {
+      thread_len = ((int)state->num_threads) * ny;
+    }
+#endif
+    num_doubles = (nnz + nnz + nnzm + nnzl + nnzu + (5*ny) + (4*ns) + (ns*ny) + thread_len);
+    num_ints    = (num_doubles + 7*ny + 5 + ns + nnzu + thread_len);
+    num_doubles = num_doubles + (num_ints + (num_ints & 1))/2;
+    drfc_len    = state->number_molecules * 2;
+    ask_for = (num_doubles + drfc_len) << 3;
+    drfc    = (double *)calloc(one_l,ask_for);
+    if (drfc == NULL ) {
+      success = 0;
+      if (lfp) {
+	fprintf(lfp,"boltzmann_cvodes: Error unable to allocate %ld bytes needed for  jacobian workspace\n",ask_for);
+	fflush(lfp);
+      }
+    } else {
+      dfdy_a       = &drfc[drfc_len];
+      dfdy_at      = &dfdy_a[nnz];
+      miter_m  	 = &dfdy_at[nnz];
+      prec_l   	 = &miter_m[nnzm];
+      prec_u   	 = &prec_l[nnzl];
+      prec_row 	 = &prec_u[nnzu];
+      recip_diag_u = &prec_row[ny];
+      frow         = &recip_diag_u[ny];
+      srow         = &frow[ny];
+      f0           = &srow[ny];
+      p            = &f0[ny];
+      rp           = &p[ns];
+      pbar         = &rp[ns];
+      sens_dfdke   = &pbar[ns];
+      ys0v         = &sens_dfdke[ns];
+      thread_rows  = &ys0v[ny*ns];
+      dfdy_ia  	 = (int*)&thread_rows[thread_len];
+      dfdy_ja  	 = &dfdy_ia[ny+1];
+      dfdy_iat     = &dfdy_ja[nnz];
+      dfdy_jat     = &dfdy_iat[ny+1];
+      miter_im 	 = &dfdy_jat[nnz];
+      miter_jm 	 = &miter_im[ny+1];
+      prec_il  	 = &miter_jm[nnzm];
+      prec_jl  	 = &prec_il[ny+1];
+      prec_iu  	 = &prec_jl[nnzl];
+      prec_ju      = &prec_iu[ny+1];
+      lindex       = &prec_ju[nnzu];
+      uindex       = &lindex[ny];
+      column_mask  = &uindex[ny];
+      sindex       = &column_mask[ny];
+      plist        = &sindex[ny];
+      perm         = &plist[ns];
+      iperm        = &perm[ny];
+      prec_ulev    = &iperm[ny];
+      thread_masks = &prec_ulev[nnzu];
+      cvodes_params->drfc         = drfc;
+      cvodes_params->dfdy_a  	= dfdy_a;
+      cvodes_params->dfdy_at  	= dfdy_at;
+      cvodes_params->miter_m 	= miter_m;
+      cvodes_params->prec_l  	= prec_l;
+      cvodes_params->prec_u  	= prec_u;
+      cvodes_params->prec_row     = prec_row;
+      cvodes_params->recip_diag_u = recip_diag_u;
+      cvodes_params->frow         = frow;
+      cvodes_params->srow         = srow;
+      cvodes_params->p            = p;
+      cvodes_params->rp           = rp;
+      cvodes_params->pbar         = pbar;
+      cvodes_params->sens_dfdke   = sens_dfdke;
+      cvodes_params->root_f       = f0;
+      cvodes_params->ys0v         = ys0v;
+      cvodes_params->slu_factors  = NULL;
+      cvodes_params->dfdy_ia      = dfdy_ia;
+      cvodes_params->dfdy_ja      = dfdy_ja;
+      cvodes_params->dfdy_iat     = dfdy_iat;
+      cvodes_params->dfdy_jat     = dfdy_jat;
+      cvodes_params->miter_im     = miter_im;
+      cvodes_params->miter_jm     = miter_jm;
+      cvodes_params->prec_il      = prec_il;
+      cvodes_params->prec_jl      = prec_jl;
+      cvodes_params->prec_iu      = prec_iu;
+      cvodes_params->prec_ju      = prec_ju;
+      cvodes_params->lindex       = lindex;
+      cvodes_params->uindex       = uindex;
+      cvodes_params->column_mask  = column_mask;
+      cvodes_params->sindex       = sindex;
+      cvodes_params->plist        = plist;
+      cvodes_params->perm         = perm;
+      cvodes_params->iperm        = iperm;
+      cvodes_params->prec_ulev    = prec_ulev;
+      if (thread_len > 0) {
+	cvodes_params->thread_rows  = thread_rows;
+	cvodes_params->thread_masks = thread_masks;
+      } else {
+	cvodes_params->thread_rows  = NULL;
+	cvodes_params->thread_masks = NULL;
+      }
+      /*
+	Fill reducing ordering of the Newton iteration matrix
+	for the preconditioner.
+      */
+      success = order_newton_matrix(state);
     }
-  } else {
-    dfdy_a       = &drfc[drfc_len];
-    dfdy_at      = &dfdy_a[nnz];
-    miter_m  	 = &dfdy_at[nnz];
-    prec_l   	 = &miter_m[nnzm];
-    prec_u   	 = &prec_l[nnzl];
-    prec_row 	 = &prec_u[nnzu];
-    recip_diag_u = &prec_row[ny];
-    frow         = &recip_diag_u[ny];
-    srow         = &frow[ny];
-    f0           = &srow[ny];
-    p            = &f0[ny];
-    rp           = &p[ns];
-    pbar         = &rp[ns];
-    ys0v         = &pbar[ns];
-    dfdy_ia  	 = (int*)&ys0v[ny*ns];
-    dfdy_ja  	 = &dfdy_ia[ny+1];
-    dfdy_iat     = &dfdy_ja[nnz];
-    dfdy_jat     = &dfdy_iat[ny+1];
-    miter_im 	 = &dfdy_jat[nnz];
-    miter_jm 	 = &miter_im[ny+1];
-    prec_il  	 = &miter_jm[nnzm];
-    prec_jl  	 = &prec_il[ny+1];
-    prec_iu  	 = &prec_jl[nnzl];
-    prec_ju      = &prec_iu[ny+1];
-    lindex       = &prec_ju[nnzu];
-    uindex       = &lindex[ny];
-    column_mask  = &uindex[ny];
-    sindex       = &column_mask[ny];
-    plist        = &sindex[ny];
-    cvodes_params->drfc         = drfc;
-    cvodes_params->dfdy_a  	= dfdy_a;
-    cvodes_params->dfdy_at  	= dfdy_at;
-    cvodes_params->miter_m 	= miter_m;
-    cvodes_params->prec_l  	= prec_l;
-    cvodes_params->prec_u  	= prec_u;
-    cvodes_params->prec_row     = prec_row;
-    cvodes_params->recip_diag_u = recip_diag_u;
-    cvodes_params->frow         = frow;
-    cvodes_params->srow         = srow;
-    cvodes_params->p            = p;
-    cvodes_params->rp           = rp;
-    cvodes_params->pbar         = pbar;
-    cvodes_params->ys0v         = ys0v;
-    cvodes_params->dfdy_ia      = dfdy_ia;
-    cvodes_params->dfdy_ja      = dfdy_ja;
-    cvodes_params->dfdy_iat     = dfdy_iat;
-    cvodes_params->dfdy_jat     = dfdy_jat;
-    cvodes_params->miter_im     = miter_im;
-    cvodes_params->miter_jm     = miter_jm;
-    cvodes_params->prec_il      = prec_il;
-    cvodes_params->prec_jl      = prec_jl;
-    cvodes_params->prec_iu      = prec_iu;
-    cvodes_params->prec_ju      = prec_ju;
-    cvodes_params->lindex       = lindex;
-    cvodes_params->uindex       = uindex;
-    cvodes_params->column_mask  = column_mask;
-    cvodes_params->sindex       = sindex;
-    cvodes_params->plist        = plist;
   }
-  if (success) {
+  if (success && (reused == 0)) {
     if (jacobian_choice == 0) {
       num_doubles = ny*ny + 5*ny;
       ask_for = num_doubles << 3;
@@ -289,11 +405,13 @@ int boltzmann_cvodes(struct state_struct *state, double *concs) {
 	fdel   = (double*)&thresh[ny];
 	fdiff  = (double*)&fdel[ny];
 	dfdy_tmp = (double*)&fdiff[ny];
+	cvodes_params->nj_dfdy = dfdy;
 	ode23tb_params->dfdy = dfdy;
 	ode23tb_params->fac  = fac;
 	ode23tb_params->thresh = thresh;
 	ode23tb_params->fdel   = fdel;
-	ode23tb_params->fdel   = fdel;
+	ode23tb_params->fdiff  = fdiff;
+	ode23tb_params->dfdy_tmp = dfdy_tmp;
 	ode23tb_params->num_jac_first_time = 1;
 	ode23tb_params->nf     = 0;
 	njthreshold = state->nj_thresh;
@@ -322,6 +440,24 @@ int boltzmann_cvodes(struct state_struct *state, double *concs) {
       t0 = 0.0;
       boltzmann_monitor_ode(state,t0,concs);
     }
+    /*
+      With dense output the concentrations are printed at the
+      ode_dense_output_time times, cvodes interpolates to them
+      in CV_NORMAL mode.
+    */
+    dense_output = 0;
+    if (print_output && (state->ode_dense_output > 0)) {
+      dense_output = state->ode_dense_output;
+      t0 = 0.0;
+      ode_print_concs(state,t0,concs);
+    }
+  }
+  if (success && reused) {
+    cvode_mem = cvodes_params->cvode_mem;
+    y0        = cvodes_params->y0;
+    f0        = cvodes_params->root_f;
+  }
+  if (success && (reused == 0)) {
     cvode_mem = CVodeCreate(lmm,iter);
     if (cvode_mem == NULL) {
       success = 0;
@@ -329,6 +465,8 @@ int boltzmann_cvodes(struct state_struct *state, double *concs) {
 	fprintf(lfp,"boltzmann_cvodes: Error cvode_mem was null, lmm = %d, iter = %d\n",lmm,iter);
 	fflush(lfp);
       }
+    } else {
+      cvodes_params->cvode_mem = cvode_mem;
     }
   }
   /*
@@ -336,12 +474,20 @@ int boltzmann_cvodes(struct state_struct *state, double *concs) {
     y0 Need to look at sectin 7.1-7.4 for details. Also need to test for
     success from this call, I suppose y0 != NULL
   */
-  if (success) {
-    y0 = N_VMake_Serial(ny,concs);
+  if (success && (reused == 0)) {
+    if (reduced) {
+      y0 = BOLTZMANN_NV_NEW(ny_ode,nthreads);
+      if (y0 != NULL) {
+	moiety_reduce(state,concs,BOLTZMANN_NV_DATA(y0));
+      }
+    } else {
+      y0 = BOLTZMANN_NV_MAKE(ny,concs,nthreads);
+    }
+    cvodes_params->y0 = y0;
     if (y0 == NULL) {
       success = 0;
       if (lfp) {
-	fprintf(lfp,"boltzmann_cvodes: Error creating nvector y0 of length %d from concs\n",ny);
+	fprintf(lfp,"boltzmann_cvodes: Error creating nvector y0 of length %d from concs\n",ny_ode);
 	fflush(lfp);
       }
     }
@@ -350,11 +496,13 @@ int boltzmann_cvodes(struct state_struct *state, double *concs) {
     Initialize the cvode solver specifying the rhs function, t0, and y0.
     This must set the internal problems size, ny from the nvector y0.
   */
-  if (success) {
-    cvodes_params->y0 = y0;
+  if (success && (reused == 0)) {
     t0 = 0.0;
-    cvodes_params->cvode_mem = cvode_mem;
-    flag = CVodeInit(cvode_mem,boltzmann_cvodes_rhs,t0,y0);
+    if (reduced) {
+      flag = CVodeInit(cvode_mem,boltzmann_cvodes_rhs_reduced,t0,y0);
+    } else {
+      flag = CVodeInit(cvode_mem,boltzmann_cvodes_rhs,t0,y0);
+    }
     if (flag < 0) {
       success = 0;
       boltzmann_print_cvodeinit_errors(flag,cvode_mem,state);
@@ -364,11 +512,23 @@ int boltzmann_cvodes(struct state_struct *state, double *concs) {
     Initialize parameters for the cvodes method from 
     the cvodes_params structure.
   */
-  if (success) {
+  if (success && (reused == 0)) {
     success = boltzmann_cvodes_init(cvode_mem,state,concs);
+    /*
+      Record the problem the context was built for.
+    */
+    cvodes_params->context_ny_ode          = ny_ode;
+    cvodes_params->context_reduced         = reduced;
+    cvodes_params->context_sens            = (int)state->compute_sensitivities;
+    cvodes_params->context_jacobian_choice = jacobian_choice;
+    cvodes_params->context_stop_style      = (int)state->ode_stop_style;
+    cvodes_params->context_num_threads     = nthreads;
   }
   if (success) {
     num_steps = cvodes_params->num_cvode_steps;
+    if (dense_output) {
+      num_steps = (int)dense_output;
+    }
     tfinal = state->ode_t_final;
     if (num_steps > 0) {
       itask = CV_NORMAL;
@@ -376,9 +536,32 @@ int boltzmann_cvodes(struct state_struct *state, double *concs) {
       delt    = tfinal/((double)num_steps);
       not_done = 1;
       for (i=0;((i<num_steps) && not_done);i++) {
-	tout = delt * (i+1);
-	flag = CVode(cvode_mem, tout, y0, &tret, itask);
+	if (dense_output) {
+	  tout = ode_dense_output_time(state,(int64_t)(i+1));
+	} else {
+	  tout = delt * (i+1);
+	}
+	if (adjoint) {
+	  /*
+	    Store check points for the backward integration.
+	  */
+	  flag = CVodeF(cvode_mem, tout, y0, &tret, itask, &ncheck);
+	  /*
+	    CVodeF steps internally in CV_ONE_STEP mode so it reports
+	    CV_TSTOP_RETURN as soon as a step lands on tstop, even though
+	    it hands back the interpolated solution at tout < tstop.
+	    Keep going in that case, later calls just interpolate.
+	  */
+	  if ((flag == CV_TSTOP_RETURN) && (tret < tfinal)) {
+	    flag = CV_SUCCESS;
+	  }
+	} else {
+	  flag = CVode(cvode_mem, tout, y0, &tret, itask);
+	}
 
+	if (reduced) {
+	  moiety_expand(state,BOLTZMANN_NV_DATA(y0),concs);
+	}
 	if (flag < 0) {
 	  success = 0;
 	  not_done = 0;
@@ -394,7 +577,8 @@ int boltzmann_cvodes(struct state_struct *state, double *concs) {
 	  } else if (flag == CV_ROOT_RETURN) {
 	    not_done = 0;
 	    if (lfp) {
-	      fprintf(lfp,"Boltzmann_cvodes: CVode returned CV_ROOT_RETURN\n");
+	      fprintf(lfp,"Boltzmann_cvodes: CVode returned CV_ROOT_RETURN, "
+		      "steady state at t = %le\n",tret);
 	      fflush(lfp);
 	    }
 	  }
@@ -411,6 +595,9 @@ int boltzmann_cvodes(struct state_struct *state, double *concs) {
 	      ode_rxn_view_step = ode_rxn_view_freq;
 	    }
 	  }
+	  if (dense_output) {
+	    ode_print_concs(state,tret,concs);
+	  }
 	}
 	done = ode_test_steady_state(state,ny,concs,f0);
 	if (done) {
@@ -424,7 +611,17 @@ int boltzmann_cvodes(struct state_struct *state, double *concs) {
       itask = CV_ONE_STEP;
       tout = tfinal;
       while (not_done) {
-	flag = CVode(cvode_mem, tout, y0, &tret, itask);
+	if (adjoint) {
+	  /*
+	    Store check points for the backward integration.
+	  */
+	  flag = CVodeF(cvode_mem, tout, y0, &tret, itask, &ncheck);
+	} else {
+	  flag = CVode(cvode_mem, tout, y0, &tret, itask);
+	}
+	if (reduced) {
+	  moiety_expand(state,BOLTZMANN_NV_DATA(y0),concs);
+	}
 	if (flag < 0) {
 	  success = 0;
 	  not_done = 0;
@@ -440,7 +637,8 @@ int boltzmann_cvodes(struct state_struct *state, double *concs) {
 	  } else if (flag == CV_ROOT_RETURN) {
 	    not_done = 0;
 	    if (lfp) {
-	      fprintf(lfp,"Boltzmann_cvodes: CVode returned CV_ROOT_RETURN\n");
+	      fprintf(lfp,"Boltzmann_cvodes: CVode returned CV_ROOT_RETURN, "
+		      "steady state at t = %le\n",tret);
 	      fflush(lfp);
 	    }
 	  }
@@ -469,6 +667,9 @@ int boltzmann_cvodes(struct state_struct *state, double *concs) {
     } /* end else num_cvodes_steps == 0 */
     
   } /* end if (success) */
+  if (success && adjoint) {
+    success = boltzmann_cvodes_adj_solve(cvode_mem,state,concs,tret);
+  }
   if (success) {
     if (state->compute_sensitivities) {
       boltzmann_print_sensitivities(state);
@@ -480,7 +681,11 @@ int boltzmann_cvodes(struct state_struct *state, double *concs) {
   */
   state->compute_sensitivities = 0;
   /*
-    Free cvodes memory.
+    Free the cvodes context unless it is to be reused by the next call,
+    the adjoint problem is always set up from scratch.
   */
+  if ((success == 0) || adjoint || (cvodes_params->reuse_context == 0)) {
+    boltzmann_cvodes_free(state);
+  }
   return(success);
 }
@@ -0,0 +1,92 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_cvodes_headers.h"
+#include "cvodes_params_struct.h"
+#include "read_adj_targets.h"
+#include "boltzmann_check_cvodeadj_errors.h"
+#include "boltzmann_cvodes_adj_init.h"
+int boltzmann_cvodes_adj_init(void *cvode_mem, struct state_struct *state) {
+  /*
+    Set up adjoint sensitivity analysis (compute_sensitivities == 2):
+    allocate the objective and gradient vectors, read the target
+    concentrations, set the sensitivity parameters p to ke, allocate
+    the backward state and quadrature vectors and turn on check pointing
+    of the forward solution with CVodeAdjInit.
+    Must be called after CVodeInit and before the first CVodeF call.
+
+    Called by: boltzmann_cvodes_init
+    Calls:     read_adj_targets,
+               CVodeAdjInit,
+	       boltzmann_check_cvodeadj_errors,
+               calloc, fprintf, fflush
+  */
+  struct cvodes_params_struct *cvodes_params;
+  N_Vector yb;
+  N_Vector qb;
+  double *adj_target;
+  double *ke;
+  double *p;
+  int64_t ask_for;
+  int64_t one_l;
+  int ny;
+  int ns;
+  int i;
+  int flag;
+  int success;
+  int nthreads;
+  FILE *lfp;
+  FILE *efp;
+
+  success       = 1;
+  one_l         = (int64_t)1;
+  lfp           = state->lfp;
+  cvodes_params = state->cvodes_params;
+  ny            = state->nunique_molecules;
+  ns            = cvodes_params->ns;
+  ke            = state->ke;
+  nthreads      = (int)state->num_threads;
+  ask_for       = ((int64_t)(ny + ny + ns)) * sizeof(double);
+  adj_target    = (double *)calloc(one_l,ask_for);
+  if (adj_target == NULL) {
+    success = 0;
+    if (lfp) {
+      fprintf(lfp,"boltzmann_cvodes_adj_init: Error unable to allocate %ld "
+	      "bytes for adjoint workspace\n",ask_for);
+      fflush(lfp);
+    }
+  } else {
+    cvodes_params->adj_target = adj_target;
+    cvodes_params->adj_weight = &adj_target[ny];
+    cvodes_params->adj_grad   = &adj_target[ny+ny];
+    success = read_adj_targets(state);
+  }
+  if (success) {
+    /*
+      The gradient and jacobian routines take ke from p when
+      compute_sensitivities is set.
+    */
+    p = cvodes_params->p;
+    for (i=0;i<ns;i++) {
+      p[i] = ke[i];
+    }
+    yb = BOLTZMANN_NV_NEW(ny,nthreads);
+    qb = BOLTZMANN_NV_NEW(ns,nthreads);
+    if ((yb == NULL) || (qb == NULL)) {
+      success = 0;
+      if (lfp) {
+	fprintf(lfp,"boltzmann_cvodes_adj_init: Error allocating the backward "
+		"problem vectors\n");
+	fflush(lfp);
+      }
+    } else {
+      cvodes_params->yB = yb;
+      cvodes_params->qB = qb;
+    }
+  }
+  if (success) {
+    flag = CVodeAdjInit(cvode_mem,(long int)cvodes_params->adj_steps,
+			CV_HERMITE);
+    success = boltzmann_check_cvodeadj_errors(flag,cvode_mem,state,
+					      "AdjInit");
+  }
+  return(success);
+}
@@ -0,0 +1,5 @@
+#ifndef _BOLTZMANN_CVODES_ADJ_INIT_H_
+#define _BOLTZMANN_CVODES_ADJ_INIT_H_ 1
+extern int boltzmann_cvodes_adj_init(void *cvode_mem, 
+				     struct state_struct *state);
+#endif
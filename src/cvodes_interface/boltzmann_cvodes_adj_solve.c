@@ -0,0 +1,208 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_cvodes_headers.h"
+#include "cvodes_params_struct.h"
+#include "boltzmann_cvodes_rhsb.h"
+#include "boltzmann_cvodes_rhsqb.h"
+#include "boltzmann_cvodes_jtimesb.h"
+#include "boltzmann_cvodes_psetupb.h"
+#include "boltzmann_cvodes_psolveb.h"
+#include "boltzmann_check_cvodeadj_errors.h"
+#include "boltzmann_check_cvspils_errors.h"
+#include "boltzmann_print_cvode_error.h"
+#include "boltzmann_cvodes_adj_solve.h"
+int boltzmann_cvodes_adj_solve(void *cvode_mem, struct state_struct *state,
+			       double *concs, double t_final) {
+  /*
+    Integrate the adjoint problem backward from t_final, the end of
+    the CVodeF forward integration, to 0 and set 
+    cvodes_params->adj_grad to dG/dke and cvodes_params->adj_objective
+    to G for
+      G = 1/2 sum_i adj_weight[i]*(concs[i] - adj_target[i])^2,
+    where concs are the concentrations at t_final.
+    The adjoint yB starts at dG/dy = adj_weight*(concs - adj_target)
+    and satisfies yB' = -J^T yB, the quadrature qB' = -(df/dke)^T yB 
+    starts at 0 and its value at t = 0 is dG/dke, as the initial
+    concentrations do not depend on ke.
+    The backward problem uses the same multistep method and tolerances as
+    the forward problem, GMRES and the sparse jacobian transpose products
+    of boltzmann_cvodes_jtimesb. With an ILU or compartment block
+    CVODES_PREC_CHOICE (2, 3 or 4) GMRES is right preconditioned with
+    the transposed factors of the adjoint Newton matrix
+    (boltzmann_cvodes_psetupb and boltzmann_cvodes_psolveb), otherwise
+    it is not preconditioned. Right preconditioning keeps the true
+    residual small with incomplete factors, left preconditioning lets
+    the adjoint drift.
+
+    Called by: boltzmann_cvodes
+    Calls:     CVodeCreateB,
+               CVodeInitB,
+	       CVodeSStolerancesB,
+	       CVodeSetUserDataB,
+	       CVodeSetMaxNumStepsB,
+	       CVSpgmrB,
+	       CVSpilsSetJacTimesVecFnB,
+	       CVSpilsSetPreconditionerB,
+	       CVodeQuadInitB,
+	       CVodeSetQuadErrConB,
+	       CVodeQuadSStolerancesB,
+	       CVodeB,
+	       CVodeGetB,
+	       CVodeGetQuadB,
+	       boltzmann_check_cvodeadj_errors,
+	       boltzmann_check_cvspils_errors,
+	       boltzmann_print_cvode_error
+  */
+  struct cvodes_params_struct *cvodes_params;
+  N_Vector yb;
+  N_Vector qb;
+  double *yb_data;
+  double *qb_data;
+  double *adj_target;
+  double *adj_weight;
+  double *adj_grad;
+  double diff;
+  double objective;
+  double reltol;
+  double abstol;
+  double t0;
+  double tret;
+  int ny;
+  int ns;
+
+  int i;
+  int which;
+
+  int flag;
+  int success;
+
+  int lmm;
+  int iter;
+
+  int prec_choice;
+  int pretype;
+
+  FILE *lfp;
+  FILE *efp;
+
+  success       = 1;
+  lfp           = state->lfp;
+  cvodes_params = state->cvodes_params;
+  ny            = state->nunique_molecules;
+  ns            = cvodes_params->ns;
+  yb            = cvodes_params->yB;
+  qb            = cvodes_params->qB;
+  adj_target    = cvodes_params->adj_target;
+  adj_weight    = cvodes_params->adj_weight;
+  adj_grad      = cvodes_params->adj_grad;
+  reltol        = cvodes_params->reltol;
+  abstol        = cvodes_params->abstol;
+  lmm           = cvodes_params->linear_multistep_method;
+  iter          = cvodes_params->iterative_method;
+  yb_data       = BOLTZMANN_NV_DATA(yb);
+  qb_data       = BOLTZMANN_NV_DATA(qb);
+  t0            = 0.0;
+  prec_choice   = (int)state->cvodes_prec_choice;
+  pretype       = PREC_NONE;
+  if ((prec_choice >= 2) && (prec_choice <= 4)) {
+    pretype = PREC_RIGHT;
+  }
+  /*
+    Objective value and terminal condition for the adjoint.
+  */
+  objective = 0.0;
+  for (i=0;i<ny;i++) {
+    diff       = concs[i] - adj_target[i];
+    yb_data[i] = adj_weight[i] * diff;
+    objective += 0.5 * adj_weight[i] * diff * diff;
+  }
+  cvodes_params->adj_objective = objective;
+  cvodes_params->adj_t_final   = t_final;
+  for (i=0;i<ns;i++) {
+    qb_data[i] = 0.0;
+  }
+  flag = CVodeCreateB(cvode_mem,lmm,iter,&which);
+  success = boltzmann_check_cvodeadj_errors(flag,cvode_mem,state,"CreateB");
+  if (success) {
+    cvodes_params->adj_which = which;
+    flag = CVodeInitB(cvode_mem,which,boltzmann_cvodes_rhsb,t_final,yb);
+    success = boltzmann_check_cvodeadj_errors(flag,cvode_mem,state,"InitB");
+  }
+  if (success) {
+    flag = CVodeSStolerancesB(cvode_mem,which,reltol,abstol);
+    success = boltzmann_check_cvodeadj_errors(flag,cvode_mem,state,
+					      "SStolerancesB");
+  }
+  if (success) {
+    flag = CVodeSetUserDataB(cvode_mem,which,(void*)state);
+    success = boltzmann_check_cvodeadj_errors(flag,cvode_mem,state,
+					      "SetUserDataB");
+  }
+  if (success) {
+    flag = CVodeSetMaxNumStepsB(cvode_mem,which,
+				(long int)cvodes_params->mxsteps);
+    success = boltzmann_check_cvodeadj_errors(flag,cvode_mem,state,
+					      "SetMaxNumStepsB");
+  }
+  if (success) {
+    flag = CVSpgmrB(cvode_mem,which,pretype,cvodes_params->maxl);
+    success = boltzmann_check_cvspils_errors(flag,cvode_mem,state,"CVSpgmrB");
+  }
+  if (success && (pretype != PREC_NONE)) {
+    flag = CVSpilsSetPreconditionerB(cvode_mem,which,
+				     boltzmann_cvodes_psetupb,
+				     boltzmann_cvodes_psolveb);
+    success = boltzmann_check_cvspils_errors(flag,cvode_mem,state,
+					     "CVSpilsSetPreconditionerB");
+  }
+  if (success) {
+    flag = CVSpilsSetJacTimesVecFnB(cvode_mem,which,boltzmann_cvodes_jtimesb);
+    success = boltzmann_check_cvspils_errors(flag,cvode_mem,state,
+					     "CVSpilsSetJacTimesVecFnB");
+  }
+  if (success) {
+    flag = CVodeQuadInitB(cvode_mem,which,boltzmann_cvodes_rhsqb,qb);
+    success = boltzmann_check_cvodeadj_errors(flag,cvode_mem,state,
+					      "QuadInitB");
+  }
+  if (success) {
+    flag = CVodeSetQuadErrConB(cvode_mem,which,TRUE);
+    success = boltzmann_check_cvodeadj_errors(flag,cvode_mem,state,
+					      "SetQuadErrConB");
+  }
+  if (success) {
+    flag = CVodeQuadSStolerancesB(cvode_mem,which,reltol,abstol);
+    success = boltzmann_check_cvodeadj_errors(flag,cvode_mem,state,
+					      "QuadSStolerancesB");
+  }
+  if (success) {
+    flag = CVodeB(cvode_mem,t0,CV_NORMAL);
+    if (flag < 0) {
+      success = 0;
+      if (flag <= CV_NO_ADJ) {
+	boltzmann_check_cvodeadj_errors(flag,cvode_mem,state,"B");
+      } else {
+	boltzmann_print_cvode_error(flag,cvode_mem,state);
+      }
+    }
+  }
+  if (success) {
+    flag = CVodeGetB(cvode_mem,which,&tret,yb);
+    success = boltzmann_check_cvodeadj_errors(flag,cvode_mem,state,"GetB");
+  }
+  if (success) {
+    flag = CVodeGetQuadB(cvode_mem,which,&tret,qb);
+    success = boltzmann_check_cvodeadj_errors(flag,cvode_mem,state,
+					      "GetQuadB");
+  }
+  if (success) {
+    for (i=0;i<ns;i++) {
+      adj_grad[i] = qb_data[i];
+    }
+    if (lfp) {
+      fprintf(lfp,"boltzmann_cvodes_adj_solve: objective = %le at t = %le\n",
+	      objective,t_final);
+      fflush(lfp);
+    }
+  }
+  return(success);
+}
@@ -0,0 +1,6 @@
+#ifndef _BOLTZMANN_CVODES_ADJ_SOLVE_H_
+#define _BOLTZMANN_CVODES_ADJ_SOLVE_H_ 1
+extern int boltzmann_cvodes_adj_solve(void *cvode_mem, 
+				      struct state_struct *state,
+				      double *concs, double t_final);
+#endif
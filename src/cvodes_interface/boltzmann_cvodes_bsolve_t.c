@@ -0,0 +1,44 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_cvodes_headers.h"
+#include "cvodes_params_struct.h"
+#include "boltzmann_cvodes_bsolve_t.h"
+int boltzmann_cvodes_bsolve_t(struct state_struct *state, double *r, double *z) {
+  /*
+    Perform the solve of U^T z = r, the transpose of
+    boltzmann_cvodes_bsolve. U^T is lower triangular, the rows of U
+    are its columns so the solve goes forward by columns.
+    r and z may not be the same vector.
+    Called by: boltzman_cvodes_psolveb
+  */
+  struct cvodes_params_struct *cvodes_params;
+  double *u;
+  double *recip_diag_u;
+  double zi;
+  int    *iu;
+  int    *ju;
+
+  int    ny;
+  int    i;
+
+  int    j;
+  int    success;
+
+  success       = 1;
+  ny            = state->nunique_molecules;
+  cvodes_params = state->cvodes_params;
+  u             = cvodes_params->prec_u;
+  iu            = cvodes_params->prec_iu;
+  ju            = cvodes_params->prec_ju;
+  recip_diag_u  = cvodes_params->recip_diag_u;
+  for (i=0;i<ny;i++) {
+    z[i] = r[i];
+  }
+  for (i=0;i<ny;i++) {
+    zi   = z[i] * recip_diag_u[i];
+    z[i] = zi;
+    for (j=iu[i];j<iu[i+1];j++) {
+      z[ju[j]] -= u[j] * zi;
+    }
+  }
+  return(success);
+}
@@ -0,0 +1,5 @@
+#ifndef _BOLTZMANN_CVODES_BSOLVE_T_H_
+#define _BOLTZMANN_CVODES_BSOLVE_T_H_ 1
+extern int boltzmann_cvodes_bsolve_t(struct state_struct *state, 
+				     double *r, double *z);
+#endif
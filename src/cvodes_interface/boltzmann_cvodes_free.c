@@ -0,0 +1,79 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_cvodes_headers.h"
+#include "cvodes_params_struct.h"
+#include "boltzmann_cvodes_free.h"
+void boltzmann_cvodes_free(struct state_struct *state) {
+  /*
+    Free the cvodes integrator context built by boltzmann_cvodes:
+    cvode_mem, the y0 vector, the forward sensitivity vectors,
+    the LU factors of the compartment block preconditioner,
+    the numerical jacobian workspace and the jacobian workspace block
+    drfc, the adjoint yB and qB vectors and the adj_target, adj_weight,
+    adj_grad block, and null the pointers to them in cvodes_params so
+    that the next boltzmann_cvodes call builds a new context.
+    boltzmann_cvodes calls this after boltzmann_print_sensitivities has
+    written adj_grad.
+    y0 wraps the concentrations when the odes are not moiety reduced
+    and the ys0 vectors wrap ys0v, so N_VDestroy leaves their data in place.
+    Called by: boltzmann_cvodes, boltzmann_cvodes_reinit
+    Calls:     CVodeFree, N_VDestroy, N_VDestroyVectorArray, free
+  */
+  struct cvodes_params_struct *cvodes_params;
+  struct ode23tb_params_struct *ode23tb_params;
+  int ns;
+  int padi;
+  cvodes_params = state->cvodes_params;
+  ns            = cvodes_params->ns;
+  if (cvodes_params->cvode_mem != NULL) {
+    CVodeFree(&cvodes_params->cvode_mem);
+    cvodes_params->cvode_mem = NULL;
+  }
+  if (cvodes_params->y0 != NULL) {
+    N_VDestroy(cvodes_params->y0);
+    cvodes_params->y0 = NULL;
+  }
+  if (cvodes_params->ys0 != NULL) {
+    N_VDestroyVectorArray(cvodes_params->ys0,ns);
+    cvodes_params->ys0 = NULL;
+  }
+  if (cvodes_params->dys != NULL) {
+    N_VDestroyVectorArray(cvodes_params->dys,ns);
+    cvodes_params->dys = NULL;
+  }
+  /*
+    Adjoint problem vectors and workspace from boltzmann_cvodes_adj_init,
+    adj_weight and adj_grad are in the adj_target block.
+  */
+  if (cvodes_params->yB != NULL) {
+    N_VDestroy(cvodes_params->yB);
+    cvodes_params->yB = NULL;
+  }
+  if (cvodes_params->qB != NULL) {
+    N_VDestroy(cvodes_params->qB);
+    cvodes_params->qB = NULL;
+  }
+  if (cvodes_params->adj_target != NULL) {
+    free(cvodes_params->adj_target);
+    cvodes_params->adj_target = NULL;
+    cvodes_params->adj_weight = NULL;
+    cvodes_params->adj_grad   = NULL;
+  }
+  /*
+    LU factors of the compartment block preconditioner, the SLU
+    linear solver frees its own in CVodeFree.
+  */
+  if (cvodes_params->slu_factors != NULL) {
+    free(cvodes_params->slu_factors);
+    cvodes_params->slu_factors = NULL;
+  }
+  if (cvodes_params->nj_dfdy != NULL) {
+    free(cvodes_params->nj_dfdy);
+    cvodes_params->nj_dfdy = NULL;
+    ode23tb_params = (struct ode23tb_params_struct *)state->ode23tb_params;
+    ode23tb_params->dfdy = NULL;
+  }
+  if (cvodes_params->drfc != NULL) {
+    free(cvodes_params->drfc);
+    cvodes_params->drfc = NULL;
+  }
+}
@@ -0,0 +1,4 @@
+#ifndef _BOLTZMANN_CVODES_FREE_H_
+#define _BOLTZMANN_CVODES_FREE_H_ 1
+extern void boltzmann_cvodes_free(struct state_struct *state);
+#endif
@@ -0,0 +1,96 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_cvodes_headers.h"
+#include "cvodes_params_struct.h"
+#include "approximate_jacobian.h"
+#include "boltzmann_sparse_mvp.h"
+#include "lr8_dfdke.h"
+#include "boltzmann_cvodes_fs.h"
+int boltzmann_cvodes_fs(int ns, double t, N_Vector y, N_Vector ydot,
+			N_Vector *ys, N_Vector *ys_dot, void *user_data,
+			N_Vector tmp1, N_Vector tmp2) {
+  /*
+    Analytic right hand side of the forward sensitivity systems,
+      ys_dot[i] = J(y) ys[i] + df/dke[i],
+    replacing the cvodes difference quotient approximation that costs
+    one or two extra gradient evaluations per parameter.
+    The sparse jacobian J is formed once per call and shared by all
+    ns parameters, and df/dke[i] is nonzero only in the variable
+    species of reaction i, with value coefficient * sens_dfdke[i].
+    Called by: CVode (via CVodeSensInit in boltzmann_cvodes_init)
+    Calls:     approximate_jacobian,
+               boltzmann_sparse_mvp,
+	       lr8_dfdke
+  */
+  struct state_struct *state;
+  struct cvodes_params_struct *cvodes_params;
+  struct molecule_struct *molecules;
+  struct reactions_matrix_struct *rxn_matrix;
+  double *y_data;
+  double *fy_data;
+  double *ys_data;
+  double *ys_dot_data;
+  double *dfdke;
+  double *dfdy_a;
+  double *rcoefficients;
+  int64_t *rxn_ptrs;
+  int64_t *molecules_indices;
+  int    *dfdy_ia;
+  int    *dfdy_ja;
+  int choice;
+  int success;
+  int ny;
+  int i;
+  int j;
+  int mi;
+  int ret_code;
+
+  state             = (struct state_struct *)user_data;
+  ny                = state->nunique_molecules;
+  molecules         = state->sorted_molecules;
+  rxn_matrix        = state->reactions_matrix;
+  rxn_ptrs          = rxn_matrix->rxn_ptrs;
+  molecules_indices = rxn_matrix->molecules_indices;
+  rcoefficients     = rxn_matrix->coefficients;
+  cvodes_params     = state->cvodes_params;
+  dfdke             = cvodes_params->sens_dfdke;
+  /*
+    Always use the sparse thermodynamic jacobian (lr8), consistent
+    with the lr8_dfdke parameter partials.
+  */
+  choice            = 8;
+  y_data            = BOLTZMANN_NV_DATA(y);
+  /*
+    tmp1 is used as scratch for the delta_concs argument, which
+    lr8_approximate_jacobian does not use.
+  */
+  fy_data           = BOLTZMANN_NV_DATA(tmp1);
+  ret_code          = -1;
+  success = approximate_jacobian(state, y_data, fy_data, t, choice);
+  if (success) {
+    dfdy_a  = cvodes_params->dfdy_a;
+    dfdy_ia = cvodes_params->dfdy_ia;
+    dfdy_ja = cvodes_params->dfdy_ja;
+    success = lr8_dfdke(state, y_data, dfdke);
+  }
+  if (success) {
+    for (i=0;i<ns;i++) {
+      ys_data     = BOLTZMANN_NV_DATA(ys[i]);
+      ys_dot_data = BOLTZMANN_NV_DATA(ys_dot[i]);
+      success = boltzmann_sparse_mvp(ny, dfdy_a, dfdy_ia, dfdy_ja,
+				     ys_data, ys_dot_data);
+      if (success == 0) {
+	break;
+      }
+      for (j=rxn_ptrs[i];j<rxn_ptrs[i+1];j++) {
+	mi = molecules_indices[j];
+	if (molecules[mi].variable == 1) {
+	  ys_dot_data[mi] += rcoefficients[j] * dfdke[i];
+	}
+      }
+    }
+  }
+  if (success) {
+    ret_code = 0;
+  }
+  return(ret_code);
+}
@@ -0,0 +1,6 @@
+#ifndef _BOLTZMANN_CVODES_FS_H_
+#define _BOLTZMANN_CVODES_FS_H_ 1
+extern int boltzmann_cvodes_fs(int ns, double t, N_Vector y, N_Vector ydot,
+			       N_Vector *ys, N_Vector *ys_dot, void *user_data,
+			       N_Vector tmp1, N_Vector tmp2);
+#endif
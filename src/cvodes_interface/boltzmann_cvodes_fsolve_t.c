@@ -0,0 +1,42 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_cvodes_headers.h"
+#include "cvodes_params_struct.h"
+#include "boltzmann_cvodes_fsolve_t.h"
+int boltzmann_cvodes_fsolve_t(struct state_struct *state, double *r, double *z) {
+  /*
+    Perform the solve of L^T z = r, the transpose of
+    boltzmann_cvodes_fsolve, L being unit lower triangular with the
+    diagonal implied. L^T is unit upper triangular, the rows of L
+    are its columns so the solve goes backward by columns.
+    r and z may not be the same vector.
+    Called by: boltzman_cvodes_psolveb
+  */
+  struct cvodes_params_struct *cvodes_params;
+  double *l;
+  double zi;
+  int    *il;
+  int    *jl;
+
+  int    ny;
+  int    i;
+
+  int    j;
+  int    success;
+
+  success       = 1;
+  ny            = state->nunique_molecules;
+  cvodes_params = state->cvodes_params;
+  l             = cvodes_params->prec_l;
+  il            = cvodes_params->prec_il;
+  jl            = cvodes_params->prec_jl;
+  for (i=0;i<ny;i++) {
+    z[i] = r[i];
+  }
+  for (i=ny-1;i>0;i--) {
+    zi = z[i];
+    for (j=il[i];j<il[i+1];j++) {
+      z[jl[j]] -= l[j] * zi;
+    }
+  }
+  return(success);
+}
@@ -17,6 +17,30 @@
 #include "sundials_sptfqmr.h"
 #include "cvodes.h"
 #include "nvector_serial.h"
+/*
+  The nvector implementation used for the cvodes state and sensitivity
+  vectors. Serial by default, compile with -DUSE_NVEC_OPENMP or
+  -DUSE_NVEC_PTHREADS (and link the matching sundials nvector library)
+  to have cvodes do its vector operations with num_threads threads.
+*/
+#if defined(USE_NVEC_OPENMP)
+#include "nvector_openmp.h"
+#define BOLTZMANN_NV_DATA(v) NV_DATA_OMP(v)
+#define BOLTZMANN_NV_MAKE(n,data,nthreads) N_VMake_OpenMP(n,data,nthreads)
+#define BOLTZMANN_NV_NEW(n,nthreads) N_VNew_OpenMP(n,nthreads)
+#define BOLTZMANN_NV_CLONE_ARRAY(count,w) N_VCloneVectorArray_OpenMP(count,w)
+#elif defined(USE_NVEC_PTHREADS)
+#include "nvector_pthreads.h"
+#define BOLTZMANN_NV_DATA(v) NV_DATA_PT(v)
+#define BOLTZMANN_NV_MAKE(n,data,nthreads) N_VMake_Pthreads(n,nthreads,data)
+#define BOLTZMANN_NV_NEW(n,nthreads) N_VNew_Pthreads(n,nthreads)
+#define BOLTZMANN_NV_CLONE_ARRAY(count,w) N_VCloneVectorArray_Pthreads(count,w)
+#else
+#define BOLTZMANN_NV_DATA(v) NV_DATA_S(v)
+#define BOLTZMANN_NV_MAKE(n,data,nthreads) ((void)(nthreads),N_VMake_Serial(n,data))
+#define BOLTZMANN_NV_NEW(n,nthreads) ((void)(nthreads),N_VNew_Serial(n))
+#define BOLTZMANN_NV_CLONE_ARRAY(count,w) N_VCloneVectorArray_Serial(count,w)
+#endif
 #include "cvodes_dense.h"
 #include "cvodes_band.h"
 #include "cvodes_diag.h"
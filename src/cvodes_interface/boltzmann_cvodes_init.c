@@ -10,6 +10,11 @@
 #include "boltzmann_cvodes_psetup.h"
 #include "boltzmann_cvodes_psolve.h"
 #include "boltzmann_cvodes_jtimes.h"
+#include "boltzmann_cvodes_jtimes_reduced.h"
+#include "boltzmann_cvodes_ss_root.h"
+#include "boltzmann_cvodes_fs.h"
+#include "boltzmann_cvodes_adj_init.h"
+#include "boltzmann_cvodes_slu.h"
 #include "boltzmann_cvodes_init.h"
 
 int boltzmann_cvodes_init(void *cvode_mem,struct state_struct *state, double *concs) {
@@ -20,6 +25,8 @@ int boltzmann_cvodes_init(void *cvode_mem,struct state_struct *state, double *co
     Calls:     N_VNew_Serial,
                N_VMake_Serial,
 	       N_VCloneVectorArray_Serial
+	       (or their OpenMP/Pthreads counterparts, see
+	       boltzmann_cvodes_headers.h)
                CVodeSetErrFile,
                boltzmann_check_cvodeset_errors,
 	       CVodeSStolerances,
@@ -48,7 +55,15 @@ int boltzmann_cvodes_init(void *cvode_mem,struct state_struct *state, double *co
 	       boltzmann_cvodes_psetup,
 	       boltzmann_cvodes_psolve,
 	       boltzmann_cvodes_jtime,
-	       boltzmann_check_cvodesens_errors
+	       boltzmann_cvodes_jtimes_reduced,
+	       boltzmann_cvodes_slu,
+	       CVodeRootInit,
+	       CVodeSetRootDirection,
+	       CVodeSetNoInactiveRootWarn,
+	       boltzmann_cvodes_ss_root,
+	       boltzmann_check_cvodesens_errors,
+	       boltzmann_cvodes_fs,
+	       boltzmann_cvodes_adj_init
   */
   /*
     Direct cvode error messages to log file, lfp.
@@ -88,6 +103,7 @@ int boltzmann_cvodes_init(void *cvode_mem,struct state_struct *state, double *co
 
   int maxncf;
   int pretype;
+  int use_spils;
 
   int maxl;
   int gstype;
@@ -105,6 +121,10 @@ int boltzmann_cvodes_init(void *cvode_mem,struct state_struct *state, double *co
   int maxcors;
 
   int errcons;
+  int nthreads;
+
+  int root_direction;
+  int padi;
 
   FILE *lfp;
   FILE *efp;
@@ -112,8 +132,12 @@ int boltzmann_cvodes_init(void *cvode_mem,struct state_struct *state, double *co
   success = 1;
   lfp     = state->lfp;
   cvodes_params = state->cvodes_params;
-  ny            = state->nunique_molecules;
+  /*
+    ny_ode is number_independent for a moiety reduced integration.
+  */
+  ny            = cvodes_params->ny_ode;
   ke            = state->ke;
+  nthreads      = (int)state->num_threads;
   if (success) {
     flag = CVodeSetErrFile(cvode_mem,lfp);
     success = boltzmann_check_cvodeset_errors(flag,cvode_mem,state,"ErrFile");
@@ -127,11 +151,11 @@ int boltzmann_cvodes_init(void *cvode_mem,struct state_struct *state, double *co
     /*
       Or we could take abs_tol_data from state vector. Hmm?
     */
-    abs_tol = N_VNew_Serial(ny);
+    abs_tol = BOLTZMANN_NV_NEW(ny,nthreads);
     /*
     abs_tol_data = N_VGetArrayPointer(abs_tol);
     */
-    abs_tol_data = NV_DATA_S(abs_tol);
+    abs_tol_data = BOLTZMANN_NV_DATA(abs_tol);
     for (i=0;i<ny;i++) {
       abs_tol_data[i] = abstol_v;
     }
@@ -177,7 +201,12 @@ int boltzmann_cvodes_init(void *cvode_mem,struct state_struct *state, double *co
   */
   if (success) {
     use_stab_lim_det = cvodes_params->use_stab_lim_det;
-    if (use_stab_lim_det) {
+    if (cvodes_params->linear_multistep_method != CV_BDF) {
+      /*
+	Only available for BDF, cvodes rejects it for Adams.
+      */
+      flag = CVodeSetStabLimDet(cvode_mem,FALSE);
+    } else if (use_stab_lim_det) {
       flag = CVodeSetStabLimDet(cvode_mem,TRUE);
     } else {
       flag = CVodeSetStabLimDet(cvode_mem,TRUE);
@@ -266,13 +295,20 @@ int boltzmann_cvodes_init(void *cvode_mem,struct state_struct *state, double *co
 					      "NonlinConvCoef");
   }
   /*
-    Specify the linear solver.
+    Specify the linear solver, the in-tree sparse direct solver for
+    CVODES_SOLVER SLU (linear_solver_method 10), GMRES otherwise.
+    The CVSpils settings below only apply to GMRES.
   */
+  use_spils = (cvodes_params->linear_solver_method != 10);
   if (success) {
-    pretype = cvodes_params->pretype;
-    maxl    = cvodes_params->maxl;
-    flag = CVSpgmr(cvode_mem,pretype,maxl);
-    success = boltzmann_check_cvspils_errors(flag,cvode_mem,state,"CVSpgmr");
+    if (use_spils) {
+      pretype = cvodes_params->pretype;
+      maxl    = cvodes_params->maxl;
+      flag = CVSpgmr(cvode_mem,pretype,maxl);
+      success = boltzmann_check_cvspils_errors(flag,cvode_mem,state,"CVSpgmr");
+    } else {
+      success = boltzmann_cvodes_slu(cvode_mem,state);
+    }
   } /* end if (success) */
   /*
     We need to specify the preconditioner psetup and psolve functions, and
@@ -281,7 +317,7 @@ int boltzmann_cvodes_init(void *cvode_mem,struct state_struct *state, double *co
   /*
     Specify modified Gram-Schmidt
   */
-  if (success) {
+  if (success && use_spils) {
     gstype = cvodes_params->gstype;
     flag = CVSpilsSetGSType(cvode_mem,gstype);
     success = boltzmann_check_cvspils_errors(flag,cvode_mem,state,"SetGSType");
@@ -290,32 +326,61 @@ int boltzmann_cvodes_init(void *cvode_mem,struct state_struct *state, double *co
     Specify factor by which Krylov linear solvers covergence test is reduced
     from Newton iteration test constant. Default 0.05 
   */
-  if (success) {
+  if (success && use_spils) {
     eplifac = cvodes_params->eplifac;
     flag = CVSpilsSetEpsLin(cvode_mem,eplifac);
     success = boltzmann_check_cvspils_errors(flag,cvode_mem,state,"SetEpsLin");
   }
   /*
     Set the preconditioner routine.
-  if (success) {
-    flag = CVSpilsSetPreconditioner(cvode_mem,boltzmann_cvodes_psetup,
-                                    boltzmann_cvodes_psolve);
-    success = boltzmann_check_cvspils_errors(flag,cvode_mem,state,
-                                             "CVSpilsSetPreconditioner");
-  }
   */
+  if (success && use_spils) {
+    if (cvodes_params->pretype != PREC_NONE) {
+      flag = CVSpilsSetPreconditioner(cvode_mem,boltzmann_cvodes_psetup,
+				      boltzmann_cvodes_psolve);
+      success = boltzmann_check_cvspils_errors(flag,cvode_mem,state,
+					       "CVSpilsSetPreconditioner");
+    }
+  }
   /*
     Set the Jacobian vector multpily function.
   */
-  if (success) {
+  if (success && use_spils) {
     if (state->ode_jacobian_choice == 0) {
       flag = CVSpilsSetJacTimesVecFn(cvode_mem,NULL);
     } else {
-      flag = CVSpilsSetJacTimesVecFn(cvode_mem,boltzmann_cvodes_jtimes); 
+      if (ny < state->nunique_molecules) {
+	flag = CVSpilsSetJacTimesVecFn(cvode_mem,
+				       boltzmann_cvodes_jtimes_reduced);
+      } else {
+	flag = CVSpilsSetJacTimesVecFn(cvode_mem,boltzmann_cvodes_jtimes); 
+      }
     }
     success = boltzmann_check_cvspils_errors(flag,cvode_mem,state,
 					     "CVSpilsSetJacTimesVecFn");
   }
+  /*
+    Stop at steady state through rootfinding on the ODE_STOP_THRESH
+    criterion rather than only testing it between output times.
+  */
+  if (success) {
+    if (state->ode_stop_style == 1) {
+      flag = CVodeRootInit(cvode_mem,1,boltzmann_cvodes_ss_root);
+      success = boltzmann_check_cvodeset_errors(flag,cvode_mem,state,
+						"RootInit");
+      if (success) {
+	root_direction = cvodes_params->root_direction;
+	flag = CVodeSetRootDirection(cvode_mem,&root_direction);
+	success = boltzmann_check_cvodeset_errors(flag,cvode_mem,state,
+						  "RootDirection");
+      }
+      if (success && cvodes_params->no_inactive_root_warn) {
+	flag = CVodeSetNoInactiveRootWarn(cvode_mem);
+	success = boltzmann_check_cvodeset_errors(flag,cvode_mem,state,
+						  "NoInactiveRootWarn");
+      }
+    }
+  }
   if (success) {
     if ((state->compute_sensitivities == 1)  &&
 	(state->ode_solver_choice == 1)) {
@@ -334,7 +399,7 @@ int boltzmann_cvodes_init(void *cvode_mem,struct state_struct *state, double *co
       /*
 	Allocate space for the ys0 array of ns N_vectors.
       */
-      ys0  = N_VCloneVectorArray_Serial(ns,y0);
+      ys0  = BOLTZMANN_NV_CLONE_ARRAY(ns,y0);
       if (ys0 == NULL) {
 	success =0;
 	if (lfp) {
@@ -344,7 +409,7 @@ int boltzmann_cvodes_init(void *cvode_mem,struct state_struct *state, double *co
       }
       if (success) {
 	cvodes_params->ys0 = ys0;
-	dys = N_VCloneVectorArray_Serial(ns,y0);
+	dys = BOLTZMANN_NV_CLONE_ARRAY(ns,y0);
 	if (dys == NULL) {
 	  success =0;
 	  if (lfp) {
@@ -365,7 +430,7 @@ int boltzmann_cvodes_init(void *cvode_mem,struct state_struct *state, double *co
 	approximate_ys0(state,concs);
 	ys0vi = ys0v;
 	for (i=0;i<ns;i++) {
-	  ys0[i] = N_VMake_Serial(ny,ys0vi);
+	  ys0[i] = BOLTZMANN_NV_MAKE(ny,ys0vi,nthreads);
 	  ys0vi += ny; /* Caution Address artihmetic here. */
 	}
 	/*
@@ -373,10 +438,17 @@ int boltzmann_cvodes_init(void *cvode_mem,struct state_struct *state, double *co
 	*/
 	ism  = CV_STAGGERED;
 	/*
-	  Use the internal difference quotient sensitivity 
-	  right hand side routine.
+	  Use the analytic sensitivity right hand side when the
+	  gradient is the lr8 thermodynamic one it was derived for,
+	  otherwise the internal difference quotient routine.
 	*/
 	fs   = NULL;
+	if ((cvodes_params->sens_rhs_choice == 1) &&
+	    ((state->gradient_choice == 8) || 
+	     (state->gradient_choice == 15) ||
+	     (state->gradient_choice == 16))) {
+	  fs = boltzmann_cvodes_fs;
+	}
 	flag = CVodeSensInit(cvode_mem,ns,ism,fs,ys0);
 	success = boltzmann_check_cvodesens_errors(flag,cvode_mem,state,
 						   "Init");
@@ -447,6 +519,15 @@ int boltzmann_cvodes_init(void *cvode_mem,struct state_struct *state, double *co
 	
       }
     } /* end if (ode_solver_choice == 1) */
+    if ((state->compute_sensitivities == 2)  &&
+	(state->ode_solver_choice == 1)) {
+      /*
+	Adjoint sensitivities of the target concentrations objective,
+	the backward problem is set up in boltzmann_cvodes_adj_solve
+	after the forward integration.
+      */
+      success = boltzmann_cvodes_adj_init(cvode_mem,state);
+    }
   } /* end if (success) */
   return(success);
 }
@@ -42,10 +42,10 @@ int boltzmann_cvodes_jtimes(N_Vector v,
     /*
       unpack N_Vectors.
     */
-    v_data  = NV_DATA_S(v);
-    jv_data = NV_DATA_S(jv);
-    y_data  = NV_DATA_S(y);
-    fy_data = NV_DATA_S(fy);
+    v_data  = BOLTZMANN_NV_DATA(v);
+    jv_data = BOLTZMANN_NV_DATA(jv);
+    y_data  = BOLTZMANN_NV_DATA(y);
+    fy_data = BOLTZMANN_NV_DATA(fy);
     ret_code = -1;
     /*
       First we need to build the jacobian with a call to approximate_jacobian.
@@ -0,0 +1,94 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_cvodes_headers.h"
+#include "cvodes_params_struct.h"
+#include "approximate_jacobian.h"
+#include "boltzmann_sparse_mvp.h"
+#include "moiety_expand.h"
+#include "boltzmann_cvodes_jtimes_reduced.h"
+int boltzmann_cvodes_jtimes_reduced(N_Vector v,
+				    N_Vector jv,
+				    double t,
+				    N_Vector y,
+				    N_Vector fy,
+				    void *user_data,
+				    N_Vector tmp) {
+  /*
+    Jacobian vector product for the moiety reduced odes.
+    The reduced jacobian is P J E where J is the full jacobian at the
+    expanded concentrations, E maps an independent species direction v
+    to the full direction (v on the independent species, link_matrix*v
+    on the dependent ones) and P picks out the independent species rows.
+    Called by: Cvode, boltzmann_cvodes_init
+    Calls:     moiety_expand,
+               approximate_jacobian,
+               boltzmann_sparse_mvp
+  */
+  struct state_struct *state;
+  struct cvodes_params_struct *cvodes_params;
+  double *v_data;
+  double *jv_data;
+  double *y_data;
+  double *concs;
+  double *flux;
+  double *dir;
+  double *link_matrix;
+  double *lrow;
+  double *dfdy_a;
+  double dconc;
+  int *dfdy_ia;
+  int *dfdy_ja;
+  int *independent_species;
+  int *dependent_species;
+  int choice;
+  int success;
+  int ny;
+  int nr;
+  int nd;
+  int i;
+  int j;
+  int ret_code;
+
+  state               = (struct state_struct *)user_data;
+  ny                  = state->nunique_molecules;
+  nr                  = (int)state->number_independent;
+  nd                  = ny - nr;
+  cvodes_params       = state->cvodes_params;
+  choice              = state->ode_jacobian_choice;
+  concs               = state->moiety_concs;
+  flux                = state->moiety_flux;
+  dir                 = state->moiety_dir;
+  link_matrix         = state->link_matrix;
+  independent_species = state->independent_species;
+  dependent_species   = state->dependent_species;
+  v_data   = BOLTZMANN_NV_DATA(v);
+  jv_data  = BOLTZMANN_NV_DATA(jv);
+  y_data   = BOLTZMANN_NV_DATA(y);
+  ret_code = -1;
+  moiety_expand(state,y_data,concs);
+  success = approximate_jacobian(state, concs, flux, t, choice);
+  if (success) {
+    for (j=0;j<nr;j++) {
+      dir[independent_species[j]] = v_data[j];
+    }
+    lrow = link_matrix;
+    for (i=0;i<nd;i++) {
+      dconc = 0.0;
+      for (j=0;j<nr;j++) {
+	dconc += lrow[j] * v_data[j];
+      }
+      dir[dependent_species[i]] = dconc;
+      lrow += nr; /* Caution address arithmetic here. */
+    }
+    dfdy_a  = cvodes_params->dfdy_a;
+    dfdy_ia = cvodes_params->dfdy_ia;
+    dfdy_ja = cvodes_params->dfdy_ja;
+    success = boltzmann_sparse_mvp(ny,dfdy_a,dfdy_ia,dfdy_ja,dir,flux);
+  }
+  if (success) {
+    for (j=0;j<nr;j++) {
+      jv_data[j] = flux[independent_species[j]];
+    }
+    ret_code = 0;
+  }
+  return(ret_code);
+}
@@ -0,0 +1,61 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_cvodes_headers.h"
+#include "cvodes_params_struct.h"
+#include "approximate_jacobian.h"
+#include "boltzmann_sparse_tmvp.h"
+#include "boltzmann_cvodes_jtimesb.h"
+int boltzmann_cvodes_jtimesb(N_Vector vb,
+			     N_Vector jvb,
+			     double t,
+			     N_Vector y,
+			     N_Vector yb,
+			     N_Vector fyb,
+			     void *user_data,
+			     N_Vector tmpb) {
+  /*
+    Multiply an N_Vector by the jacobian of the adjoint right hand side,
+    -J(y)^T, first forming J at the forward solution y(t).
+    Called by: CVodeB, boltzmann_cvodes_adj_solve
+    Calls:     approximate_jacobian,
+               boltzmann_sparse_tmvp
+  */
+  struct state_struct *state;
+  struct cvodes_params_struct *cvodes_params;
+  double *vb_data;
+  double *jvb_data;
+  double *y_data;
+  double *fy_data;
+  int choice;
+  int success;
+  int ny;
+  int i;
+  int ret_code;
+  int padi;
+  state         = (struct state_struct *)user_data;
+  ny            = state->nunique_molecules;
+  cvodes_params = state->cvodes_params;
+  /*
+    Always use the sparse thermodynamic jacobian (lr8), the numerical
+    jacobian needs f(y) which is not at hand here.
+  */
+  choice        = 8;
+  vb_data  = BOLTZMANN_NV_DATA(vb);
+  jvb_data = BOLTZMANN_NV_DATA(jvb);
+  y_data   = BOLTZMANN_NV_DATA(y);
+  fy_data  = BOLTZMANN_NV_DATA(tmpb);
+  ret_code = -1;
+  success = approximate_jacobian(state, y_data, fy_data, t, choice);
+  if (success) {
+    success = boltzmann_sparse_tmvp(ny, cvodes_params->dfdy_a,
+				    cvodes_params->dfdy_ia, 
+				    cvodes_params->dfdy_ja, 
+				    vb_data, jvb_data);
+  }
+  if (success) {
+    for (i=0;i<ny;i++) {
+      jvb_data[i] = 0.0 - jvb_data[i];
+    }
+    ret_code = 0;
+  }
+  return(ret_code);
+}
@@ -0,0 +1,11 @@
+#ifndef _BOLTZMANN_CVODES_JTIMESB_H_
+#define _BOLTZMANN_CVODES_JTIMESB_H_ 1
+extern int boltzmann_cvodes_jtimesb(N_Vector vb,
+				    N_Vector jvb,
+				    double t,
+				    N_Vector y,
+				    N_Vector yb,
+				    N_Vector fyb,
+				    void *user_data,
+				    N_Vector tmpb);
+#endif
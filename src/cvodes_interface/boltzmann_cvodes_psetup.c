@@ -1,5 +1,6 @@
 #include "boltzmann_structs.h"
 #include "boltzmann_cvodes_headers.h"
+#include "cvodes_params_struct.h"
 #include "approximate_jacobian.h"
 #include "build_newton_matrix.h"
 #include "precondition_newton_matrix.h"
@@ -16,7 +17,8 @@ int boltzmann_cvodes_psetup(double t,
 			    N_Vector tmp3){
   /*
     Called by: CVode, boltzmann_cvodes_init
-    Calls:     
+    Calls:     approximate_jacobian, build_newton_matrix, 
+               precondition_newton_matrix
   */
   struct state_struct *state;
   int success;
@@ -26,8 +28,8 @@ int boltzmann_cvodes_psetup(double t,
   double *fy_data;
   state = (struct state_struct *) user_data;
   choice = state->ode_jacobian_choice;
-  y_data = NV_DATA_S(y);
-  fy_data = NV_DATA_S(fy);
+  y_data = BOLTZMANN_NV_DATA(y);
+  fy_data = BOLTZMANN_NV_DATA(fy);
   success = 1;
   retcode = 0;
   *jcurptr = 0;
@@ -41,31 +43,39 @@ int boltzmann_cvodes_psetup(double t,
       ode23tb - might use a ode_jacobian_style = 0 for dense, 1 for sparse.
     */
     success = approximate_jacobian(state, y_data, fy_data, t, choice);
-    if (success) {
-      /*
-        Build preconditioner for Newton iteration matrix.
-	First build Newton iteration matrix. 
-	Setting fields miter_a, miter_ia, miter_ja the compressed row storage
-	format of M = (I - gamma*J)
-      */
-      success = build_newton_matrix(state,gamma,choice);
-    }
-    if (success) {
-      /*
-	Build the preconditioner for M.
-	Here we want to build a prec_l, prec_il, prec_jl, 
-	prec_u, prec_iu, and prec_ju structs to hold the approximate
-	factorization of M as the preconditioner. These will be 
-	used by the boltzmann_cvodes_psolve routine.
-      */
-      success = precondition_newton_matrix(state);
-    }
     if (success) {
       *jcurptr = 1;
-      retcode = 0;
-    } else {
-      retcode = -1;
     }
   }
+  /*
+    With jok != 0 the saved jacobian is reused but gamma may have 
+    changed so the Newton iteration matrix and its preconditioner
+    are always rebuilt.
+  */
+  if (success) {
+    /*
+      Build preconditioner for Newton iteration matrix.
+      First build Newton iteration matrix. 
+      Setting fields miter_a, miter_ia, miter_ja the compressed row storage
+      format of M = (I - gamma*J)
+    */
+    success = build_newton_matrix(state,gamma,choice);
+  }
+  if (success) {
+    /*
+      Build the preconditioner for M.
+      Here we want to build a prec_l, prec_il, prec_jl, 
+      prec_u, prec_iu, and prec_ju structs to hold the approximate
+      factorization of M as the preconditioner. These will be 
+      used by the boltzmann_cvodes_psolve routine.
+    */
+    success = precondition_newton_matrix(state);
+    state->cvodes_params->prec_backward = 0;
+  }
+  if (success) {
+    retcode = 0;
+  } else {
+    retcode = -1;
+  }
   return(retcode);
 }
@@ -0,0 +1,61 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_cvodes_headers.h"
+#include "cvodes_params_struct.h"
+#include "approximate_jacobian.h"
+#include "build_newton_matrix.h"
+#include "precondition_newton_matrix.h"
+#include "boltzmann_cvodes_psetupb.h"
+int boltzmann_cvodes_psetupb(double t, 
+			     N_Vector y,
+			     N_Vector yb,
+			     N_Vector fyb,
+			     int jokb,
+			     int *jcurptrb,
+			     double gammab,
+			     void *user_data,
+			     N_Vector tmp1b,
+			     N_Vector tmp2b,
+			     N_Vector tmp3b) {
+  /*
+    Preconditioner setup for the adjoint problem yB' = -J^T yB.
+    Its Newton matrix is I - gammab*(-J^T) = (I + gammab J)^T, so
+    the factors of the forward preconditioner are built, as in
+    boltzmann_cvodes_psetup, for M = I - gamma J with gamma = -gammab,
+    and boltzmann_cvodes_psolveb applies them transposed.
+    J is the lr8 sparse jacobian at the forward solution y, as in
+    boltzmann_cvodes_jtimesb. It is always recomputed, as jokb can not
+    tell that the saved jacobian is from the forward reintegration of
+    CVodeB.
+    Called by: CVodeB, boltzmann_cvodes_adj_solve,
+               boltzmann_cvodes_psolveb
+    Calls:     approximate_jacobian, build_newton_matrix, 
+               precondition_newton_matrix
+  */
+  struct state_struct *state;
+  double *y_data;
+  double *fy_data;
+  int success;
+  int retcode;
+  int choice;
+  int padi;
+  state     = (struct state_struct *) user_data;
+  choice    = 8;
+  y_data    = BOLTZMANN_NV_DATA(y);
+  fy_data   = BOLTZMANN_NV_DATA(tmp1b);
+  success   = 1;
+  success = approximate_jacobian(state, y_data, fy_data, t, choice);
+  *jcurptrb = success;
+  if (success) {
+    success = build_newton_matrix(state,0.0-gammab,choice);
+  }
+  if (success) {
+    success = precondition_newton_matrix(state);
+    state->cvodes_params->prec_backward = 1;
+  }
+  if (success) {
+    retcode = 0;
+  } else {
+    retcode = -1;
+  }
+  return(retcode);
+}
@@ -0,0 +1,14 @@
+#ifndef _BOLTZMANN_CVODES_PSETUPB_H_
+#define _BOLTZMANN_CVODES_PSETUPB_H_ 1
+extern int boltzmann_cvodes_psetupb(double t, 
+				    N_Vector y,
+				    N_Vector yb,
+				    N_Vector fyb,
+				    int jokb,
+				    int *jcurptrb,
+				    double gammab,
+				    void *user_data,
+				    N_Vector tmp1b,
+				    N_Vector tmp2b,
+				    N_Vector tmp3b);
+#endif
@@ -2,6 +2,7 @@
 #include "boltzmann_cvodes_bsolve.h"
 #include "boltzmann_cvodes_fsolve.h"
 #include "boltzmann_cvodes_headers.h"
+#include "cvodes_params_struct.h"
 int boltzmann_cvodes_psolve(double t,
 			    N_Vector y,
 			    N_Vector fy,
@@ -15,24 +16,41 @@ int boltzmann_cvodes_psolve(double t,
   /*
     Cvodes preconditioner routine:
     Solve Pz = r
+    where P = Q^T L U Q approximates the Newton matrix M, Q being the
+    symmetric permutation given by the perm field of cvodes_params.
+    For two sided preconditioning (PREC_BOTH) the left preconditioner
+    is Q^T L (lr = 1) and the right one is U Q (lr = 2), otherwise
+    the whole solve is done. The frow and srow vectors of cvodes_params 
+    are used as scratch.
     Called by: CVode, boltzmann_cvodes_init
     Calls:     boltzmann_cvodes_bsolve, boltzmann_cvodes_fsolve
   */
   struct state_struct *state;
+  struct cvodes_params_struct *cvodes_params;
   double *r_data;
   double *z_data;
+  double *x;
+  double *w;
+  int    *perm;
   int64_t vec_len;
   int ret_code;
   int success;
   int prec_choice;
   int ny;
+  int pretype;
+  int alg;
+  int i;
 
   success     = 1;
   state       = (struct state_struct *)user_data;
   ny          = state->nunique_molecules;
   prec_choice = state->cvodes_prec_choice;
-  r_data  = NV_DATA_S(r);
-  z_data = NV_DATA_S(z);
+  cvodes_params = state->cvodes_params;
+  pretype     = cvodes_params->pretype;
+  alg         = cvodes_params->sparse_matrix_ordering_alg;
+  perm        = cvodes_params->perm;
+  r_data  = BOLTZMANN_NV_DATA(r);
+  z_data = BOLTZMANN_NV_DATA(z);
   switch (prec_choice) {
   case 0:
     /*
@@ -48,21 +66,61 @@ int boltzmann_cvodes_psolve(double t,
     break;
   case 2:
     /*
-      This could be the traditional ilu solver, but it
-      would have an L and a U similar to case 2, so let
-      it drop through.
+      The level of fill ilu(k) solver, it has an L and a U 
+      similar to case 3, so let it drop through.
+    */
+  case 4:
+    /*
+      The compartment block LU factors have the same L and U layout.
     */
   case 3:
-    if (lr == 2) {
+    x = r_data;
+    if ((alg != 0) && ((lr == 1) || (pretype != PREC_BOTH))) {
       /*
-	P = LU, backward solve z  = U^(-1)r
+	x = Q r
       */
-      success = boltzmann_cvodes_bsolve(state,r_data,z_data);
-    } else if (lr == 1) {
+      x = cvodes_params->frow;
+      for (i=0;i<ny;i++) {
+	x[i] = r_data[perm[i]];
+      }
+    }
+    if (pretype == PREC_BOTH) {
+      if (lr == 1) {
+	/*
+	  Forward solve z = L^(-1)Qr
+	*/
+	success = boltzmann_cvodes_fsolve(state,x,z_data);
+      } else {
+	/*
+	  Backward solve z  = Q^T U^(-1)r
+	*/
+	if (alg == 0) {
+	  success = boltzmann_cvodes_bsolve(state,x,z_data);
+	} else {
+	  w = cvodes_params->srow;
+	  success = boltzmann_cvodes_bsolve(state,x,w);
+	  for (i=0;i<ny;i++) {
+	    z_data[perm[i]] = w[i];
+	  }
+	}
+      }
+    } else {
       /*
-	Forward solve z = L^(-1)r
+	z = Q^T U^(-1) L^(-1) Q r
       */
-      success = boltzmann_cvodes_fsolve(state,r_data,z_data);
+      w = cvodes_params->srow;
+      success = boltzmann_cvodes_fsolve(state,x,w);
+      if (success) {
+	if (alg == 0) {
+	  success = boltzmann_cvodes_bsolve(state,w,z_data);
+	} else {
+	  x = cvodes_params->frow;
+	  success = boltzmann_cvodes_bsolve(state,w,x);
+	  for (i=0;i<ny;i++) {
+	    z_data[perm[i]] = x[i];
+	  }
+	}
+      }
     }
     break;
   }
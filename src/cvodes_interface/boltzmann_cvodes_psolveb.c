@@ -0,0 +1,93 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_cvodes_headers.h"
+#include "cvodes_params_struct.h"
+#include "boltzmann_cvodes_bsolve_t.h"
+#include "boltzmann_cvodes_fsolve_t.h"
+#include "boltzmann_cvodes_psetupb.h"
+#include "boltzmann_cvodes_psolveb.h"
+int boltzmann_cvodes_psolveb(double t,
+			     N_Vector y,
+			     N_Vector yb,
+			     N_Vector fyb,
+			     N_Vector rb,
+			     N_Vector zb,
+			     double gammab,
+			     double deltab,
+			     int lrb,
+			     void *user_data,
+			     N_Vector tmpb) {
+  /*
+    Adjoint problem preconditioner solve, P^T z = r, with
+    P = Q^T L U Q the factors built by boltzmann_cvodes_psetupb
+    (see boltzmann_cvodes_psolve), so that
+      z = Q^T L^(-T) U^(-T) Q r.
+    The whole solve is done for any lr, as a right preconditioner.
+    If the forward problem has rebuilt the factors since the last
+    boltzmann_cvodes_psetupb call (prec_backward is 0), they are
+    rebuilt for the adjoint problem at y and gammab first.
+    The frow and srow vectors of cvodes_params are used as scratch.
+    Called by: CVodeB, boltzmann_cvodes_adj_solve
+    Calls:     boltzmann_cvodes_psetupb,
+               boltzmann_cvodes_bsolve_t, boltzmann_cvodes_fsolve_t
+  */
+  struct state_struct *state;
+  struct cvodes_params_struct *cvodes_params;
+  double *r_data;
+  double *z_data;
+  double *x;
+  double *w;
+  int    *perm;
+  int ret_code;
+  int success;
+  int jokb;
+  int jcurb;
+  int ny;
+  int alg;
+  int i;
+  int padi;
+
+  state         = (struct state_struct *)user_data;
+  ny            = state->nunique_molecules;
+  cvodes_params = state->cvodes_params;
+  alg           = cvodes_params->sparse_matrix_ordering_alg;
+  perm          = cvodes_params->perm;
+  r_data        = BOLTZMANN_NV_DATA(rb);
+  z_data        = BOLTZMANN_NV_DATA(zb);
+  x             = r_data;
+  success       = 1;
+  if (cvodes_params->prec_backward == 0) {
+    jokb    = 0;
+    success = (boltzmann_cvodes_psetupb(t,y,yb,fyb,jokb,&jcurb,gammab,
+					user_data,tmpb,tmpb,tmpb) == 0);
+  }
+  if (success) {
+    if (alg != 0) {
+      /*
+	x = Q r
+      */
+      x = cvodes_params->frow;
+      for (i=0;i<ny;i++) {
+	x[i] = r_data[perm[i]];
+      }
+    }
+    w = cvodes_params->srow;
+    success = boltzmann_cvodes_bsolve_t(state,x,w);
+  }
+  if (success) {
+    if (alg == 0) {
+      success = boltzmann_cvodes_fsolve_t(state,w,z_data);
+    } else {
+      x = cvodes_params->frow;
+      success = boltzmann_cvodes_fsolve_t(state,w,x);
+      for (i=0;i<ny;i++) {
+	z_data[perm[i]] = x[i];
+      }
+    }
+  }
+  if (success) {
+    ret_code = 0;
+  } else {
+    ret_code = -1;
+  }
+  return(ret_code);
+}
@@ -0,0 +1,14 @@
+#ifndef _BOLTZMANN_CVODES_PSOLVEB_H_
+#define _BOLTZMANN_CVODES_PSOLVEB_H_ 1
+extern int boltzmann_cvodes_psolveb(double t,
+				    N_Vector y,
+				    N_Vector yb,
+				    N_Vector fyb,
+				    N_Vector rb,
+				    N_Vector zb,
+				    double gammab,
+				    double deltab,
+				    int lrb,
+				    void *user_data,
+				    N_Vector tmpb);
+#endif
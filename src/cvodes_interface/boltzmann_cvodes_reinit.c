@@ -0,0 +1,167 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_cvodes_headers.h"
+#include "cvodes_params_struct.h"
+#include "moiety_reduce.h"
+#include "boltzmann_print_cvodeinit_errors.h"
+#include "boltzmann_check_cvodeset_errors.h"
+#include "boltzmann_check_cvodesens_errors.h"
+#include "approximate_ys0.h"
+#include "vec_set_constant.h"
+#include "boltzmann_cvodes_free.h"
+#include "boltzmann_cvodes_reinit.h"
+int boltzmann_cvodes_reinit(struct state_struct *state, double *concs,
+			    int reduced) {
+  /*
+    Re-arm the integrator context kept from the previous boltzmann_cvodes
+    call (CVODES_REUSE_CONTEXT 1) for a new integration from concs at
+    t = 0, with CVodeReInit, and CVodeSensReInit for forward
+    sensitivities. The linear solver, the jacobian and preconditioner
+    workspace with the fill reducing ordering, and the symbolic LU
+    structure of the SLU solver are kept. As cv_nst is 0 after
+    CVodeReInit the first step evaluates a new jacobian.
+    The context is only reused for the problem it was built for, same
+    ode length, moiety reduction, sensitivity type, jacobian choice,
+    stop style and thread count, and never for adjoint sensitivities.
+    Otherwise, or if re-arming fails, the context is freed.
+    Returns 1 if the context was re-armed, 0 if boltzmann_cvodes
+    needs to build a new one.
+    Called by: boltzmann_cvodes
+    Calls:     moiety_reduce,
+               N_VSetArrayPointer,
+	       CVodeReInit,
+	       CVodeSetMaxStep,
+	       CVodeSetStopTime,
+	       approximate_ys0,
+	       CVodeSetSensParams,
+	       CVodeSensReInit,
+	       vec_set_constant,
+	       boltzmann_print_cvodeinit_errors,
+	       boltzmann_check_cvodeset_errors,
+	       boltzmann_check_cvodesens_errors,
+	       boltzmann_cvodes_free,
+	       fabs, fprintf, fflush
+  */
+  struct cvodes_params_struct *cvodes_params;
+  struct ode23tb_params_struct *ode23tb_params;
+  void *cvode_mem;
+  N_Vector y0;
+  double *ke;
+  double *p;
+  double *pbar;
+  double *dfdy;
+  double t0;
+  double tfinal;
+  int *plist;
+  int reused;
+  int flag;
+
+  int ny;
+  int ns;
+
+  int i;
+  int padi;
+
+  FILE *lfp;
+  FILE *efp;
+  lfp           = state->lfp;
+  ny            = state->nunique_molecules;
+  ke            = state->ke;
+  cvodes_params = state->cvodes_params;
+  cvode_mem     = cvodes_params->cvode_mem;
+  y0            = cvodes_params->y0;
+  ns            = cvodes_params->ns;
+  tfinal        = state->ode_t_final;
+  reused        = (cvodes_params->reuse_context != 0) &&
+    (state->compute_sensitivities != 2) &&
+    (cvodes_params->context_ny_ode == cvodes_params->ny_ode) &&
+    (cvodes_params->context_reduced == reduced) &&
+    (cvodes_params->context_sens == (int)state->compute_sensitivities) &&
+    (cvodes_params->context_jacobian_choice == 
+     (int)state->ode_jacobian_choice) &&
+    (cvodes_params->context_stop_style == (int)state->ode_stop_style) &&
+    (cvodes_params->context_num_threads == (int)state->num_threads);
+  if (reused == 0) {
+    if (lfp && state->print_output) {
+      fprintf(lfp,"boltzmann_cvodes_reinit: problem changed, building a "
+	      "new cvodes context\n");
+      fflush(lfp);
+    }
+  }
+  if (reused) {
+    /*
+      y0 wraps the concentrations unless the odes are moiety reduced.
+    */
+    if (reduced) {
+      moiety_reduce(state,concs,BOLTZMANN_NV_DATA(y0));
+    } else {
+      N_VSetArrayPointer(concs,y0);
+    }
+    t0   = 0.0;
+    flag = CVodeReInit(cvode_mem,t0,y0);
+    if (flag < 0) {
+      reused = 0;
+      boltzmann_print_cvodeinit_errors(flag,cvode_mem,state);
+    }
+  }
+  if (reused) {
+    /*
+      The final time may have changed, and the stop time is
+      deactivated once it has been reached.
+    */
+    flag = CVodeSetMaxStep(cvode_mem,tfinal);
+    reused = boltzmann_check_cvodeset_errors(flag,cvode_mem,state,
+					     "MaxStep");
+  }
+  if (reused) {
+    flag = CVodeSetStopTime(cvode_mem,tfinal);
+    reused = boltzmann_check_cvodeset_errors(flag,cvode_mem,state,
+					     "StopTime");
+  }
+  if (reused) {
+    cvodes_params->slu_nstlj = 0;
+    if (state->ode_jacobian_choice == 0) {
+      /*
+	Hand the numerical jacobian workspace back to ode23tb_params,
+	which may have been reset since the last call, and restart
+	the increment history.
+      */
+      ode23tb_params = (struct ode23tb_params_struct *)state->ode23tb_params;
+      dfdy = cvodes_params->nj_dfdy;
+      ode23tb_params->dfdy     = dfdy;
+      ode23tb_params->fac      = &dfdy[ny*ny];
+      ode23tb_params->thresh   = &ode23tb_params->fac[ny];
+      ode23tb_params->fdel     = &ode23tb_params->thresh[ny];
+      ode23tb_params->fdiff    = &ode23tb_params->fdel[ny];
+      ode23tb_params->dfdy_tmp = &ode23tb_params->fdiff[ny];
+      ode23tb_params->num_jac_first_time = 1;
+      ode23tb_params->nf       = 0;
+      vec_set_constant(ny,ode23tb_params->thresh,state->nj_thresh);
+    }
+  }
+  if (reused && (state->compute_sensitivities == 1)) {
+    /*
+      New sensitivity initial conditions in ys0v, wrapped by the
+      ys0 vectors, and parameters from the current ke.
+    */
+    approximate_ys0(state,concs);
+    p     = cvodes_params->p;
+    pbar  = cvodes_params->pbar;
+    plist = cvodes_params->plist;
+    for (i=0;i<ns;i++) {
+      p[i]    = ke[i];
+      pbar[i] = fabs(ke[i]);
+    }
+    flag = CVodeSetSensParams(cvode_mem,p,pbar,plist);
+    reused = boltzmann_check_cvodesens_errors(flag,cvode_mem,state,
+					      "SetSensParams");
+    if (reused) {
+      flag = CVodeSensReInit(cvode_mem,CV_STAGGERED,cvodes_params->ys0);
+      reused = boltzmann_check_cvodesens_errors(flag,cvode_mem,state,
+						"ReInit");
+    }
+  }
+  if (reused == 0) {
+    boltzmann_cvodes_free(state);
+  }
+  return(reused);
+}
@@ -0,0 +1,5 @@
+#ifndef _BOLTZMANN_CVODES_REINIT_H_
+#define _BOLTZMANN_CVODES_REINIT_H_ 1
+extern int boltzmann_cvodes_reinit(struct state_struct *state, double *concs,
+				   int reduced);
+#endif
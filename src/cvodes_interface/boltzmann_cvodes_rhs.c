@@ -16,8 +16,8 @@ int boltzmann_cvodes_rhs(double t, N_Vector y, N_Vector y_dot,
   double *flux;
   state = (struct state_struct *)user_data;
   choice = state->gradient_choice;
-  concs = NV_DATA_S(y);
-  flux  = NV_DATA_S(y_dot);
+  concs = BOLTZMANN_NV_DATA(y);
+  flux  = BOLTZMANN_NV_DATA(y_dot);
   ret_code = 0;
   gradient(state, concs, flux, choice);
   return(ret_code);
@@ -0,0 +1,43 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_cvodes_headers.h"
+#include "gradient.h"
+#include "moiety_expand.h"
+#include "boltzmann_cvodes_rhs_reduced.h"
+int boltzmann_cvodes_rhs_reduced(double t, N_Vector y, N_Vector y_dot,
+				 void *user_data) {
+  /*
+    Right hand side of the moiety reduced odes, y holds the
+    number_independent independent species concentrations.
+    The full concentration vector is rebuilt in moiety_concs,
+    the full gradient formed in moiety_flux and its independent
+    species entries returned in y_dot.
+    Called by: CVode, boltzmann_cvodes
+    Calls:     moiety_expand, gradient
+  */
+  struct state_struct *state;
+  double *yr;
+  double *yr_dot;
+  double *concs;
+  double *flux;
+  int    *independent_species;
+  int choice;
+  int ret_code;
+  int nr;
+  int j;
+
+  state    = (struct state_struct *)user_data;
+  choice   = state->gradient_choice;
+  nr       = (int)state->number_independent;
+  concs    = state->moiety_concs;
+  flux     = state->moiety_flux;
+  independent_species = state->independent_species;
+  yr       = BOLTZMANN_NV_DATA(y);
+  yr_dot   = BOLTZMANN_NV_DATA(y_dot);
+  ret_code = 0;
+  moiety_expand(state,yr,concs);
+  gradient(state, concs, flux, choice);
+  for (j=0;j<nr;j++) {
+    yr_dot[j] = flux[independent_species[j]];
+  }
+  return(ret_code);
+}
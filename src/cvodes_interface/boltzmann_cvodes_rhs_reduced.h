@@ -0,0 +1,5 @@
+#ifndef _BOLTZMANN_CVODES_RHS_REDUCED_H_
+#define _BOLTZMANN_CVODES_RHS_REDUCED_H_ 1
+extern int boltzmann_cvodes_rhs_reduced(double t, N_Vector y, N_Vector y_dot,
+					void *user_data);
+#endif
@@ -0,0 +1,61 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_cvodes_headers.h"
+#include "cvodes_params_struct.h"
+#include "approximate_jacobian.h"
+#include "boltzmann_sparse_tmvp.h"
+#include "boltzmann_cvodes_rhsb.h"
+int boltzmann_cvodes_rhsb(double t, N_Vector y, N_Vector yb, 
+			  N_Vector yb_dot, void *user_data) {
+  /*
+    Right hand side of the adjoint (backward) problem,
+      yb_dot = -J(y)^T yb,
+    where J is the sparse jacobian of the concentration derivatives
+    at the forward solution y(t).
+    Called by: CVodeB, boltzmann_cvodes_adj_solve
+    Calls:     approximate_jacobian,
+               boltzmann_sparse_tmvp
+  */
+  struct state_struct *state;
+  struct cvodes_params_struct *cvodes_params;
+  double *y_data;
+  double *yb_data;
+  double *yb_dot_data;
+  double *fy_data;
+  int choice;
+  int success;
+  int ny;
+  int i;
+  int ret_code;
+  int padi;
+  state         = (struct state_struct *)user_data;
+  ny            = state->nunique_molecules;
+  cvodes_params = state->cvodes_params;
+  /*
+    Always use the sparse thermodynamic jacobian (lr8), the numerical
+    jacobian needs f(y) which is not at hand here.
+  */
+  choice        = 8;
+  y_data      = BOLTZMANN_NV_DATA(y);
+  yb_data     = BOLTZMANN_NV_DATA(yb);
+  yb_dot_data = BOLTZMANN_NV_DATA(yb_dot);
+  /*
+    yb_dot is used as scratch for the delta_concs argument, which
+    lr8_approximate_jacobian does not use.
+  */
+  fy_data     = yb_dot_data;
+  ret_code    = -1;
+  success = approximate_jacobian(state, y_data, fy_data, t, choice);
+  if (success) {
+    success = boltzmann_sparse_tmvp(ny, cvodes_params->dfdy_a,
+				    cvodes_params->dfdy_ia, 
+				    cvodes_params->dfdy_ja, 
+				    yb_data, yb_dot_data);
+  }
+  if (success) {
+    for (i=0;i<ny;i++) {
+      yb_dot_data[i] = 0.0 - yb_dot_data[i];
+    }
+    ret_code = 0;
+  }
+  return(ret_code);
+}
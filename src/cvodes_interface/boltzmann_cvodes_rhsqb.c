@@ -0,0 +1,62 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_cvodes_headers.h"
+#include "cvodes_params_struct.h"
+#include "lr8_dfdke.h"
+#include "boltzmann_cvodes_rhsqb.h"
+int boltzmann_cvodes_rhsqb(double t, N_Vector y, N_Vector yb, 
+			   N_Vector qb_dot, void *user_data) {
+  /*
+    Right hand side of the backward quadrature for the adjoint
+    sensitivities with respect to the equilibrium constants,
+      qb_dot = -(df/dke)^T yb,
+    so that the quadrature integrated from t_final back to 0 gives dG/dke.
+    Reaction r only contributes to the fluxes of its own variable
+    species, each with its stoichiometric coefficient times
+    d rfc[r]/d ke[r] as computed by lr8_dfdke.
+
+    Called by: CVodeB, boltzmann_cvodes_adj_solve
+    Calls:     lr8_dfdke
+  */
+  struct state_struct *state;
+  struct molecule_struct *molecules;
+  struct reactions_matrix_struct *rxn_matrix;
+  double *y_data;
+  double *yb_data;
+  double *qb_dot_data;
+  double *rcoefficients;
+  int64_t *rxn_ptrs;
+  int64_t *molecule_indices;
+  double lsum;
+  int num_rxns;
+  int i;
+  int j;
+  int mi;
+  int ret_code;
+
+  state            = (struct state_struct *)user_data;
+  num_rxns         = state->number_reactions;
+  molecules        = state->sorted_molecules;
+  rxn_matrix       = state->reactions_matrix;
+  rxn_ptrs         = rxn_matrix->rxn_ptrs;
+  molecule_indices = rxn_matrix->molecules_indices;
+  rcoefficients    = rxn_matrix->coefficients;
+  y_data           = BOLTZMANN_NV_DATA(y);
+  yb_data          = BOLTZMANN_NV_DATA(yb);
+  qb_dot_data      = BOLTZMANN_NV_DATA(qb_dot);
+  ret_code         = 0;
+  /*
+    qb_dot has one entry per reaction so it first receives dfdke.
+  */
+  lr8_dfdke(state,y_data,qb_dot_data);
+  for (i=0;i<num_rxns;i++) {
+    lsum = 0.0;
+    for (j=rxn_ptrs[i];j<rxn_ptrs[i+1];j++) {
+      mi = molecule_indices[j];
+      if (molecules[mi].variable == 1) {
+	lsum += rcoefficients[j] * yb_data[mi];
+      }
+    }
+    qb_dot_data[i] = 0.0 - (qb_dot_data[i] * lsum);
+  }
+  return(ret_code);
+}
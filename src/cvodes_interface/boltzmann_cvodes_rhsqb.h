@@ -0,0 +1,5 @@
+#ifndef _BOLTZMANN_CVODES_RHSQB_H_
+#define _BOLTZMANN_CVODES_RHSQB_H_ 1
+extern int boltzmann_cvodes_rhsqb(double t, N_Vector y, N_Vector yb, 
+				  N_Vector qb_dot, void *user_data);
+#endif
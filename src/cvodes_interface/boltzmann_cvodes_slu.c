@@ -0,0 +1,55 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_cvodes_headers.h"
+#include "cvodes_impl.h"
+#include "cvodes_params_struct.h"
+#include "boltzmann_cvodes_slu_setup.h"
+#include "boltzmann_cvodes_slu_solve.h"
+#include "boltzmann_cvodes_slu_free.h"
+#include "boltzmann_cvodes_slu.h"
+int boltzmann_cvodes_slu(void *cvode_mem, struct state_struct *state) {
+  /*
+    Attach the in-tree sparse direct solver (CVODES_SOLVER SLU,
+    linear_solver_method 10) to cvode_mem as its linear solver, in place
+    of the CVSpgmr Krylov solver.
+    SUNDIALS 2.7.0 has no public interface for user linear solvers so,
+    as CVDense and the other cvodes linear solvers do, this sets the
+    cv_lsetup, cv_lsolve and cv_lfree fields of the cvodes memory
+    record directly. The setup routine builds the sparse jacobian and
+    M = I - gamma J and factors it with sparse_lu_factor, the solve
+    routine applies the factors.
+    Called by: boltzmann_cvodes_init
+    Calls:     boltzmann_cvodes_slu_setup, boltzmann_cvodes_slu_solve,
+               boltzmann_cvodes_slu_free, fprintf, fflush
+  */
+  struct cvodes_params_struct *cvodes_params;
+  CVodeMem cv_mem;
+  int success;
+  int padi;
+  FILE *lfp;
+  FILE *efp;
+  success       = 1;
+  lfp           = state->lfp;
+  cvodes_params = state->cvodes_params;
+  cv_mem        = (CVodeMem)cvode_mem;
+  if (cv_mem == NULL) {
+    success = 0;
+    if (lfp) {
+      fprintf(lfp,"boltzmann_cvodes_slu: Error cvode_mem is NULL\n");
+      fflush(lfp);
+    }
+  }
+  if (success) {
+    if (cv_mem->cv_lfree != NULL) {
+      cv_mem->cv_lfree(cv_mem);
+    }
+    cv_mem->cv_linit         = NULL;
+    cv_mem->cv_lsetup        = boltzmann_cvodes_slu_setup;
+    cv_mem->cv_lsolve        = boltzmann_cvodes_slu_solve;
+    cv_mem->cv_lfree         = boltzmann_cvodes_slu_free;
+    cv_mem->cv_lmem          = (void *)state;
+    cv_mem->cv_setupNonNull  = TRUE;
+    cvodes_params->slu_factors = NULL;
+    cvodes_params->slu_nstlj   = 0;
+  }
+  return(success);
+}
@@ -0,0 +1,4 @@
+#ifndef _BOLTZMANN_CVODES_SLU_H_
+#define _BOLTZMANN_CVODES_SLU_H_ 1
+extern int boltzmann_cvodes_slu(void *cvode_mem, struct state_struct *state);
+#endif
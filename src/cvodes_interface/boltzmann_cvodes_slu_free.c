@@ -0,0 +1,29 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_cvodes_headers.h"
+#include "cvodes_impl.h"
+#include "cvodes_params_struct.h"
+#include "boltzmann_cvodes_slu_free.h"
+int boltzmann_cvodes_slu_free(struct CVodeMemRec *cv_mem) {
+  /*
+    cvodes lfree routine of the sparse direct solver, frees the
+    LU factors allocated by sparse_lu_symbolic.
+    Called by: CVodeFree
+    Calls:     free
+  */
+  struct state_struct *state;
+  struct cvodes_params_struct *cvodes_params;
+  state         = (struct state_struct *)cv_mem->cv_lmem;
+  if (state != NULL) {
+    cvodes_params = state->cvodes_params;
+    if (cvodes_params->slu_factors != NULL) {
+      free(cvodes_params->slu_factors);
+      cvodes_params->slu_factors = NULL;
+      cvodes_params->prec_l      = NULL;
+      cvodes_params->prec_u      = NULL;
+      cvodes_params->prec_jl     = NULL;
+      cvodes_params->prec_ju     = NULL;
+    }
+  }
+  cv_mem->cv_lmem = NULL;
+  return(0);
+}
@@ -0,0 +1,4 @@
+#ifndef _BOLTZMANN_CVODES_SLU_FREE_H_
+#define _BOLTZMANN_CVODES_SLU_FREE_H_ 1
+extern int boltzmann_cvodes_slu_free(struct CVodeMemRec *cv_mem);
+#endif
@@ -0,0 +1,96 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_cvodes_headers.h"
+#include "cvodes_impl.h"
+#include "cvodes_params_struct.h"
+#include "approximate_jacobian.h"
+#include "build_newton_matrix.h"
+#include "sparse_lu_symbolic.h"
+#include "sparse_lu_factor.h"
+#include "boltzmann_cvodes_slu_setup.h"
+int boltzmann_cvodes_slu_setup(struct CVodeMemRec *cv_mem,
+			       int convfail,
+			       N_Vector ypred,
+			       N_Vector fpred,
+			       booleantype *jcur_ptr,
+			       N_Vector vtemp1,
+			       N_Vector vtemp2,
+			       N_Vector vtemp3) {
+  /*
+    cvodes lsetup routine of the sparse direct solver.
+    Decide whether the jacobian needs to be recomputed, with the rules
+    of the cvodes dense solver: on the first step, every 50 steps,
+    after a convergence failure with an out of date jacobian and when
+    gamma has changed by more than 20% since the last evaluation.
+    Otherwise the sparse jacobian in dfdy_a, dfdy_ia, dfdy_ja is reused.
+    Then M = I - gamma J is formed by build_newton_matrix and factored
+    by sparse_lu_factor, the symbolic factorization being computed
+    on the first call and again only if M has gained entries.
+    Returns 0 on success, 1 (recoverable, cvodes reduces the step)
+    for a zero pivot, and -1 if the jacobian or the symbolic
+    factorization failed.
+    Called by: CVode
+    Calls:     approximate_jacobian, build_newton_matrix,
+               sparse_lu_symbolic, sparse_lu_factor, fabs
+  */
+  struct state_struct *state;
+  struct cvodes_params_struct *cvodes_params;
+  double *y_data;
+  double *fy_data;
+  double dgamma;
+  int    choice;
+  int    jbad;
+  int    success;
+  int    ret_code;
+
+  state         = (struct state_struct *)cv_mem->cv_lmem;
+  cvodes_params = state->cvodes_params;
+  choice        = state->ode_jacobian_choice;
+  y_data        = BOLTZMANN_NV_DATA(ypred);
+  fy_data       = BOLTZMANN_NV_DATA(fpred);
+  success       = 1;
+  dgamma        = fabs((cv_mem->cv_gamma/cv_mem->cv_gammap) - 1.0);
+  jbad = (cv_mem->cv_nst == 0) || 
+    (cv_mem->cv_nst > cvodes_params->slu_nstlj + 50) ||
+    ((convfail == CV_FAIL_BAD_J) && (dgamma < 0.2)) ||
+    (convfail == CV_FAIL_OTHER);
+  ret_code  = 0;
+  *jcur_ptr = FALSE;
+  if (jbad) {
+    success = approximate_jacobian(state,y_data,fy_data,cv_mem->cv_tn,choice);
+    if (success) {
+      cvodes_params->slu_nstlj = (int)cv_mem->cv_nst;
+      *jcur_ptr = TRUE;
+    } else {
+      ret_code = -1;
+    }
+  }
+  if (ret_code == 0) {
+    success = build_newton_matrix(state,cv_mem->cv_gamma,choice);
+    if (success == 0) {
+      ret_code = -1;
+    }
+  }
+  if ((ret_code == 0) && (cvodes_params->slu_factors == NULL)) {
+    success = sparse_lu_symbolic(state);
+    if (success == 0) {
+      ret_code = -1;
+    }
+  }
+  if (ret_code == 0) {
+    success = sparse_lu_factor(state);
+    if (success == -1) {
+      /*
+	M has an entry outside the symbolic structure.
+      */
+      if (sparse_lu_symbolic(state)) {
+	success = sparse_lu_factor(state);
+      }
+    }
+    if (success == 0) {
+      ret_code = 1;
+    } else if (success == -1) {
+      ret_code = -1;
+    }
+  }
+  return(ret_code);
+}
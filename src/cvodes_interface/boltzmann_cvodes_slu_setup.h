@@ -0,0 +1,11 @@
+#ifndef _BOLTZMANN_CVODES_SLU_SETUP_H_
+#define _BOLTZMANN_CVODES_SLU_SETUP_H_ 1
+extern int boltzmann_cvodes_slu_setup(struct CVodeMemRec *cv_mem,
+				      int convfail,
+				      N_Vector ypred,
+				      N_Vector fpred,
+				      booleantype *jcur_ptr,
+				      N_Vector vtemp1,
+				      N_Vector vtemp2,
+				      N_Vector vtemp3);
+#endif
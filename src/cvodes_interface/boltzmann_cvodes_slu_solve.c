@@ -0,0 +1,67 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_cvodes_headers.h"
+#include "cvodes_impl.h"
+#include "cvodes_params_struct.h"
+#include "boltzmann_cvodes_fsolve.h"
+#include "boltzmann_cvodes_bsolve.h"
+#include "boltzmann_cvodes_slu_solve.h"
+int boltzmann_cvodes_slu_solve(struct CVodeMemRec *cv_mem,
+			       N_Vector b,
+			       N_Vector weight,
+			       N_Vector ycur,
+			       N_Vector fcur) {
+  /*
+    cvodes lsolve routine of the sparse direct solver.
+    Solve M x = b with the LU factors from boltzmann_cvodes_slu_setup,
+    M = Q^T L U Q, Q being the symmetric permutation given by the perm
+    field of cvodes_params, and return x in b.
+    For BDF, when gamma has changed since M was factored the solution
+    is scaled by 2/(1 + gamma/gammap), as in the cvodes direct solvers.
+    The frow and srow vectors of cvodes_params are used as scratch.
+    Called by: CVode
+    Calls:     boltzmann_cvodes_fsolve, boltzmann_cvodes_bsolve
+  */
+  struct state_struct *state;
+  struct cvodes_params_struct *cvodes_params;
+  double *b_data;
+  double *x;
+  double *w;
+  double scale;
+  int    *perm;
+  int    ny;
+  int    alg;
+  int    i;
+  int    padi;
+
+  state         = (struct state_struct *)cv_mem->cv_lmem;
+  cvodes_params = state->cvodes_params;
+  ny            = state->nunique_molecules;
+  alg           = cvodes_params->sparse_matrix_ordering_alg;
+  perm          = cvodes_params->perm;
+  b_data        = BOLTZMANN_NV_DATA(b);
+  x             = cvodes_params->frow;
+  w             = cvodes_params->srow;
+  if (alg == 0) {
+    boltzmann_cvodes_fsolve(state,b_data,w);
+    boltzmann_cvodes_bsolve(state,w,b_data);
+  } else {
+    /*
+      x = Q b, solve L U w = x, b = Q^T w.
+    */
+    for (i=0;i<ny;i++) {
+      x[i] = b_data[perm[i]];
+    }
+    boltzmann_cvodes_fsolve(state,x,w);
+    boltzmann_cvodes_bsolve(state,w,x);
+    for (i=0;i<ny;i++) {
+      b_data[perm[i]] = x[i];
+    }
+  }
+  if ((cv_mem->cv_lmm == CV_BDF) && (cv_mem->cv_gamrat != 1.0)) {
+    scale = 2.0/(1.0 + cv_mem->cv_gamrat);
+    for (i=0;i<ny;i++) {
+      b_data[i] = b_data[i] * scale;
+    }
+  }
+  return(0);
+}
@@ -0,0 +1,8 @@
+#ifndef _BOLTZMANN_CVODES_SLU_SOLVE_H_
+#define _BOLTZMANN_CVODES_SLU_SOLVE_H_ 1
+extern int boltzmann_cvodes_slu_solve(struct CVodeMemRec *cv_mem,
+				      N_Vector b,
+				      N_Vector weight,
+				      N_Vector ycur,
+				      N_Vector fcur);
+#endif
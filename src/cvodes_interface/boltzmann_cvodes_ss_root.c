@@ -0,0 +1,37 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_cvodes_headers.h"
+#include "cvodes_params_struct.h"
+#include "moiety_expand.h"
+#include "ode_steady_state_residual.h"
+#include "boltzmann_cvodes_ss_root.h"
+int boltzmann_cvodes_ss_root(double t, N_Vector y, double *gout,
+			     void *user_data) {
+  /*
+    Root function for steady state termination (ode_stop_style = 1),
+      gout[0] = ode_steady_state_residual(y),
+    which decreases through 0 when the ODE_STOP_THRESH criterion is met,
+    so CVode returns CV_ROOT_RETURN at the first internal step where it
+    holds, independent of the output interval.
+    For a moiety reduced integration y holds only the independent
+    species and is expanded first.
+    Called by: CVode, boltzmann_cvodes_init
+    Calls:     moiety_expand, ode_steady_state_residual
+  */
+  struct state_struct *state;
+  struct cvodes_params_struct *cvodes_params;
+  double *concs;
+  int ny;
+  int ret_code;
+
+  state         = (struct state_struct *)user_data;
+  cvodes_params = state->cvodes_params;
+  ny            = (int)state->nunique_molecules;
+  concs         = BOLTZMANN_NV_DATA(y);
+  ret_code      = 0;
+  if (cvodes_params->ny_ode < ny) {
+    moiety_expand(state,concs,state->moiety_concs);
+    concs = state->moiety_concs;
+  }
+  gout[0] = ode_steady_state_residual(state,ny,concs,cvodes_params->root_f);
+  return(ret_code);
+}
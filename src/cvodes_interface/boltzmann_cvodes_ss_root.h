@@ -0,0 +1,5 @@
+#ifndef _BOLTZMANN_CVODES_SS_ROOT_H_
+#define _BOLTZMANN_CVODES_SS_ROOT_H_ 1
+extern int boltzmann_cvodes_ss_root(double t, N_Vector y, double *gout,
+				    void *user_data);
+#endif
@@ -54,6 +54,17 @@ void boltzmann_size_jacobian(struct state_struct *state) {
     rowlen = rxn_ptrs[i+1] - rxn_ptrs[i];
     nnz += (rowlen * rowlen);
   }
+#ifdef _OPENMP
+  if (state->num_threads > 1) {
+    /*
+      Threaded assembly in lr8_approximate_jacobian gives each row a
+      segment of the sum of the lengths of its reactions (at least 1 for
+      the diagonal) before compacting, so leave room for the diagonal of
+      species in no reaction.
+    */
+    nnz += ny;
+  }
+#endif
   if (nnz > ny2) {
     nnz = ny2; /* Dense Jacobian, might want to  set a flag here. */
   }
@@ -67,6 +78,25 @@ void boltzmann_size_jacobian(struct state_struct *state) {
   */
   nnzl = nnzm + (fill * ny);
   nnzu = nnzm + (fill * ny);
+  if (state->cvodes_prec_choice == 2) {
+    /*
+      For ILU(k), the fill grows with the level rather than by a fixed
+      number of entries per row. Neither triangle holds more than
+      ny*(ny+1)/2 entries.
+    */
+    if (fill < 0) {
+      fill = 0;
+    }
+    nnzl = nnzm * (fill + 1);
+    ny2  = (ny * (ny + 1))/2;
+    if (nnzl > ny2) {
+      nnzl = ny2;
+    }
+    if (nnzl < nnzm) {
+      nnzl = nnzm;
+    }
+    nnzu = nnzl;
+  }
   cvodes_params->nnz  = nnz;
   cvodes_params->nnzm = nnzm;
   cvodes_params->nnzl = nnzl;
@@ -12,6 +12,12 @@ struct cvodes_params_struct {
   N_Vector y0;
   N_Vector *ys0;
   N_Vector *dys;
+  /*
+    Adjoint state and quadrature vectors for the backward problem
+    (compute_sensitivities == 2).
+  */
+  N_Vector yB;
+  N_Vector qB;
   double *drfc;
   double *dfdy_a;
   double *dfdy_at;
@@ -25,7 +31,27 @@ struct cvodes_params_struct {
   double *p;
   double *rp;
   double *pbar;
+  /*
+    Per reaction partials d rfc/d ke (ns) for boltzmann_cvodes_fs.
+  */
+  double *sens_dfdke;
+  /*
+    Derivative scratch (ny) for the steady state root function.
+  */
+  double *root_f;
   double *ys0v;
+  /*
+    Block holding prec_l, prec_u, prec_jl and prec_ju for the complete
+    LU factors of the sparse direct solver (CVODES_SOLVER SLU), allocated
+    by sparse_lu_symbolic and freed by boltzmann_cvodes_slu_free.
+  */
+  double *slu_factors;
+  /*
+    Numerical jacobian workspace (ode_jacobian_choice 0) handed out to
+    ode23tb_params, kept here so that a reused context can hand it out
+    again.
+  */
+  double *nj_dfdy;
   int    *dfdy_ia;
   int    *dfdy_ja;
   int    *dfdy_iat;
@@ -41,6 +67,35 @@ struct cvodes_params_struct {
   int    *column_mask;
   int    *sindex;
   int    *plist;
+  /*
+    Symmetric permutation applied to M before factoring it for the
+    preconditioner: perm[new] = old, iperm[old] = new.
+  */
+  int    *perm;
+  int    *iperm;
+  /*
+    Fill levels of the entries in prec_u, used by iluk.
+  */
+  int    *prec_ulev;
+  /*
+    Per thread dense row and column mask (num_threads * ny each) for
+    threaded jacobian assembly in lr8_approximate_jacobian,
+    NULL unless num_threads > 1 in an OpenMP build.
+  */
+  double *thread_rows;
+  int    *thread_masks;
+  /*
+    Adjoint sensitivity objective,
+      G = 1/2 sum_i adj_weight[i]*(y_i(t_final) - adj_target[i])^2,
+    adj_target and adj_weight are of length ny, adj_weight is 0 for
+    species not listed in the ODE_ADJ_TARGET_FILE.
+    adj_grad (ns) receives dG/dke.
+  */
+  double *adj_target;
+  double *adj_weight;
+  double *adj_grad;
+  double adj_objective;
+  double adj_t_final;
   /*
     Relative tolerance.
   */
@@ -183,8 +238,9 @@ struct cvodes_params_struct {
   */
   int no_inactive_root_warn;
   /*
-    sparse matrix ordering alogroithm.
-    not used.
+    Sparse matrix ordering algorithm applied to the Newton iteration
+    matrix before preconditioning:
+    0 natural order, 1 reverse Cuthill-McKee, 2 minimum degree.
   */
   int sparse_matrix_ordering_alg;
   /*
@@ -228,7 +284,50 @@ struct cvodes_params_struct {
   */
   int ns;
   int ism;
-
+  /*
+    Number of integration steps between adjoint check points, and the
+    identifier of the backward problem returned by CVodeCreateB.
+  */
+  int adj_steps;
+  int adj_which;
+  /*
+    1 when the preconditioner factors were last built for the adjoint
+    problem by boltzmann_cvodes_psetupb, 0 when for the forward problem
+    by boltzmann_cvodes_psetup. CVodeB reintegrates the forward problem
+    over each check point interval, rebuilding the factors.
+  */
+  int prec_backward;
+  int prec_backward_padi;
+  /*
+    Forward sensitivity right hand side, 0 for the cvodes difference
+    quotients, 1 for the analytic boltzmann_cvodes_fs (lr8 jacobian).
+  */
+  int sens_rhs_choice;
+  /*
+    Length of the cvodes state vector, nunique_molecules, or
+    number_independent when the odes are moiety reduced.
+  */
+  int ny_ode;
+  /*
+    Step number of the last jacobian evaluation by the sparse direct
+    solver setup routine.
+  */
+  int slu_nstlj;
+  int slu_padi;
+  /*
+    Keep the integrator context (cvode_mem, y0, ys0, the jacobian and
+    preconditioner workspace and LU factors) between boltzmann_cvodes
+    calls and re-arm it with CVodeReInit, 1 for yes, 0 (default) for no.
+    The context_ fields record the problem the context was built for.
+  */
+  int reuse_context;
+  int context_ny_ode;
+  int context_reduced;
+  int context_sens;
+  int context_jacobian_choice;
+  int context_stop_style;
+  int context_num_threads;
+  int context_padi;
 }
 ;
 #endif
@@ -0,0 +1,98 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_cvodes_headers.h"
+#include "cvodes_params_struct.h"
+#include "get_counts.h"
+#include "conc_to_pow.h"
+#include "update_regulations.h"
+#include "lr8_dfdke.h"
+int lr8_dfdke(struct state_struct *state, double *concs, double *dfdke) {
+  /*
+    Compute the partial of each reaction flux term rfc[i] of lr8_gradient
+    with respect to its own equilibrium constant,
+      rfc[i] = (ke[i]*(rt/tp) - (1/ke[i])*(pt/tr)) * activities[i],
+    so
+      dfdke[i] = ((rt/tp) + (pt/tr)/(ke[i]*ke[i])) * activities[i].
+    The concentration derivative of variable species m then has
+    partial coefficient(i,m)*dfdke[i] with respect to ke[i], and no
+    dependence on the other equilibrium constants.
+    If sensitivities are being computed with cvodes the equilibrium
+    constants are taken from cvodes_params->p.
+
+    Called by: boltzmann_cvodes_fs, boltzmann_cvodes_rhsqb
+    Calls:     get_counts, conc_to_pow, update_regulations
+  */
+  struct cvodes_params_struct *cvodes_params;
+  struct reactions_matrix_struct *rxn_matrix;
+  double *activities;
+  double *ke;
+  double *counts;
+  double *conc_to_count;
+  double *rcoefficients;
+  int64_t *rxn_ptrs;
+  int64_t *molecules_indices;
+  double pt;
+  double rt;
+  double tp;
+  double tr;
+  double klim;
+  double count_mi;
+  double count_plus;
+  double rkei;
+  double factorial;
+  int num_rxns;
+  int ny;
+  int i;
+  int j;
+  int mi;
+  int count_or_conc;
+  int success;
+  int padi;
+
+  success           = 1;
+  ny                = state->nunique_molecules;
+  num_rxns          = state->number_reactions;
+  activities        = state->activities;
+  counts            = state->ode_counts;
+  conc_to_count     = state->conc_to_count;
+  rxn_matrix        = state->reactions_matrix;
+  rxn_ptrs          = rxn_matrix->rxn_ptrs;
+  molecules_indices = rxn_matrix->molecules_indices;
+  rcoefficients     = rxn_matrix->coefficients;
+  ke                = state->ke;
+  if (state->compute_sensitivities && (state->ode_solver_choice == 1)) {
+    cvodes_params   = state->cvodes_params;
+    ke              = cvodes_params->p;
+  }
+  factorial         = 0.0;
+  get_counts(ny,concs,conc_to_count,counts);
+  if (state->use_regulation) {
+    count_or_conc = 0;
+    update_regulations(state,concs,count_or_conc);
+  }
+  for (i=0;i<num_rxns;i++) {
+    pt = 1.0;
+    rt = 1.0;
+    tr = 1.0;
+    tp = 1.0;
+    for (j=rxn_ptrs[i];j<rxn_ptrs[i+1];j++) {
+      mi = molecules_indices[j];
+      klim = rcoefficients[j];
+      count_mi = counts[mi];
+      if (klim < 0.0) {
+	klim = 0.0 - klim;
+	rt   = rt * conc_to_pow(count_mi,klim,factorial);
+	count_plus = count_mi + klim;
+	tr   = tr * conc_to_pow(count_plus,klim,factorial);
+      } else {
+	if (klim > 0.0) {
+	  pt = pt * conc_to_pow(count_mi,klim,factorial);
+	  count_plus = count_mi + klim;
+	  tp = tp * conc_to_pow(count_plus,klim,factorial);
+	}
+      }
+    }
+    rkei     = 1.0/ke[i];
+    dfdke[i] = ((rt/tp) + (rkei * rkei * (pt/tr))) * activities[i];
+  }
+  return(success);
+}
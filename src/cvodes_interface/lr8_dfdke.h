@@ -0,0 +1,4 @@
+#ifndef _LR8_DFDKE_H_
+#define _LR8_DFDKE_H_ 1
+extern int lr8_dfdke(struct state_struct *state, double *concs, double *dfdke);
+#endif
@@ -0,0 +1,154 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_cvodes_headers.h"
+#include "cvodes_params_struct.h"
+#include "molecules_lookup.h"
+#include "compartment_lookup.h"
+#include "upcase.h"
+#include "read_adj_targets.h"
+int read_adj_targets(struct state_struct *state) {
+  /*
+    Read the target concentrations for the adjoint sensitivity objective
+    from the ode_adj_target_file, setting cvodes_params->adj_target and
+    cvodes_params->adj_weight. Each line has the form
+
+      molecule[:compartment] target_conc [weight]
+
+    weight defaults to 1. Blank lines and lines starting with # are 
+    skipped. Species not listed get weight 0.
+
+    Called by: boltzmann_cvodes_adj_init
+    Calls:     molecules_lookup,
+               compartment_lookup,
+	       upcase,
+	       fopen, fgets, sscanf, fclose, fprintf, fflush (intrinsic)
+  */
+  struct cvodes_params_struct *cvodes_params;
+  double *adj_target;
+  double *adj_weight;
+  double target;
+  double weight;
+  char *buffer;
+  char *molecule_name;
+  char *compartment_name;
+  char *fgp;
+  int64_t buff_len;
+  int ny;
+  int i;
+
+  int nscan;
+  int si;
+
+  int ci;
+  int mol_len;
+
+  int cmpt_len;
+  int line_count;
+
+  int num_targets;
+  int success;
+
+  FILE *target_fp;
+  FILE *lfp;
+
+  success          = 1;
+  lfp              = state->lfp;
+  ny               = state->nunique_molecules;
+  cvodes_params    = state->cvodes_params;
+  adj_target       = cvodes_params->adj_target;
+  adj_weight       = cvodes_params->adj_weight;
+  buff_len         = state->max_param_line_len;
+  buffer           = state->param_buffer;
+  molecule_name    = buffer + state->max_param_line_len;
+  for (i=0;i<ny;i++) {
+    adj_target[i] = 0.0;
+    adj_weight[i] = 0.0;
+  }
+  num_targets = 0;
+  line_count  = 0;
+  target_fp = NULL;
+  if (state->ode_adj_target_file[0] == '\0') {
+    success = 0;
+    if (lfp) {
+      fprintf(lfp,"read_adj_targets: Error COMPUTE_SENSITIVITIES 2 needs an "
+	      "ODE_ADJ_TARGET_FILE\n");
+      fflush(lfp);
+    }
+  } else {
+    target_fp = fopen(state->ode_adj_target_file,"r");
+    if (target_fp == NULL) {
+      success = 0;
+      if (lfp) {
+	fprintf(lfp,"read_adj_targets: Error unable to open %s\n",
+		state->ode_adj_target_file);
+	fflush(lfp);
+      }
+    }
+  }
+  if (success) {
+    while (success && !feof(target_fp)) {
+      fgp = fgets(buffer,buff_len,target_fp);
+      if (fgp == NULL) {
+	break;
+      }
+      line_count += 1;
+      weight = 1.0;
+      nscan = sscanf(buffer,"%s %le %le",molecule_name,&target,&weight);
+      if ((nscan < 1) || (molecule_name[0] == '#')) {
+	continue;
+      }
+      if (nscan < 2) {
+	success = 0;
+	if (lfp) {
+	  fprintf(lfp,"read_adj_targets: Error, line %d has no target "
+		  "concentration\n",line_count);
+	  fflush(lfp);
+	}
+	break;
+      }
+      mol_len = strlen(molecule_name);
+      compartment_name = molecule_name;
+      cmpt_len = 0;
+      for (i=0;i<mol_len-1;i++) {
+	if (molecule_name[i] == ':') {
+	  compartment_name = (char *)&molecule_name[i+1];
+	  molecule_name[i] = '\0';
+	  cmpt_len = mol_len - i - 1;
+	  mol_len = i;
+	  break;
+	}
+      }
+      ci = 0;
+      if (compartment_name != molecule_name) {
+	upcase(cmpt_len,compartment_name);
+	ci = compartment_lookup(compartment_name,state);
+      }
+      si = -1;
+      if (ci >= 0) {
+	upcase(mol_len,molecule_name);
+	si = molecules_lookup(molecule_name,ci,state);
+      }
+      if ((si < 0) || (si >= ny)) {
+	success = 0;
+	if (lfp) {
+	  fprintf(lfp,"read_adj_targets: Error, line %d, %s is not a species "
+		  "in the reactions file\n",line_count,molecule_name);
+	  fflush(lfp);
+	}
+      } else {
+	adj_target[si] = target;
+	adj_weight[si] = weight;
+	num_targets += 1;
+      }
+    }
+    fclose(target_fp);
+  }
+  if (success && (num_targets == 0)) {
+    success = 0;
+    if (lfp) {
+      fprintf(lfp,"read_adj_targets: Error no targets in %s\n",
+	      state->ode_adj_target_file);
+      fflush(lfp);
+    }
+  }
+  return(success);
+}
@@ -0,0 +1,4 @@
+#ifndef _READ_ADJ_TARGETS_H_
+#define _READ_ADJ_TARGETS_H_ 1
+extern int read_adj_targets(struct state_struct *state);
+#endif
@@ -27,6 +27,8 @@ specific language governing permissions and limitations under the License.
 #include "alloc7.h"
 #include "init_base_reactants.h"
 #include "init_relative_rates.h"
+#include "init_rxn_terms.h"
+#include "init_moieties.h"
 #include "update_rxn_likelihoods.h"
 #include "ode_print_concs_header.h"
 #include "ode_print_grad_header.h"
@@ -41,7 +43,11 @@ specific language governing permissions and limitations under the License.
 #include "fill_flux_pieces.h"
 #include "ode23tb.h"
 */
+#include "ode_solver_autotune.h"
+#include "codegen_init.h"
 #include "ode_solver.h"
+#include "lsq_steady_state.h"
+#include "compute_dfdke_dfdmu0.h"
 
 #include "deq_run.h"
 int deq_run(struct state_struct *state) {
@@ -55,8 +61,14 @@ int deq_run(struct state_struct *state) {
     Called by: deq, boltzmann_run
     Calls:     init_base_reactants,
 	       init_relative_rates,
+	       init_rxn_terms,
+	       init_moieties,
 	       update_rxn_likelihoods,
-	       ode_solver
+	       ode_solver_autotune,
+	       codegen_init,
+	       ode_solver,
+	       lsq_steady_state,
+	       compute_dfdke_dfdmu0
   */
   struct molecule_struct *molecules;
   struct molecule_struct *molecule;
@@ -77,6 +89,7 @@ int deq_run(struct state_struct *state) {
   double *dg0s;
   double *free_energy;
   double htry;
+  double ode_t_final;
   double min_conc;
   int64_t *rxn_fire;
   int64_t i;
@@ -122,6 +135,9 @@ int deq_run(struct state_struct *state) {
   int solver_choice;
   int ode_rxn_view_freq;
 
+  int use_lsqnonlin;
+  int gradient_choice;
+
 
   FILE *lfp;
   FILE *ode_kq_fp;
@@ -215,6 +231,15 @@ int deq_run(struct state_struct *state) {
       success = init_relative_rates(state);
     }
   }
+  /*
+    Fill the flattened reaction terms used by the fused lr15_gradient
+    and the log space lr16_gradient.
+  */
+  if (success) {
+    if ((state->gradient_choice == 15) || (state->gradient_choice == 16)) {
+      success = init_rxn_terms(state);
+    }
+  }
   counts = current_counts;
   /*
     Initialize the ode_forward_lklhds and ode_reverse_lklhds fields.
@@ -235,6 +260,36 @@ int deq_run(struct state_struct *state) {
       concs[i] = counts[i] * count_to_conc[i];
     }
   }
+  /*
+    CODEGEN 1: compile and load the network specific lr8 kernels.
+  */
+  if (success) {
+    success = codegen_init(state);
+  }
+  /*
+    ODE_SOLVER_CHOICE AUTO: pick the solver with short probe integrations.
+  */
+  if (success && (solver_choice < 0)) {
+    success = ode_solver_autotune(state,concs);
+    solver_choice = (int)state->ode_solver_choice;
+  }
+  /*
+    Find the conserved moieties so that cvodes can integrate only
+    the independent species.
+  */
+  if (success) {
+    if (state->reduce_moieties) {
+      if (solver_choice == 1) {
+	success = init_moieties(state,concs);
+      } else {
+	if (lfp) {
+	  fprintf(lfp,"deq_run: REDUCE_MOIETIES is only used with "
+		  "ODE_SOLVER_CHOICE 1 (cvodes), ignored\n");
+	  fflush(lfp);
+	}
+      }
+    }
+  }
   /*
     Convert counts to continuous setting if 0 to avoid 0 concentrations.
   */
@@ -262,9 +317,60 @@ int deq_run(struct state_struct *state) {
 	*/
 	print_net_likelihood_header(state);
 	print_net_lklhd_bndry_flux_header(state);
+      } else {
+	if (state->ode_dense_output > 0) {
+	  ode_print_concs_header(state);
+	}
+      }
+    }
+    use_lsqnonlin = (int)state->use_lsqnonlin;
+    if (use_lsqnonlin) {
+      gradient_choice = (int)state->gradient_choice;
+      if ((gradient_choice != 8) && (gradient_choice != 15) &&
+	  (gradient_choice != 16)) {
+	/*
+	  lsq_steady_state steps with the lr8 jacobian, which is only
+	  the jacobian of the lr8, lr15 and lr16 derivatives.
+	*/
+	use_lsqnonlin = 0;
+	if (lfp) {
+	  fprintf(lfp,"deq_run: USE_LSQNONLIN needs DELTA_CONCS_CHOICE 8, "
+		  "15 or 16, not %d, integrating the odes instead\n",
+		  gradient_choice);
+	  fflush(lfp);
+	}
+      }
+    }
+    if (use_lsqnonlin) {
+      /*
+	Solve f(concs) = 0 directly, optionally after a short ode
+	transient of length lsq_seed_t. Fall back to integrating
+	the odes if the steady state solve does not converge.
+      */
+      if (state->lsq_seed_t > 0.0) {
+	ode_t_final = state->ode_t_final;
+	state->ode_t_final = state->lsq_seed_t;
+	success = ode_solver(state,concs,solver_choice);
+	state->ode_t_final = ode_t_final;
+      }
+      if (success) {
+	success = lsq_steady_state(state,concs);
+	if (success) {
+	  if (print_output) {
+	    success = compute_dfdke_dfdmu0(state,concs);
+	  }
+	} else {
+	  if (lfp) {
+	    fprintf(lfp,"deq_run: lsq_steady_state did not converge, "
+		    "integrating the odes instead\n");
+	    fflush(lfp);
+	  }
+	  success = ode_solver(state,concs,solver_choice);
+	}
       }
+    } else {
+      success = ode_solver(state,concs,solver_choice);
     }
-    success = ode_solver(state,concs,solver_choice);
   }
   /*
   j = 1;
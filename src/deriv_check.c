@@ -0,0 +1 @@
+tools/deriv_check.c
\ No newline at end of file
@@ -70,6 +70,9 @@ int echo_params (FILE *lfp, struct state_struct *state) {
     fprintf(lfp,"state->net_lklhd_file         = %s\n",state->net_lklhd_file);
     fprintf(lfp,"state->ode_sens_file          = %s\n",state->ode_sens_file);
     fprintf(lfp,"state->ode_dsens_file         = %s\n",state->ode_dsens_file);
+    fprintf(lfp,"state->ode_adj_target_file    = %s\n",state->ode_adj_target_file);
+    fprintf(lfp,"state->codegen_dir            = %s\n",state->codegen_dir);
+    fprintf(lfp,"state->codegen_cc             = %s\n",state->codegen_cc);
     fprintf(lfp,"state->dfdke_file             = %s\n",state->dfdke_file);
     fprintf(lfp,"state->dfdmu0_file            = %s\n",state->dfdmu0_file);
     fprintf(lfp,"state->nl_bndry_flx_file      = %s\n",state->nl_bndry_flx_file);
@@ -96,6 +99,19 @@ int echo_params (FILE *lfp, struct state_struct *state) {
     fprintf(lfp,"state->use_bulk_water         = %ld\n",state->use_bulk_water);
     fprintf(lfp,"state->use_activities         = %ld\n",state->use_activities);
     fprintf(lfp,"state->use_deq                = %ld\n",state->use_deq);
+    fprintf(lfp,"state->use_lsqnonlin          = %ld\n",state->use_lsqnonlin);
+    fprintf(lfp,"state->lsq_max_iters          = %ld\n",state->lsq_max_iters);
+    fprintf(lfp,"state->reduce_moieties        = %ld\n",state->reduce_moieties);
+    fprintf(lfp,"state->ode_dense_output       = %ld\n",state->ode_dense_output);
+    fprintf(lfp,"state->stable_add_choice      = %ld\n",state->stable_add_choice);
+    fprintf(lfp,"state->ode_auto_probe_steps   = %ld\n",state->ode_auto_probe_steps);
+    fprintf(lfp,"state->codegen                = %ld\n",state->codegen);
+    fprintf(lfp,"state->hybrid                 = %ld\n",state->hybrid);
+    fprintf(lfp,"state->hybrid_repartition_steps = %ld\n",state->hybrid_repartition_steps);
+    fprintf(lfp,"state->num_threads            = %ld\n",state->num_threads);
+    fprintf(lfp,"state->num_agents             = %ld\n",state->num_agents);
+    fprintf(lfp,"state->num_workers            = %ld\n",state->num_workers);
+    fprintf(lfp,"state->agent_data_compact     = %ld\n",state->agent_data_compact);
     fprintf(lfp,"state->use_pseudoisomers      = %ld\n",state->use_pseudoisomers);
     fprintf(lfp,"state->use_metropolis         = %ld\n",state->use_metropolis);
     fprintf(lfp,"state->use_regulation         = %ld\n",state->use_regulation);
@@ -136,14 +152,22 @@ int echo_params (FILE *lfp, struct state_struct *state) {
 	    cvodes_params->maxcor);
     fprintf(lfp,"cvodes_params->maxncf                  = %d\n",
 	    cvodes_params->maxncf);
+    fprintf(lfp,"cvodes_params->root_direction          = %d\n",
+	    cvodes_params->root_direction);
     fprintf(lfp,"cvodes_params->maxl                    = %d\n",
 	    cvodes_params->maxl);
     fprintf(lfp,"cvodes_params->pretype                 = %d\n",
 	    cvodes_params->pretype);
+    fprintf(lfp,"cvodes_params->sparse_matrix_ordering_alg = %d\n",
+	    cvodes_params->sparse_matrix_ordering_alg);
     fprintf(lfp,"cvodes_params->gstype                  = %d\n",
 	    cvodes_params->gstype);
     fprintf(lfp,"cvodes_params->num_cvode_steps         = %d\n",
 	    cvodes_params->num_cvode_steps);
+    fprintf(lfp,"cvodes_params->sens_rhs_choice         = %d\n",
+	    cvodes_params->sens_rhs_choice);
+    fprintf(lfp,"cvodes_params->reuse_context           = %d\n",
+	    cvodes_params->reuse_context);
     fprintf(lfp,"cvodes_params->reltol                  = %le\n",
 	    cvodes_params->reltol);
     fprintf(lfp,"cvodes_params->abstol                  = %le\n",
@@ -167,6 +191,13 @@ int echo_params (FILE *lfp, struct state_struct *state) {
     fprintf(lfp,"state->flux_scaling           = %le\n",state->flux_scaling);
     fprintf(lfp,"state->kf_base_reaction       = %le\n",state->kf_base_reaction);
     fprintf(lfp,"state->ode_t_final            = %le\n",state->ode_t_final);
+    fprintf(lfp,"state->lsq_ftol               = %le\n",state->lsq_ftol);
+    fprintf(lfp,"state->lsq_seed_t             = %le\n",state->lsq_seed_t);
+    fprintf(lfp,"state->ode_dense_log_t0       = %le\n",state->ode_dense_log_t0);
+    fprintf(lfp,"state->ode_auto_probe_t       = %le\n",state->ode_auto_probe_t);
+    fprintf(lfp,"state->hybrid_count_threshold = %le\n",state->hybrid_count_threshold);
+    fprintf(lfp,"state->hybrid_rate_threshold  = %le\n",state->hybrid_rate_threshold);
+    fprintf(lfp,"state->hybrid_max_dt          = %le\n",state->hybrid_max_dt);
     fprintf(lfp,"state->min_conc               = %le\n",state->min_conc);
     
     
@@ -0,0 +1,465 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_cvodes_headers.h"
+#include "cvodes_params_struct.h"
+#include "init_base_reactants.h"
+#include "init_relative_rates.h"
+#include "init_rxn_terms.h"
+#include "codegen_init.h"
+#include "ode_solver_autotune.h"
+#include "gradient.h"
+#include "ode_solver.h"
+#include "choose_rxn.h"
+#include "vgrng.h"
+#include "get_counts.h"
+#include "boltzmann_cvodes_free.h"
+
+#include "hybrid_run.h"
+int hybrid_run(struct state_struct *state) {
+  /*
+    HYBRID 1: advance the counts from t = 0 to ode_t_final with the
+    reactions partitioned into fast reactions, integrated as odes,
+    and slow reactions, fired one at a time by choose_rxn.
+
+    A reaction is fast when its firing rate
+      (forward + reverse likelihood) * activity * conc_to_count
+    (firings per unit time, from the ode gradient likelihoods) is at
+    least hybrid_rate_threshold and every variable species it uses
+    has a count of at least hybrid_count_threshold, otherwise it is
+    slow, a fast reaction stays fast down to half the thresholds.
+    The partition is redone every hybrid_repartition_steps intervals
+    and changes are logged.
+
+    Each interval draws the waiting time to the next slow firing,
+    tau = -log(u)/a0 with a0 the sum of the slow firing rates, from
+    the vgrng2 generator. The fast reactions are integrated by
+    ode_solver, with the activities (and enzyme levels, for regulation)
+    of the slow reactions set to 0, for min(tau, hybrid_max_dt, time
+    left). If tau was reached a slow reaction is then chosen by
+    choose_rxn, with the forward and reverse likelihoods of the fast
+    reactions set to 0 and the slow ones set to their firing rates, so
+    the choice is proportional to the rates. The Metropolis step is
+    turned off for these choices. Otherwise no slow reaction fires
+    and a new waiting time is drawn with the updated rates, which
+    bounds how far the slow rates lag the fast species.
+
+    The ode segments are run with output, dense output and
+    sensitivities off, and cvodes keeps its context between segments
+    (reuse_context). As in deq_run the counts are rounded at the end
+    unless no_round_from_deq is set.
+    The likelihoods are those of the ode gradient, so
+    DELTA_CONCS_CHOICE 7, which does not form them, is not supported.
+
+    Called by: boltzmann_run
+    Calls:     init_base_reactants,
+               init_relative_rates,
+	       init_rxn_terms,
+	       codegen_init,
+	       ode_solver_autotune,
+	       gradient,
+	       ode_solver,
+	       choose_rxn,
+	       vgrng,
+	       get_counts,
+	       boltzmann_cvodes_free,
+	       log, calloc, free, fprintf, fflush
+  */
+  struct molecule_struct *molecules;
+  struct molecule_struct *molecule;
+  struct reactions_matrix_struct *rxns_matrix;
+  struct cvodes_params_struct *cvodes_params;
+  double *concs;
+  double *counts;
+  double *future_counts;
+  double *conc_to_count;
+  double *count_to_conc;
+  double *activities;
+  double *enzyme_level;
+  double *ode_forward_lklhds;
+  double *ode_reverse_lklhds;
+  double *forward_rxn_likelihood;
+  double *reverse_rxn_likelihood;
+  double *dg0s;
+  double *free_energy;
+  double *rcoef;
+  double *flux;
+  double *saved_activities;
+  double *saved_enzyme_level;
+  double t;
+  double t_final;
+  double dt;
+  double tau;
+  double u;
+  double a0;
+  double rate;
+  double scale;
+  double max_dt;
+  double rate_threshold;
+  double count_threshold;
+  double r_sum_likelihood;
+  int64_t *rxn_ptrs;
+  int64_t *molecules_indices;
+  int64_t one_l;
+  int64_t ask_for;
+  int64_t print_output;
+  int64_t ode_rxn_view_freq;
+  int64_t ode_dense_output;
+  int64_t compute_sensitivities;
+  int64_t use_metropolis;
+  int64_t repartition_steps;
+  int64_t step;
+  int64_t num_segments;
+  int64_t num_firings;
+  int64_t j;
+  int     *fast;
+  int     *rxn_species;
+
+  int success;
+  int num_rxns;
+
+  int ny;
+  int i;
+
+  int mi;
+  int num_fast;
+
+  int old_num_fast;
+  int fire;
+
+  int rxn_choice;
+  int solver_choice;
+
+  int gradient_choice;
+  int reuse_context;
+
+  FILE *lfp;
+  FILE *efp;
+  success         = 1;
+  one_l           = (int64_t)1;
+  lfp             = state->lfp;
+  num_rxns        = (int)state->number_reactions;
+  ny              = (int)state->nunique_molecules;
+  molecules       = state->sorted_molecules;
+  rxns_matrix     = state->reactions_matrix;
+  rxn_ptrs        = rxns_matrix->rxn_ptrs;
+  molecules_indices = rxns_matrix->molecules_indices;
+  rcoef           = rxns_matrix->coefficients;
+  concs           = state->ode_concs;
+  counts          = state->current_counts;
+  future_counts   = state->future_counts;
+  conc_to_count   = state->conc_to_count;
+  count_to_conc   = state->count_to_conc;
+  activities      = state->activities;
+  enzyme_level    = state->enzyme_level;
+  ode_forward_lklhds     = state->ode_forward_lklhds;
+  ode_reverse_lklhds     = state->ode_reverse_lklhds;
+  forward_rxn_likelihood = state->forward_rxn_likelihood;
+  reverse_rxn_likelihood = state->reverse_rxn_likelihood;
+  cvodes_params   = state->cvodes_params;
+  gradient_choice = (int)state->gradient_choice;
+  solver_choice   = (int)state->ode_solver_choice;
+  flux            = NULL;
+  fast            = NULL;
+  if (gradient_choice == 7) {
+    success = 0;
+    if (lfp) {
+      fprintf(lfp,"hybrid_run: Error HYBRID needs the reaction likelihoods "
+	      "of the ode gradient, not available with DELTA_CONCS_CHOICE 7\n");
+      fflush(lfp);
+    }
+  }
+  /*
+    flux, saved_activities and saved_enzyme_level,
+    then fast and rxn_species.
+  */
+  if (success) {
+    ask_for = ((int64_t)(ny + num_rxns + num_rxns)) * ((int64_t)sizeof(double));
+    flux    = (double *)calloc(one_l,ask_for);
+    if (flux) {
+      ask_for = ((int64_t)(num_rxns + num_rxns)) * ((int64_t)sizeof(int));
+      fast    = (int *)calloc(one_l,ask_for);
+    }
+    if ((flux == NULL) || (fast == NULL)) {
+      success = 0;
+      if (lfp) {
+	fprintf(lfp,"hybrid_run: Error unable to allocate %ld bytes for "
+		"work space\n",ask_for);
+	fflush(lfp);
+      }
+    }
+  }
+  if (success) {
+    saved_activities   = &flux[ny];
+    saved_enzyme_level = &saved_activities[num_rxns];
+    rxn_species        = &fast[num_rxns];
+    dg0s        = state->dg0s;
+    free_energy = state->free_energy;
+    for (i=0;i<num_rxns;i++) {
+      free_energy[i] = dg0s[i];
+    }
+    success = init_base_reactants(state);
+  }
+  if (success) {
+    if (gradient_choice == 6) {
+      success = init_relative_rates(state);
+    }
+  }
+  if (success) {
+    if ((gradient_choice == 15) || (gradient_choice == 16)) {
+      success = init_rxn_terms(state);
+    }
+  }
+  if (success) {
+    for (i=0;i<ny;i++) {
+      concs[i] = counts[i] * count_to_conc[i];
+    }
+    success = codegen_init(state);
+  }
+  if (success && (solver_choice < 0)) {
+    success = ode_solver_autotune(state,concs);
+    solver_choice = (int)state->ode_solver_choice;
+  }
+  if (success) {
+    if (state->reduce_moieties && lfp) {
+      fprintf(lfp,"hybrid_run: REDUCE_MOIETIES is not used with HYBRID, "
+	      "ignored\n");
+      fflush(lfp);
+    }
+    /*
+      The species whose conc_to_count converts a reaction's rate in
+      concentration per unit time to firings per unit time, its first
+      variable species.
+    */
+    for (i=0;i<num_rxns;i++) {
+      rxn_species[i] = (int)molecules_indices[rxn_ptrs[i]];
+      for (j=rxn_ptrs[i];j<rxn_ptrs[i+1];j++) {
+	mi       = (int)molecules_indices[j];
+	molecule = (struct molecule_struct *)&molecules[mi];
+	if (molecule->variable && (rcoef[j] != 0.0)) {
+	  rxn_species[i] = mi;
+	  break;
+	}
+      }
+    }
+    /*
+      Save the settings the ode segments and slow choices change.
+    */
+    t_final               = state->ode_t_final;
+    print_output          = state->print_output;
+    ode_rxn_view_freq     = state->ode_rxn_view_freq;
+    ode_dense_output      = state->ode_dense_output;
+    compute_sensitivities = state->compute_sensitivities;
+    use_metropolis        = state->use_metropolis;
+    reuse_context         = cvodes_params->reuse_context;
+    max_dt                = state->hybrid_max_dt;
+    if (max_dt <= 0.0) {
+      max_dt = t_final * 0.01;
+    }
+    rate_threshold        = state->hybrid_rate_threshold;
+    if (rate_threshold <= 0.0) {
+      rate_threshold = 10.0/max_dt;
+    }
+    count_threshold       = state->hybrid_count_threshold;
+    repartition_steps     = state->hybrid_repartition_steps;
+    if (lfp) {
+      fprintf(lfp,"hybrid_run: t_final = %le, max_dt = %le, rate threshold "
+	      "= %le, count threshold = %le, repartition every %ld steps\n",
+	      t_final,max_dt,rate_threshold,count_threshold,repartition_steps);
+      fflush(lfp);
+    }
+    state->print_output          = (int64_t)0;
+    state->ode_dense_output      = (int64_t)0;
+    state->ode_rxn_view_freq     = (int64_t)0;
+    state->compute_sensitivities = (int64_t)0;
+    state->use_metropolis        = (int64_t)0;
+    cvodes_params->reuse_context = 1;
+    t            = 0.0;
+    step         = (int64_t)0;
+    num_segments = (int64_t)0;
+    num_firings  = (int64_t)0;
+    num_fast     = 0;
+    old_num_fast = -1;
+    while (success && (t < t_final)) {
+      /*
+	The likelihoods and regulated activities at the current concs.
+      */
+      success = gradient(state,concs,flux,gradient_choice);
+      if (success == 0) {
+	break;
+      }
+      if ((step % repartition_steps) == 0) {
+	/*
+	  A fast reaction stays fast until it falls below half the
+	  thresholds, so reactions near a threshold do not switch
+	  at every partition.
+	*/
+	num_fast = 0;
+	for (i=0;i<num_rxns;i++) {
+	  scale = 1.0;
+	  if (fast[i]) {
+	    scale = 0.5;
+	  }
+	  rate = (ode_forward_lklhds[i] + ode_reverse_lklhds[i]) *
+	    activities[i] * conc_to_count[rxn_species[i]];
+	  fast[i] = (rate >= (scale * rate_threshold));
+	  for (j=rxn_ptrs[i];((j<rxn_ptrs[i+1]) && fast[i]);j++) {
+	    mi       = (int)molecules_indices[j];
+	    molecule = (struct molecule_struct *)&molecules[mi];
+	    if (molecule->variable && (rcoef[j] != 0.0) &&
+		((concs[mi] * conc_to_count[mi]) < (scale * count_threshold))) {
+	      fast[i] = 0;
+	    }
+	  }
+	  num_fast += fast[i];
+	}
+	if ((num_fast != old_num_fast) && lfp) {
+	  fprintf(lfp,"hybrid_run: t = %le, %d fast and %d slow reactions\n",
+		  t,num_fast,num_rxns-num_fast);
+	  fflush(lfp);
+	}
+	old_num_fast = num_fast;
+      }
+      a0 = 0.0;
+      for (i=0;i<num_rxns;i++) {
+	if (fast[i] == 0) {
+	  rate = (ode_forward_lklhds[i] + ode_reverse_lklhds[i]) *
+	    activities[i] * conc_to_count[rxn_species[i]];
+	  if (rate > 0.0) {
+	    a0 += rate;
+	  }
+	}
+      }
+      dt = t_final - t;
+      if (dt > max_dt) {
+	dt = max_dt;
+      }
+      fire = 0;
+      if (a0 > 0.0) {
+	/*
+	  u in (0,1].
+	*/
+	u   = (((double)vgrng(state->vgrng2_state)) + 1.0) *
+	  state->vgrng2_state->uni_multiplier;
+	if (u > 1.0) {
+	  u = 1.0;
+	}
+	tau = (0.0 - log(u))/a0;
+	if (tau < dt) {
+	  dt   = tau;
+	  fire = 1;
+	}
+      }
+      if ((num_fast > 0) && (dt > 0.0)) {
+	/*
+	  Integrate the fast reactions only.
+	*/
+	for (i=0;i<num_rxns;i++) {
+	  saved_activities[i]   = activities[i];
+	  saved_enzyme_level[i] = enzyme_level[i];
+	  if (fast[i] == 0) {
+	    activities[i]   = 0.0;
+	    enzyme_level[i] = 0.0;
+	  }
+	}
+	state->ode_t_final = dt;
+	success = ode_solver(state,concs,solver_choice);
+	for (i=0;i<num_rxns;i++) {
+	  activities[i]   = saved_activities[i];
+	  enzyme_level[i] = saved_enzyme_level[i];
+	}
+	num_segments += 1;
+	if (success == 0) {
+	  if (lfp) {
+	    fprintf(lfp,"hybrid_run: Error ode_solver failed on the interval "
+		    "[%le, %le]\n",t,t+dt);
+	    fflush(lfp);
+	  }
+	  break;
+	}
+	success = gradient(state,concs,flux,gradient_choice);
+      }
+      t += dt;
+      if (success && fire) {
+	/*
+	  Fire a slow reaction, chosen by choose_rxn in proportion
+	  to the firing rates at the end of the interval.
+	*/
+	a0 = 0.0;
+	for (i=0;i<num_rxns;i++) {
+	  if (fast[i]) {
+	    forward_rxn_likelihood[i] = 0.0;
+	    reverse_rxn_likelihood[i] = 0.0;
+	  } else {
+	    /*
+	      A likelihood can be slightly negative after an ode segment
+	      overshoots a species to below 0.
+	    */
+	    forward_rxn_likelihood[i] = ode_forward_lklhds[i] *
+	      conc_to_count[rxn_species[i]];
+	    if (forward_rxn_likelihood[i] < 0.0) {
+	      forward_rxn_likelihood[i] = 0.0;
+	    }
+	    reverse_rxn_likelihood[i] = ode_reverse_lklhds[i] *
+	      conc_to_count[rxn_species[i]];
+	    if (reverse_rxn_likelihood[i] < 0.0) {
+	      reverse_rxn_likelihood[i] = 0.0;
+	    }
+	    if (activities[i] > 0.0) {
+	      a0 += (forward_rxn_likelihood[i] + reverse_rxn_likelihood[i]) *
+		activities[i];
+	    }
+	  }
+	}
+	if (a0 > 0.0) {
+	  get_counts(ny,concs,conc_to_count,counts);
+	  rxn_choice = choose_rxn(state,&r_sum_likelihood);
+	  i = rxn_choice;
+	  if (i >= num_rxns) {
+	    i = i - num_rxns;
+	  }
+	  if ((rxn_choice >= 0) && (i < num_rxns) && (fast[i] == 0)) {
+	    for (mi=0;mi<ny;mi++) {
+	      counts[mi] = future_counts[mi];
+	      concs[mi]  = counts[mi] * count_to_conc[mi];
+	    }
+	    num_firings += 1;
+	  }
+	}
+      }
+      step += 1;
+    } /* end while (success ...) */
+    /*
+      Restore the settings.
+    */
+    state->ode_t_final           = t_final;
+    state->print_output          = print_output;
+    state->ode_rxn_view_freq     = ode_rxn_view_freq;
+    state->ode_dense_output      = ode_dense_output;
+    state->compute_sensitivities = compute_sensitivities;
+    state->use_metropolis        = use_metropolis;
+    cvodes_params->reuse_context = reuse_context;
+    if (solver_choice == 1) {
+      boltzmann_cvodes_free(state);
+    }
+    if (lfp) {
+      fprintf(lfp,"hybrid_run: t = %le after %ld steps, %ld ode segments, "
+	      "%ld slow reactions fired\n",t,step,num_segments,num_firings);
+      fflush(lfp);
+    }
+    /*
+      Convert concs to counts, rounded unless no_round_from_deq is set.
+    */
+    get_counts(ny,concs,conc_to_count,counts);
+    if (state->no_round_from_deq == (int64_t)0) {
+      for (i=0;i<ny;i++) {
+	counts[i] = (double)((int64_t)(counts[i] + 0.5));
+      }
+    }
+  }
+  if (fast) {
+    free(fast);
+  }
+  if (flux) {
+    free(flux);
+  }
+  return(success);
+}
@@ -0,0 +1,4 @@
+#ifndef _HYBRID_RUN_H_
+#define _HYBRID_RUN_H_ 1
+extern int hybrid_run(struct state_struct *state);
+#endif
@@ -0,0 +1,235 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_cvodes_headers.h"
+#include "cvodes_params_struct.h"
+#include "iluk.h"
+int iluk(struct state_struct *state) {
+  /*
+    Compute a level of fill ILU(k) preconditioner of the newton iteration
+    matrix M stored in miter_m, miter_im, miter_jm with sorted column
+    indices. The fill level k is the prec_fill field of cvodes_params.
+    Entries of M have level 0, and a fill entry created in row i when
+    eliminating with row k has level lev(i,k) + lev(k,j) + 1;
+    only entries of level <= k are kept. Unlike iluvf the kept pattern
+    depends only on the structure of M, not on the magnitudes.
+    L is unit lower triangular with the diagonal not stored, U is strictly
+    upper triangular with the reciprocals of its diagonal in recip_diag_u,
+    and the levels of the U entries are kept in prec_ulev.
+    The row being factored is held in prec_row with its column indices
+    in an ordered linked list (lindex) and their levels in uindex.
+    Called by: precondition_newton_matrix
+    Calls:     fprintf, fflush
+  */
+  struct cvodes_params_struct *cvodes_params;
+  double *miter;
+  double *l;             
+  double *u;
+  double *recip_diag_u;
+  double *prec_row;
+  double multiplier;
+  int    *im;
+  int    *jm;
+  int    *il;
+  int    *jl;
+  int    *iu;
+  int    *ju;
+  int    *ulev;
+  int    *next;
+  int    *lev;
+  int    *column_mask;
+
+  int lpos;
+  int upos;
+
+  int i;
+  int j;
+
+  int k;
+  int m;
+
+  int prev;
+  int first;
+
+  int levk;
+  int newlev;
+
+  int nnzl;
+  int nnzu;
+
+  int ny;
+  int fill;
+
+  int success;
+  int padi;
+
+  FILE *lfp;
+  FILE *efp;
+  success       = 1;
+  lfp           = state->lfp;
+  ny            = state->nunique_molecules;
+  cvodes_params = state->cvodes_params;
+  fill          = cvodes_params->prec_fill;
+  nnzl          = cvodes_params->nnzl;
+  nnzu          = cvodes_params->nnzu;
+  miter         = cvodes_params->miter_m;
+  l             = cvodes_params->prec_l;
+  u             = cvodes_params->prec_u;
+  recip_diag_u  = cvodes_params->recip_diag_u;
+  prec_row      = cvodes_params->prec_row;
+  im            = cvodes_params->miter_im;
+  jm            = cvodes_params->miter_jm;
+  il            = cvodes_params->prec_il;
+  jl            = cvodes_params->prec_jl;
+  iu            = cvodes_params->prec_iu;
+  ju            = cvodes_params->prec_ju;
+  ulev          = cvodes_params->prec_ulev;
+  next          = cvodes_params->lindex;
+  lev           = cvodes_params->uindex;
+  column_mask   = cvodes_params->column_mask;
+  if (fill < 0) {
+    fill = 0;
+  }
+  lpos = 0;
+  upos = 0;
+  for (i=0;i<ny;i++) {
+    il[i] = lpos;
+    iu[i] = upos;
+    /*
+      Load row i of M into prec_row, its columns are sorted so the
+      linked list is built in order, ny terminates the list.
+    */
+    first = ny;
+    prev  = -1;
+    for (k=im[i];k<im[i+1];k++) {
+      j = jm[k];
+      prec_row[j]    = miter[k];
+      lev[j]         = 0;
+      column_mask[j] = 1;
+      if (prev < 0) {
+	first = j;
+      } else {
+	next[prev] = j;
+      }
+      prev = j;
+    }
+    if (prev >= 0) {
+      next[prev] = ny;
+    }
+    /*
+      Make sure the diagonal is present.
+    */
+    if (column_mask[i] == 0) {
+      prec_row[i]    = 0.0;
+      lev[i]         = 0;
+      column_mask[i] = 1;
+      if (first > i) {
+	next[i] = first;
+	first   = i;
+      } else {
+	prev = first;
+	while (next[prev] < i) {
+	  prev = next[prev];
+	}
+	next[i]    = next[prev];
+	next[prev] = i;
+      }
+    }
+    /*
+      Eliminate the subdiagonal entries in increasing column order.
+    */
+    k = first;
+    while (k < i) {
+      multiplier  = prec_row[k] * recip_diag_u[k];
+      prec_row[k] = multiplier;
+      levk        = lev[k];
+      prev        = k;
+      for (m=iu[k];m<iu[k+1];m++) {
+	j = ju[m];
+	newlev = levk + ulev[m] + 1;
+	if (column_mask[j]) {
+	  prec_row[j] -= multiplier * u[m];
+	  if (newlev < lev[j]) {
+	    lev[j] = newlev;
+	  }
+	} else {
+	  if (newlev <= fill) {
+	    /*
+	      Insert fill entry j in the list, U row k is sorted so
+	      the search can continue from the last insertion point.
+	    */
+	    while (next[prev] < j) {
+	      prev = next[prev];
+	    }
+	    next[j]        = next[prev];
+	    next[prev]     = j;
+	    prev           = j;
+	    column_mask[j] = 1;
+	    lev[j]         = newlev;
+	    prec_row[j]    = 0.0 - multiplier * u[m];
+	  }
+	}
+      } /* end for (m...) */
+      k = next[k];
+    } /* end while (k < i) */
+    /*
+      Extract the row into L and U resetting prec_row and column_mask.
+    */
+    k = first;
+    while (k < ny) {
+      if (k < i) {
+	if (lpos >= nnzl) {
+	  success = 0;
+	  if (lfp) {
+	    fprintf(lfp,"iluk too many entries in L, revisit nnzl setting in boltzmann_size_jacobian\n");
+	    fflush(lfp);
+	  }
+	  break;
+	}
+	l[lpos]  = prec_row[k];
+	jl[lpos] = k;
+	lpos += 1;
+      } else if (k == i) {
+	if (prec_row[k] == 0.0) {
+	  success = 0;
+	  if (lfp) {
+	    fprintf(lfp,"iluk zero pivot in row %d\n",i);
+	    fflush(lfp);
+	  }
+	  break;
+	}
+	recip_diag_u[i] = 1.0/prec_row[k];
+      } else {
+	if (upos >= nnzu) {
+	  success = 0;
+	  if (lfp) {
+	    fprintf(lfp,"iluk too many entries in U, revisit nnzu setting in boltzmann_size_jacobian\n");
+	    fflush(lfp);
+	  }
+	  break;
+	}
+	u[upos]    = prec_row[k];
+	ju[upos]   = k;
+	ulev[upos] = lev[k];
+	upos += 1;
+      }
+      prec_row[k]    = 0.0;
+      column_mask[k] = 0;
+      k = next[k];
+    }
+    if (success == 0) {
+      /*
+	Clear the rest of the row.
+      */
+      while (k < ny) {
+	prec_row[k]    = 0.0;
+	column_mask[k] = 0;
+	k = next[k];
+      }
+      break;
+    }
+  } /* end for (i...) */
+  if (success) {
+    il[ny] = lpos;
+    iu[ny] = upos;
+  }
+  return(success);
+}
@@ -0,0 +1,4 @@
+#ifndef _ILUK_H_
+#define _ILUK_H_ 1
+extern int iluk(struct state_struct *state);
+#endif
@@ -169,7 +169,10 @@ int iluvf(struct state_struct *state) {
 	  j = ju[m];
 	  prec_row[j] += multiplier * u[m];
 	} /* end for m */
-	prec_row[k] = multiplier;
+	/*
+	  L entry is the negative of the multiplier.
+	*/
+	prec_row[kk] = 0.0 - multiplier;
       } /* end for k */
     } /* end if (lcount > 0) */
     /*
@@ -179,6 +182,8 @@ int iluvf(struct state_struct *state) {
     */
     recip_di        = 1.0/prec_row[i];
     recip_diag_u[i] = recip_di;
+    prec_row[i]     = 0.0;
+    column_mask[i]  = 0;
     /*
       now we need extract lowers and uppers, and if their count > 
       lmax / umax we need to sort by decreasing magnitude keeping
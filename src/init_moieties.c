@@ -0,0 +1 @@
+ode23tb/init_moieties.c
\ No newline at end of file
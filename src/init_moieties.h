@@ -0,0 +1 @@
+ode23tb/init_moieties.h
\ No newline at end of file
@@ -0,0 +1 @@
+ode23tb/init_rxn_terms.c
\ No newline at end of file
@@ -0,0 +1 @@
+ode23tb/init_rxn_terms.h
\ No newline at end of file
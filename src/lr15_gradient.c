@@ -0,0 +1 @@
+ode23tb/lr15_gradient.c
\ No newline at end of file
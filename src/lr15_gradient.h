@@ -0,0 +1 @@
+ode23tb/lr15_gradient.h
\ No newline at end of file
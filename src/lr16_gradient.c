@@ -0,0 +1 @@
+ode23tb/lr16_gradient.c
\ No newline at end of file
@@ -0,0 +1 @@
+cvodes_interface/lr8_dfdke.c
\ No newline at end of file
@@ -0,0 +1 @@
+cvodes_interface/lr8_dfdke.h
\ No newline at end of file
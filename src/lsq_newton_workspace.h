@@ -0,0 +1 @@
+ode23tb/lsq_newton_workspace.h
\ No newline at end of file
@@ -0,0 +1 @@
+ode23tb/lsq_steady_state.c
\ No newline at end of file
@@ -0,0 +1,163 @@
+#include "boltzmann_structs.h"
+#include "min_degree_order.h"
+int min_degree_order(int n,
+		     int *adj_ptr,
+		     int *adj,
+		     int *perm,
+		     int *mask,
+		     int *deg,
+		     int *mark) {
+  /*
+    Compute a minimum degree ordering of the undirected graph
+    with n vertices whose adjacency lists are in adj[adj_ptr[i]:adj_ptr[i+1]-1]
+    (no self edges). On return perm[new] = old.
+    The elimination graph is kept explicitly, eliminating a vertex
+    makes its remaining neighbors a clique, and the vertex of least current
+    degree (lowest index on ties) is eliminated next. Highly connected
+    cofactor species (ATP, NADH, ...) are thus ordered last and the fill
+    they would otherwise cause is avoided.
+    mask, deg and mark are scratch vectors of length n.
+    Returns 1 on success, 0 if memory for the elimination graph could not
+    be allocated.
+    Called by: order_newton_matrix
+    Calls:     calloc, realloc, free
+  */
+  int **nbrs;
+  int *cap;
+  int *list;
+  int *nlist;
+  int64_t one_l;
+  int64_t ask_for;
+
+  int success;
+  int step;
+
+  int i;
+  int j;
+
+  int k;
+  int p;
+
+  int u;
+  int w;
+
+  int stamp;
+  int mindeg;
+
+  int len;
+  int np;
+
+  int need;
+  int padi;
+
+  success = 1;
+  one_l   = (int64_t)1;
+  ask_for = ((int64_t)n) * ((int64_t)sizeof(int*));
+  nbrs = (int **)calloc(one_l,ask_for);
+  ask_for = ((int64_t)n) * ((int64_t)sizeof(int));
+  cap  = (int *)calloc(one_l,ask_for);
+  if ((nbrs == NULL) || (cap == NULL)) {
+    success = 0;
+  }
+  if (success) {
+    for (i=0;i<n;i++) {
+      mask[i] = 0;
+      mark[i] = 0;
+      len     = adj_ptr[i+1] - adj_ptr[i];
+      deg[i]  = len;
+      cap[i]  = len + 1;
+      ask_for = ((int64_t)cap[i]) * ((int64_t)sizeof(int));
+      nbrs[i] = (int *)calloc(one_l,ask_for);
+      if (nbrs[i] == NULL) {
+	success = 0;
+	break;
+      }
+      for (j=0;j<len;j++) {
+	nbrs[i][j] = adj[adj_ptr[i]+j];
+      }
+    }
+  }
+  stamp = 0;
+  if (success) {
+    for (step=0;step<n;step++) {
+      /*
+	Find the uneliminated vertex of minimum degree.
+      */
+      p      = -1;
+      mindeg = n + 1;
+      for (i=0;i<n;i++) {
+	if (mask[i] == 0) {
+	  if (deg[i] < mindeg) {
+	    mindeg = deg[i];
+	    p      = i;
+	  }
+	}
+      }
+      perm[step] = p;
+      mask[p]    = 1;
+      list       = nbrs[p];
+      np         = deg[p];
+      /*
+	Neighbor lists only hold uneliminated vertices, replace p in
+	the list of each of its neighbors u by the rest of p's neighbors.
+      */
+      for (k=0;k<np;k++) {
+	u     = list[k];
+	stamp += 1;
+	nlist = nbrs[u];
+	len   = 0;
+	for (j=0;j<deg[u];j++) {
+	  w = nlist[j];
+	  if (w != p) {
+	    mark[w] = stamp;
+	    nlist[len] = w;
+	    len += 1;
+	  }
+	}
+	need = len;
+	for (j=0;j<np;j++) {
+	  w = list[j];
+	  if ((w != u) && (mark[w] != stamp)) {
+	    need += 1;
+	  }
+	}
+	if (need > cap[u]) {
+	  cap[u]  = need + need/2 + 1;
+	  ask_for = ((int64_t)cap[u]) * ((int64_t)sizeof(int));
+	  nlist   = (int *)realloc(nlist,ask_for);
+	  if (nlist == NULL) {
+	    success = 0;
+	    break;
+	  }
+	  nbrs[u] = nlist;
+	}
+	for (j=0;j<np;j++) {
+	  w = list[j];
+	  if ((w != u) && (mark[w] != stamp)) {
+	    mark[w] = stamp;
+	    nlist[len] = w;
+	    len += 1;
+	  }
+	}
+	deg[u] = len;
+      } /* end for (k...) */
+      free(list);
+      nbrs[p] = NULL;
+      if (success == 0) {
+	break;
+      }
+    } /* end for (step...) */
+  }
+  if (nbrs != NULL) {
+    for (i=0;i<n;i++) {
+      if (nbrs[i] != NULL) {
+	free(nbrs[i]);
+      }
+    }
+    free(nbrs);
+  }
+  if (cap != NULL) {
+    free(cap);
+  }
+  return(success);
+}
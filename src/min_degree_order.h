@@ -0,0 +1,10 @@
+#ifndef _MIN_DEGREE_ORDER_H_
+#define _MIN_DEGREE_ORDER_H_ 1
+extern int min_degree_order(int n,
+			    int *adj_ptr,
+			    int *adj,
+			    int *perm,
+			    int *mask,
+			    int *deg,
+			    int *mark);
+#endif
@@ -0,0 +1 @@
+ode23tb/moiety_expand.c
\ No newline at end of file
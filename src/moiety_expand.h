@@ -0,0 +1 @@
+ode23tb/moiety_expand.h
\ No newline at end of file
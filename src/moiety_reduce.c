@@ -0,0 +1 @@
+ode23tb/moiety_reduce.c
\ No newline at end of file
@@ -0,0 +1 @@
+ode23tb/moiety_reduce.h
\ No newline at end of file
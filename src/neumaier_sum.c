@@ -0,0 +1,37 @@
+#include "system_includes.h"
+#include "neumaier_sum.h"
+double neumaier_sum(int n, double *v) {
+  /*
+    Return the sum of the n doubles in v using Neumaier's improved
+    Kahan compensated summation: the rounding error of each addition
+    is accumulated in a separate compensation term, choosing the
+    recovery formula by the larger magnitude of the running sum and
+    the addend, and added back at the end.
+    The error bound is 2u|sum| + O(n u^2) sum|v[i]|, independent of n
+    to first order, so it is at least as accurate as the sort and
+    pairwise sum of stable_add, in one O(n) pass with no scratch space
+    and leaving v unchanged.
+    Called by: lr11_gradient, lr12_gradient
+    Calls:     fabs
+  */
+  double sum;
+  double comp;
+  double t;
+  double vi;
+  int i;
+  int padi;
+  sum  = 0.0;
+  comp = 0.0;
+  for (i=0;i<n;i++) {
+    vi = v[i];
+    t  = sum + vi;
+    if (fabs(sum) >= fabs(vi)) {
+      comp += (sum - t) + vi;
+    } else {
+      comp += (vi - t) + sum;
+    }
+    sum = t;
+  }
+  sum += comp;
+  return(sum);
+}
@@ -0,0 +1,4 @@
+#ifndef NEUMAIER_SUM_H_
+#define NEUMAIER_SUM_H_ 1
+extern double neumaier_sum(int n, double *v);
+#endif
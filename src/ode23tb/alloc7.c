@@ -51,7 +51,14 @@ int alloc7(struct state_struct *state) {
       ode_forward_lklhds,
       ode_reverse_lklhds,
       rxn_has_flux,
-      base_reactant_indicator
+      base_reactant_indicator,
+      rxn_term_coefs, rxn_term_flux_coefs, rxn_term_mols, rxn_term_pows
+      (the last four only for gradient_choice 15 and 16)
+      log_conc_to_count, log_concs, log_counts_p1, reg_log_constant
+      (the last four only for gradient_choice 16)
+      link_matrix, moiety_totals, moiety_concs, moiety_flux, moiety_dir,
+      independent_species, dependent_species
+      (the last seven only if reduce_moieties is set)
   */
   double *reactant_term;
   double *product_term;
@@ -72,7 +79,11 @@ int alloc7(struct state_struct *state) {
   double *ode_skq;
   double *ode_skqi;
   double *dfdke_dfdmu0_work;
+  double *rxn_term_coefs;
+  double *log_conc_to_count;
+  double *link_matrix;
   int64_t ask_for;
+  int64_t link_len;
   int64_t one_l;
   int64_t usage;
   int64_t run_workspace_bytes;
@@ -81,8 +92,8 @@ int alloc7(struct state_struct *state) {
   int    *base_reactant_indicator;
   int num_rxns;
   int num_species;
+  int num_terms;
   int success;
-  int padi;
   FILE *lfp;
   FILE *efp;
 
@@ -90,6 +101,7 @@ int alloc7(struct state_struct *state) {
   usage         = state->usage;
   num_species   = (int)state->nunique_molecules;
   num_rxns      = (int)state->number_reactions;
+  num_terms     = (int)state->number_molecules;
   lfp           = state->lfp;
   success       = 1;
   run_workspace_bytes  = state->run_workspace_bytes;
@@ -403,6 +415,87 @@ int alloc7(struct state_struct *state) {
   if (success) {
     state->dfdke_dfdmu0_work = dfdke_dfdmu0_work;
   }
+  /*
+    Flattened reaction terms for the fused lr15_gradient kernel
+    and lr16_gradient: two doubles and two ints per reactions matrix entry.
+  */
+  if (success) {
+    if ((state->gradient_choice == 15) || (state->gradient_choice == 16)) {
+      ask_for = (int64_t)(3*num_terms)*sizeof(double);
+      usage += ask_for;
+      run_workspace_bytes += ask_for;
+      rxn_term_coefs = (double*)calloc(ask_for,one_l);
+      if (rxn_term_coefs == NULL) {
+	success = 0;
+	if (lfp) {
+	  fprintf(lfp,"alloc7: Error could not allocate %ld "
+		  "bytes for rxn_term vectors.\n",ask_for);
+	  fflush(lfp);
+	}
+      } else {
+	state->rxn_term_coefs      = rxn_term_coefs;
+	state->rxn_term_flux_coefs = &rxn_term_coefs[num_terms];
+	state->rxn_term_mols       = (int*)&rxn_term_coefs[num_terms+num_terms];
+	state->rxn_term_pows       = &state->rxn_term_mols[num_terms];
+      }
+    }
+  }
+  /*
+    Per species logs and regulation constant logs for lr16_gradient.
+  */
+  if (success) {
+    if (state->gradient_choice == 16) {
+      ask_for = ((int64_t)(3*num_species) +
+		 (state->max_regs_per_rxn * (int64_t)num_rxns) + one_l) *
+	sizeof(double);
+      usage += ask_for;
+      run_workspace_bytes += ask_for;
+      log_conc_to_count = (double*)calloc(ask_for,one_l);
+      if (log_conc_to_count == NULL) {
+	success = 0;
+	if (lfp) {
+	  fprintf(lfp,"alloc7: Error could not allocate %ld "
+		  "bytes for log space gradient vectors.\n",ask_for);
+	  fflush(lfp);
+	}
+      } else {
+	state->log_conc_to_count = log_conc_to_count;
+	state->log_concs         = &log_conc_to_count[num_species];
+	state->log_counts_p1     = &state->log_concs[num_species];
+	state->reg_log_constant  = &state->log_counts_p1[num_species];
+      }
+    }
+  }
+  /*
+    Conserved moiety reduction vectors, the link matrix has
+    (num_species - rank) * rank <= num_species*num_species/4 entries.
+  */
+  if (success) {
+    if (state->reduce_moieties) {
+      link_len = (((int64_t)num_species * (int64_t)num_species) >> 2) + 1;
+      ask_for  = (link_len + (int64_t)(5*num_species)) * sizeof(double) +
+	(int64_t)(num_species+num_species)*sizeof(int);
+      usage += ask_for;
+      run_workspace_bytes += ask_for;
+      link_matrix = (double*)calloc(ask_for,one_l);
+      if (link_matrix == NULL) {
+	success = 0;
+	if (lfp) {
+	  fprintf(lfp,"alloc7: Error could not allocate %ld "
+		  "bytes for moiety reduction vectors.\n",ask_for);
+	  fflush(lfp);
+	}
+      } else {
+	state->link_matrix         = link_matrix;
+	state->moiety_totals       = &link_matrix[link_len];
+	state->moiety_concs        = &state->moiety_totals[num_species];
+	state->moiety_flux         = &state->moiety_concs[num_species];
+	state->moiety_dir          = &state->moiety_flux[num_species];
+	state->independent_species = (int*)&state->moiety_dir[num_species];
+	state->dependent_species   = &state->independent_species[num_species];
+      }
+    }
+  }
   state->usage = usage;
   state->run_workspace_bytes  = run_workspace_bytes;
 
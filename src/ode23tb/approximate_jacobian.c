@@ -54,7 +54,8 @@ int approximate_jacobian(struct state_struct *state,
      scalar ode_num_jac_first_time, these used for call to ode_num_jac.
 
 
-     Called by: boltzmann_cvodes_jtimes
+     Called by: boltzmann_cvodes_jtimes, boltzmann_cvodes_jtimes_reduced,
+                ode23tb, ode_ros3p
      Calls:
   */
   struct ode23tb_params_struct *ode23tb_params;
@@ -83,9 +84,9 @@ int approximate_jacobian(struct state_struct *state,
     success = lr8_approximate_jacobian(state,concs,delta_concs,t,choice);
     /*
       Now if the ode choice is not cvodes we need to convert
-      dfdy_a, dfdy_ia, dfdy_ja to dfdy for ode23tb.
+      dfdy_a, dfdy_ia, dfdy_ja to dfdy for ode23tb or ode_ros3p.
     */
-    if (ode_solver_choice == 0) {
+    if (ode_solver_choice != 1) {
       dfdy_a  = cvodes_params->dfdy_a;
       dfdy_ia = cvodes_params->dfdy_ia;
       dfdy_ja = cvodes_params->dfdy_ja;
@@ -112,11 +113,11 @@ int approximate_jacobian(struct state_struct *state,
     ode23tb_params->nf = nf;
     ode23tb_params->num_jac_first_time = 0;
     /*
-      Now if the ode choice is not ode23tb we need to 
+      Now if the ode choice is cvodes we need to 
       convert dfdy to dfdy_a, dfdy_ia, dfdy_ja for 
       use by cvodes.
     */
-    if (ode_solver_choice != 0) {
+    if (ode_solver_choice == 1) {
       dfdy_a = cvodes_params->dfdy_a;
       dfdy_ia = cvodes_params->dfdy_ia;
       dfdy_ja = cvodes_params->dfdy_ja;
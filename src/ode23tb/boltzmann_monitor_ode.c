@@ -14,6 +14,8 @@ void boltzmann_monitor_ode(struct state_struct *state,
   /*
     Print out the concentrations, likelihoods, and concentrations derivative
     for and ode step.
+    The concentrations are not printed here with dense output
+    (ode_dense_output > 0), the solvers print them at the output times.
     Called by boltzmann_cvodes, ode23tb
   */
   double *counts;
@@ -36,7 +38,9 @@ void boltzmann_monitor_ode(struct state_struct *state,
   gradient_choice         = state->gradient_choice;
   kq                      = state->ode_kq;
   kqi                     = state->ode_kqi;
-  ode_print_concs(state,time,concs);
+  if (state->ode_dense_output == 0) {
+    ode_print_concs(state,time,concs);
+  }
   get_counts(ny,concs,conc_to_count,counts);
   ierr = update_rxn_likelihoods(state,counts,forward_rxn_likelihoods,
 				reverse_rxn_likelihoods);
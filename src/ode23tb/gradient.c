@@ -15,6 +15,8 @@
 #include "lr12_gradient.h"
 #include "lr13_gradient.h"
 #include "lr14_gradient.h"
+#include "lr15_gradient.h"
+#include "lr16_gradient.h"
 
 #include "gradient.h"
 
@@ -26,6 +28,9 @@ int gradient(struct state_struct *state, double *concs,
     1 for lr1_gradient, based on likelihood ratios.
     2 for lr2_gradient, based on likelihood ratios.
     3 for lr3_gradient, based on likelihood ratios.
+    ...
+    15 for lr15_gradient, fused single pass version of lr8_gradient.
+    16 for lr16_gradient, log space version of lr8_gradient.
 
 
     Called by: ode23tb, num_jac_col, ode_it_solve
@@ -110,6 +115,15 @@ int gradient(struct state_struct *state, double *concs,
   case 14:
     success = lr14_gradient(state,concs,flux,choice);
     break;
+  case 15:
+    /*
+      lr15_gradient applies the deriv_thresh cut itself.
+    */
+    success = lr15_gradient(state,concs,flux,choice);
+    break;
+  case 16:
+    success = lr16_gradient(state,concs,flux,choice);
+    break;
     /*
       Use debugging flavor with kinetic rate constants for coupledenzyme.in
     */
@@ -123,11 +137,13 @@ int gradient(struct state_struct *state, double *concs,
   /*
     Post process the flux vector to zero out fluxes less than deriv_thresh;
   */
-  ny = state->nunique_molecules;
-  deriv_thresh = state->deriv_thresh;
-  for (i=0;i<ny;i++) {
-    if (fabs(flux[i]) < deriv_thresh) {
-      flux[i] = 0.0;
+  if (choice != 15) {
+    ny = state->nunique_molecules;
+    deriv_thresh = state->deriv_thresh;
+    for (i=0;i<ny;i++) {
+      if (fabs(flux[i]) < deriv_thresh) {
+	flux[i] = 0.0;
+      }
     }
   }
   return(success);
@@ -0,0 +1,236 @@
+#include "boltzmann_structs.h"
+#include "init_moieties.h"
+int init_moieties(struct state_struct *state, double *concs) {
+  /*
+    Find the conserved moieties of the reaction network, i.e. the left
+    null space of the stoichiometric matrix N (species by reactions)
+    restricted to the variable species, and split the species into
+    number_independent independent species and nd dependent ones with
+      N(dependent_species[i],:) = 
+         sum_j link_matrix[i*number_independent+j] *
+               N(independent_species[j],:).
+    Then every dependent concentration is an affine function of the
+    independent ones (see moiety_reduce and moiety_expand) and the odes
+    only need to be integrated for the independent species.
+    Fixed concentration species are always dependent with a zero
+    link_matrix row.
+
+    The independent rows are chosen by row by row Gaussian elimination
+    of N with column pivoting, a row that eliminates to zero (relative
+    to its original size) is dependent. The elimination multipliers are
+    carried along in an identity augmented block to give link_matrix.
+    Rows are visited in order of increasing concentration so that the
+    abundant pool species (ATP, NAD, CoA, ...) end up dependent and are
+    not reconstructed by cancellation from larger terms.
+
+    The vectors filled here are allocated in alloc7.
+    Called by: deq_run
+    Calls:     calloc, free, fabs, fprintf, fflush
+  */
+  struct reactions_matrix_struct *reactions_matrix;
+  struct molecule_struct *molecules;
+  double  *workspace;
+  double  *nmat;
+  double  *aug;
+  double  *row;
+  double  *arow;
+  double  *prow;
+  double  *parow;
+  double  *coefficients;
+  double  *link_matrix;
+  int64_t *molecules_indices;
+  int64_t *rxn_ptrs;
+  int     *independent_species;
+  int     *dependent_species;
+  int     *pivot_cols;
+  int     *visited;
+  int64_t ask_for;
+  int64_t one_l;
+  int64_t j;
+  double  tol;
+  double  scale;
+  double  amax;
+  double  mult;
+  double  piv;
+  double  cmin;
+  int ny;
+  int nrxns;
+  int nr;
+  int nd;
+  int num_variable;
+  int num_fixed;
+  int step;
+  int r;
+  int i;
+  int k;
+  int p;
+  int col;
+  int pc;
+  int success;
+  FILE *lfp;
+  FILE *efp;
+
+  success             = 1;
+  one_l               = (int64_t)1;
+  tol                 = 1.0e-9;
+  ny                  = (int)state->nunique_molecules;
+  nrxns               = (int)state->number_reactions;
+  molecules           = state->sorted_molecules;
+  reactions_matrix    = state->reactions_matrix;
+  molecules_indices   = reactions_matrix->molecules_indices;
+  coefficients        = reactions_matrix->coefficients;
+  rxn_ptrs            = reactions_matrix->rxn_ptrs;
+  link_matrix         = state->link_matrix;
+  independent_species = state->independent_species;
+  dependent_species   = state->dependent_species;
+  lfp                 = state->lfp;
+  if (link_matrix == NULL) {
+    success = 0;
+    if (lfp) {
+      fprintf(lfp,"init_moieties: Error moiety vectors not allocated\n");
+      fflush(lfp);
+    }
+  }
+  /*
+    Workspace:
+    doubles:
+      nmat       (ny * nrxns)  species rows of N
+      aug        (ny * ny)     elimination multipliers
+    ints:
+      pivot_cols (ny)
+      visited    (ny)
+  */
+  if (success) {
+    ask_for = ((int64_t)ny * ((int64_t)nrxns + (int64_t)ny) + (int64_t)ny) 
+      * sizeof(double);
+    workspace = (double *)calloc(one_l,ask_for);
+    if (workspace == NULL) {
+      success = 0;
+      if (lfp) {
+	fprintf(lfp,"init_moieties: Error unable to allocate %ld bytes "
+		"for workspace\n",ask_for);
+	fflush(lfp);
+      }
+    }
+  }
+  if (success) {
+    nmat       = workspace;
+    aug        = &nmat[(int64_t)ny * (int64_t)nrxns];
+    pivot_cols = (int *)&aug[(int64_t)ny * (int64_t)ny];
+    visited    = &pivot_cols[ny];
+    num_variable = 0;
+    for (i=0;i<ny;i++) {
+      if (molecules[i].variable == 1) {
+	num_variable += 1;
+      } else {
+	visited[i] = 1;
+      }
+    }
+    num_fixed = ny - num_variable;
+    for (i=0;i<nrxns;i++) {
+      for (j=rxn_ptrs[i];j<rxn_ptrs[i+1];j++) {
+	k = (int)molecules_indices[j];
+	nmat[((int64_t)k * nrxns) + i] += coefficients[j];
+      }
+    }
+    nr = 0;
+    nd = 0;
+    for (step=0;step<num_variable;step++) {
+      /*
+	Next unvisited variable species with the smallest concentration.
+      */
+      r    = -1;
+      cmin = 0.0;
+      for (i=0;i<ny;i++) {
+	if (visited[i] == 0) {
+	  if ((r < 0) || (concs[i] < cmin)) {
+	    r    = i;
+	    cmin = concs[i];
+	  }
+	}
+      }
+      visited[r] = 1;
+      row   = &nmat[(int64_t)r * nrxns];
+      arow  = &aug[(int64_t)r * ny];
+      arow[r] = 1.0;
+      scale = 0.0;
+      for (i=0;i<nrxns;i++) {
+	if (fabs(row[i]) > scale) {
+	  scale = fabs(row[i]);
+	}
+      }
+      /*
+	Eliminate against the pivot rows found so far.
+      */
+      for (p=0;p<nr;p++) {
+	pc   = pivot_cols[p];
+	mult = row[pc];
+	if (mult != 0.0) {
+	  k     = independent_species[p];
+	  prow  = &nmat[(int64_t)k * nrxns];
+	  parow = &aug[(int64_t)k * ny];
+	  for (i=0;i<nrxns;i++) {
+	    row[i] -= mult * prow[i];
+	  }
+	  for (i=0;i<ny;i++) {
+	    arow[i] -= mult * parow[i];
+	  }
+	}
+      }
+      amax = 0.0;
+      col  = 0;
+      for (i=0;i<nrxns;i++) {
+	if (fabs(row[i]) > amax) {
+	  amax = fabs(row[i]);
+	  col  = i;
+	}
+      }
+      if (amax <= (tol * scale) || (scale == 0.0)) {
+	dependent_species[nd] = r;
+	nd += 1;
+      } else {
+	piv = 1.0/row[col];
+	for (i=0;i<nrxns;i++) {
+	  row[i] = row[i] * piv;
+	}
+	for (i=0;i<ny;i++) {
+	  arow[i] = arow[i] * piv;
+	}
+	row[col] = 1.0;
+	independent_species[nr] = r;
+	pivot_cols[nr]          = col;
+	nr += 1;
+      }
+    } /* end for (step...) */
+    /*
+      Link matrix rows of the dependent variable species from their
+      multipliers: N(r,:) + sum_k aug(r,k) N(k,:) = 0.
+    */
+    for (i=0;i<nd;i++) {
+      arow = &aug[(int64_t)dependent_species[i] * ny];
+      for (k=0;k<nr;k++) {
+	link_matrix[(int64_t)i*nr + k] = 0.0 - arow[independent_species[k]];
+      }
+    }
+    /*
+      Fixed species are dependent on nothing.
+    */
+    for (i=0;i<ny;i++) {
+      if (molecules[i].variable != 1) {
+	for (k=0;k<nr;k++) {
+	  link_matrix[(int64_t)nd*nr + k] = 0.0;
+	}
+	dependent_species[nd] = i;
+	nd += 1;
+      }
+    }
+    state->number_independent = (int64_t)nr;
+    if (lfp && state->print_output) {
+      fprintf(lfp,"init_moieties: %d independent species, %d conserved "
+	      "moieties, %d fixed species\n",nr,nd-num_fixed,num_fixed);
+      fflush(lfp);
+    }
+    free(workspace);
+  }
+  return(success);
+}
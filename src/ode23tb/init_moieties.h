@@ -0,0 +1,4 @@
+#ifndef _INIT_MOIETIES_H_
+#define _INIT_MOIETIES_H_ 1
+extern int init_moieties(struct state_struct *state, double *concs);
+#endif
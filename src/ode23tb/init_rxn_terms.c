@@ -0,0 +1,127 @@
+#include "boltzmann_structs.h"
+#include "init_rxn_terms.h"
+int init_rxn_terms(struct state_struct *state) {
+  /*
+    Fill the flattened reaction term vectors used by lr15_gradient
+    from the reactions matrix and the sorted molecules so that the
+    gradient kernel only streams through contiguous int and double
+    vectors:
+      rxn_term_mols[j]       species index of reactions matrix entry j,
+      rxn_term_coefs[j]      signed stoichiometric coefficient,
+      rxn_term_flux_coefs[j] coefficient for variable species, 0 for
+                             fixed concentration species,
+      rxn_term_pows[j]       |coefficient| when it is integral, -1 otherwise
+                             (conc_to_pow is then used).
+    These vectors are allocated in alloc7.
+    For the log space lr16_gradient (gradient_choice 16) also set
+      log_conc_to_count[i]   log(conc_to_count[i]),
+      reg_log_constant[r]    log(reg_constant[r]) for each regulation,
+    returning 0 if a regulation constant is not positive.
+
+    Called by: deq_run
+    Calls:     log, fprintf, fflush
+  */
+  struct reactions_matrix_struct *reactions_matrix; 
+  struct molecule_struct *molecules;
+  struct molecule_struct *molecule;
+  int64_t *molecules_indices;
+  int64_t *rxn_ptrs;
+  double  *coefficients;
+  double  *rxn_term_coefs;
+  double  *rxn_term_flux_coefs;
+  double  *conc_to_count;
+  double  *log_conc_to_count;
+  double  *reg_constant;
+  double  *reg_log_constant;
+  int64_t *reg_species;
+  double  coef;
+  double  abs_coef;
+  int     *rxn_term_mols;
+  int     *rxn_term_pows;
+  int64_t j;
+  int64_t mj;
+  int64_t num_regs;
+  int nrxns;
+  int ny;
+  int num_terms;
+  int success;
+  int int_pow;
+  int i;
+  int padi;
+  FILE *lfp;
+  FILE *efp;
+
+  success             = 1;
+  lfp                 = state->lfp;
+  nrxns               = (int)state->number_reactions;
+  molecules           = state->sorted_molecules;
+  reactions_matrix    = state->reactions_matrix;
+  molecules_indices   = reactions_matrix->molecules_indices;
+  coefficients        = reactions_matrix->coefficients;
+  rxn_ptrs            = reactions_matrix->rxn_ptrs;
+  rxn_term_coefs      = state->rxn_term_coefs;
+  rxn_term_flux_coefs = state->rxn_term_flux_coefs;
+  rxn_term_mols       = state->rxn_term_mols;
+  rxn_term_pows       = state->rxn_term_pows;
+  num_terms           = (int)rxn_ptrs[nrxns];
+  if ((rxn_term_coefs == NULL) || (num_terms > state->number_molecules)) {
+    success = 0;
+    if (lfp) {
+      fprintf(lfp,"init_rxn_terms: Error rxn_term vectors not allocated "
+	      "for %d terms\n",num_terms);
+      fflush(lfp);
+    }
+  }
+  if (success) {
+    for (j=0;j<num_terms;j++) {
+      mj       = molecules_indices[j];
+      coef     = coefficients[j];
+      molecule = (struct molecule_struct *)&molecules[mj];
+      abs_coef = coef;
+      if (coef < 0.0) {
+	abs_coef = 0.0 - coef;
+      }
+      int_pow = (int)abs_coef;
+      if ((double)int_pow != abs_coef) {
+	int_pow = -1;
+      }
+      rxn_term_mols[j]  = (int)mj;
+      rxn_term_coefs[j] = coef;
+      rxn_term_pows[j]  = int_pow;
+      if (molecule->variable == 1) {
+	rxn_term_flux_coefs[j] = coef;
+      } else {
+	rxn_term_flux_coefs[j] = 0.0;
+      }
+    }
+  }
+  if (success && (state->gradient_choice == 16)) {
+    ny                = (int)state->nunique_molecules;
+    conc_to_count     = state->conc_to_count;
+    log_conc_to_count = state->log_conc_to_count;
+    reg_constant      = state->reg_constant;
+    reg_log_constant  = state->reg_log_constant;
+    reg_species       = state->reg_species;
+    num_regs          = state->max_regs_per_rxn * (int64_t)nrxns;
+    for (i=0;i<ny;i++) {
+      log_conc_to_count[i] = log(conc_to_count[i]);
+    }
+    if (state->use_regulation) {
+      for (j=0;j<num_regs;j++) {
+	if (reg_species[j] >= 0) {
+	  if (reg_constant[j] <= 0.0) {
+	    success = 0;
+	    if (lfp) {
+	      fprintf(lfp,"init_rxn_terms: Error non positive regulation "
+		      "constant for regulation %ld\n",j);
+	      fflush(lfp);
+	    }
+	    break;
+	  }
+	  reg_log_constant[j] = log(reg_constant[j]);
+	}
+      }
+    }
+  }
+  return(success);
+}
@@ -0,0 +1,4 @@
+#ifndef _INIT_RXN_TERMS_H_
+#define _INIT_RXN_TERMS_H_ 1
+extern int init_rxn_terms(struct state_struct *state);
+#endif
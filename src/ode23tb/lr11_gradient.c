@@ -5,6 +5,7 @@
 #include "conc_to_pow.h"
 #include "update_regulations.h"
 #include "stable_add.h"
+#include "neumaier_sum.h"
 #include "lr11_gradient.h"
 
 int lr11_gradient(struct state_struct *state, 
@@ -22,7 +23,8 @@ int lr11_gradient(struct state_struct *state,
     Calls:     get_counts,
                conc_to_pow,
                update_regulations,
-	       stable_add
+	       stable_add,
+	       neumaier_sum
 
                                 TMF
     state                       *SI   Boltzmant state structure.
@@ -112,6 +114,7 @@ int lr11_gradient(struct state_struct *state,
   
   int compute_sensitivities;
   int ode_solver_choice;
+  int stable_add_choice;
 
   FILE *lfp;
   FILE *efp;
@@ -149,6 +152,7 @@ int lr11_gradient(struct state_struct *state,
   conc_to_count    = state->conc_to_count;
   use_regulation   = state->use_regulation;
   ode_solver_choice = state->ode_solver_choice;
+  stable_add_choice = (int)state->stable_add_choice;
   kq               = state->ode_kq;
   kqi              = state->ode_kqi;
   skq              = state->ode_skq;
@@ -291,7 +295,11 @@ int lr11_gradient(struct state_struct *state,
 	  Now add the first jj elements of deriv_acc to get fluxi 
 	  in a stable way.
 	*/
-	fluxi   = stable_add(jj,deriv_acc,stable_add_scr);
+	if (stable_add_choice == 1) {
+	  fluxi = neumaier_sum(jj,deriv_acc);
+	} else {
+	  fluxi = stable_add(jj,deriv_acc,stable_add_scr);
+	}
 	flux[i] = flux_scaling * fluxi;
       } else {
 	flux[i] = 0.0;
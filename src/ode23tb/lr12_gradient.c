@@ -5,6 +5,7 @@
 #include "conc_to_pow.h"
 #include "update_regulations.h"
 #include "stable_add.h"
+#include "neumaier_sum.h"
 #include "lr12_gradient.h"
 
 int lr12_gradient(struct state_struct *state, 
@@ -22,6 +23,8 @@ int lr12_gradient(struct state_struct *state,
     Calls:     get_counts,
                conc_to_pow,
                update_regulations,
+	       stable_add,
+	       neumaier_sum
 
                                 TMF
     state                       *SI   Boltzmant state structure.
@@ -113,6 +116,7 @@ int lr12_gradient(struct state_struct *state,
 
   int compute_sensitivities;
   int ode_solver_choice;
+  int stable_add_choice;
 
   FILE *lfp;
   FILE *efp;
@@ -158,6 +162,7 @@ int lr12_gradient(struct state_struct *state,
   skqi             = state->ode_skqi;
   factorial      = 0.0;
   ode_solver_choice = state->ode_solver_choice;
+  stable_add_choice = (int)state->stable_add_choice;
   compute_sensitivities = state->compute_sensitivities;
   if ((ode_solver_choice == 1) && compute_sensitivities) {
     cvodes_params = state->cvodes_params;
@@ -309,7 +314,11 @@ int lr12_gradient(struct state_struct *state,
 	    */
 	  }
 	} /* end for(j...) */
-	fluxi   = stable_add(jj,deriv_acc,stable_add_scr);
+	if (stable_add_choice == 1) {
+	  fluxi = neumaier_sum(jj,deriv_acc);
+	} else {
+	  fluxi = stable_add(jj,deriv_acc,stable_add_scr);
+	}
 	flux[i] = flux_scaling * fluxi;
       } else {
 	flux[i] = 0.0;
@@ -0,0 +1,272 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_cvodes_headers.h"
+#include "cvodes_params_struct.h"
+#include "conc_to_pow.h"
+#include "update_regulations.h"
+#include "lr15_gradient.h"
+
+int lr15_gradient(struct state_struct *state, 
+		  double *concs,
+		  double *flux, 
+		  int choice) {
+  /*
+    Fused version of lr8_gradient.
+    Same thermodynamic formulation for the concentration rate changes
+    using counts to compute tr, tp, pt, rt, but computed in a single
+    pass over the flattened reaction terms (rxn_term_mols, rxn_term_coefs,
+    rxn_term_flux_coefs, rxn_term_pows set by init_rxn_terms):
+    counts are formed on the fly, integral powers are done inline, and
+    each reaction's flux contribution is added into the species fluxes
+    while its terms are still in cache. Reactions are visited in order
+    so each species flux is summed in the same order as lr8_gradient.
+    The deriv_thresh cut is applied here, so gradient does not make
+    another pass.
+    The per reaction diagnostic vectors (rfc, ode_kq, ode_kqi, ode_skq,
+    ode_skqi) are only stored when print_output is set.
+    ode_forward_lklhds and ode_reverse_lklhds are always stored, as
+    hybrid_run partitions the reactions with them.
+    In an OpenMP build with num_threads > 1 the reaction loop is run in
+    parallel storing rfc, and the species fluxes are then gathered
+    in parallel over the molecules_matrix rows instead of scattered,
+    so no two threads update the same flux. The molecules matrix lists
+    a species reactions in increasing order so the sums are the same
+    as in the serial pass.
+
+    Called by: gradient
+    Calls:     update_regulations, conc_to_pow
+
+                                TMF
+    state                       *SI   Boltzmant state structure.
+                                      uses number_reactions,
+				           unique_moleules,
+					   rxn_term_*,
+					   molecules_matrix,
+					   sorted_molecules,
+					   ke, rke, activities,
+					   conc_to_count, deriv_thresh
+					   and lfp,
+
+    concs			D1I   molecule concentrations vector of length 
+                                      nunique_moleucles
+
+    flux                        D1O   vector of length  unique_molecules
+                                      of concentration change per unit time.
+				      Set by this routine.
+
+    choice                      IOI   Not used by this routine.
+
+  */
+  struct  cvodes_params_struct *cvodes_params;
+  struct  molecule_struct *molecules;
+  struct  molecules_matrix_struct *molecules_matrix;
+  double  *activities;
+  double  *forward_lklhd;
+  double  *reverse_lklhd;
+  double  *rfc;
+  double  *ke;
+  double  *rke;
+  double  *conc_to_count;
+  double  *kq;
+  double  *kqi;
+  double  *skq;
+  double  *skqi;
+  double  *rxn_term_coefs;
+  double  *rxn_term_flux_coefs;
+  double  *coefficients;
+  double  pt;
+  double  rt;
+  double  tr;
+  double  tp;
+  double  pow_c;
+  double  pow_cp;
+  double  count_mi;
+  double  count_mi_plus;
+  double  coef;
+  double  abs_coef;
+  double  flklhd;
+  double  rlklhd;
+  double  rfci;
+  double  deriv_thresh;
+  double  factorial;
+  double  fluxi;
+
+  int64_t *rxn_ptrs;
+  int64_t *molecules_ptrs;
+  int64_t *rxn_indices;
+  int     *rxn_term_mols;
+  int     *rxn_term_pows;
+  int num_species;
+  int num_rxns;
+
+  int success;
+  int i;
+
+  int j;
+  int k;
+
+  int mi;
+  int ipow;
+
+  int use_regulation;
+  int count_or_conc;
+
+  int compute_sensitivities;
+  int ode_solver_choice;
+
+  int save_diagnostics;
+  int gather_flux;
+
+  int num_threads;
+  int padi;
+
+  success             = 1;
+  num_rxns            = state->number_reactions;
+  num_species         = state->nunique_molecules;
+  activities          = state->activities;
+  forward_lklhd       = state->ode_forward_lklhds;
+  reverse_lklhd       = state->ode_reverse_lklhds;
+  rxn_ptrs            = state->reactions_matrix->rxn_ptrs;
+  rxn_term_mols       = state->rxn_term_mols;
+  rxn_term_pows       = state->rxn_term_pows;
+  rxn_term_coefs      = state->rxn_term_coefs;
+  rxn_term_flux_coefs = state->rxn_term_flux_coefs;
+  ke                  = state->ke;
+  rke                 = state->rke;
+  rfc                 = state->rfc;
+  conc_to_count       = state->conc_to_count;
+  use_regulation      = state->use_regulation;
+  kq                  = state->ode_kq;
+  kqi                 = state->ode_kqi;
+  skq                 = state->ode_skq;
+  skqi                = state->ode_skqi;
+  deriv_thresh        = state->deriv_thresh;
+  save_diagnostics    = (int)state->print_output;
+  ode_solver_choice   = state->ode_solver_choice;
+  compute_sensitivities = state->compute_sensitivities;
+  factorial           = 0.0;
+  molecules           = state->sorted_molecules;
+  molecules_matrix    = state->molecules_matrix;
+  molecules_ptrs      = molecules_matrix->molecules_ptrs;
+  rxn_indices         = molecules_matrix->reaction_indices;
+  coefficients        = molecules_matrix->coefficients;
+  num_threads         = 1;
+#ifdef _OPENMP
+  num_threads         = (int)state->num_threads;
+#endif
+  gather_flux         = (num_threads > 1);
+  /*
+    If we are using cvodes and computing sensitivites the 
+    call may be made with perturbed equilibrium constants (the sensitivity
+    parameters), so take them from the cvodes_params vector.
+  */
+  if ((ode_solver_choice == 1) && compute_sensitivities) {
+    cvodes_params = state->cvodes_params;
+    ke = cvodes_params->p;
+    rke = cvodes_params->rp;
+    for (i=0;i<num_rxns;i++) {
+      rke[i] = 1.0/ke[i];
+    }
+  }
+  if (use_regulation) {
+    count_or_conc = 0;
+    update_regulations(state,concs,count_or_conc);
+  }
+  if (gather_flux == 0) {
+    for (i=0;i<num_species;i++) {
+      flux[i] = 0.0;
+    }
+  }
+#ifdef _OPENMP
+#pragma omp parallel for if (gather_flux) num_threads(num_threads) schedule(static) private(i,j,k,pt,rt,tr,tp,mi,coef,ipow,count_mi,abs_coef,count_mi_plus,pow_c,pow_cp,flklhd,rlklhd,rfci)
+#endif
+  for (i=0;i<num_rxns;i++) {
+    pt = 1.0;
+    rt = 1.0;
+    tr = 1.0;
+    tp = 1.0;
+    for (j=rxn_ptrs[i];j<rxn_ptrs[i+1];j++) {
+      mi       = rxn_term_mols[j];
+      coef     = rxn_term_coefs[j];
+      ipow     = rxn_term_pows[j];
+      count_mi = concs[mi] * conc_to_count[mi];
+      abs_coef = coef;
+      if (coef < 0.0) {
+	abs_coef = 0.0 - coef;
+      }
+      count_mi_plus = count_mi + abs_coef;
+      if (ipow >= 0) {
+	pow_c  = 1.0;
+	pow_cp = 1.0;
+	for (k=0;k<ipow;k++) {
+	  pow_c  = pow_c * count_mi;
+	  pow_cp = pow_cp * count_mi_plus;
+	}
+      } else {
+	pow_c  = conc_to_pow(count_mi,abs_coef,factorial);
+	pow_cp = conc_to_pow(count_mi_plus,abs_coef,factorial);
+      }
+      if (coef < 0.0) {
+	rt = rt * pow_c;
+	tr = tr * pow_cp;
+      } else {
+	if (coef > 0.0) {
+	  pt = pt * pow_c;
+	  tp = tp * pow_cp;
+	}
+      }
+    } /* end for (j...) */
+    flklhd = ke[i] * (rt/tp);
+    rlklhd = rke[i] * (pt/tr);
+    rfci   = (flklhd - rlklhd) * activities[i];
+    forward_lklhd[i] = flklhd;
+    reverse_lklhd[i] = rlklhd;
+    if (save_diagnostics) {
+      kq[i]            = flklhd;
+      kqi[i]           = rlklhd;
+      skq[i]           = flklhd * activities[i];
+      skqi[i]          = rlklhd * activities[i];
+    }
+    if (gather_flux) {
+      rfc[i] = rfci;
+    } else {
+      if (save_diagnostics) {
+	rfc[i] = rfci;
+      }
+      /*
+	Accumulate this reaction's contribution to the species fluxes,
+	rxn_term_flux_coefs is 0 for fixed species.
+      */
+      for (j=rxn_ptrs[i];j<rxn_ptrs[i+1];j++) {
+	if (rxn_term_flux_coefs[j] != 0.0) {
+	  flux[rxn_term_mols[j]] += rfci * rxn_term_flux_coefs[j];
+	}
+      }
+    }
+  } /* end for (i...) */
+  if (gather_flux) {
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(num_threads) schedule(static) private(i,j,fluxi)
+#endif
+    for (i=0;i<num_species;i++) {
+      fluxi = 0.0;
+      if (molecules[i].variable == 1) {
+	for (j=molecules_ptrs[i];j<molecules_ptrs[i+1];j++) {
+	  if (coefficients[j] != 0.0) {
+	    fluxi += rfc[rxn_indices[j]] * coefficients[j];
+	  }
+	}
+      }
+      if (fabs(fluxi) < deriv_thresh) {
+	fluxi = 0.0;
+      }
+      flux[i] = fluxi;
+    }
+  } else {
+    for (i=0;i<num_species;i++) {
+      if (fabs(flux[i]) < deriv_thresh) {
+	flux[i] = 0.0;
+      }
+    }
+  }
+  return (success);
+}
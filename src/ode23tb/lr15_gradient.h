@@ -0,0 +1,7 @@
+#ifndef _LR15_GRADIENT_H_
+#define _LR15_GRADIENT_H_ 1
+extern int lr15_gradient(struct state_struct *state, 
+			 double *concs,
+			 double *flux, 
+			 int choice);
+#endif
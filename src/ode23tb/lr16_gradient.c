@@ -0,0 +1,335 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_cvodes_headers.h"
+#include "cvodes_params_struct.h"
+#include "lr16_gradient.h"
+
+int lr16_gradient(struct state_struct *state,
+		  double *concs,
+		  double *flux,
+		  int choice) {
+  /*
+    Log space version of lr8_gradient.
+    The thermodynamic products of lr8_gradient
+
+      rt = prod_{reactants} count^|c|, tr = prod_{reactants} (count+|c|)^|c|
+      pt = prod_{products}  count^|c|, tp = prod_{products}  (count+|c|)^|c|
+
+    are formed as sums of |c| * log terms, with log(conc) and
+    log(count+1) taken once per species per call (log(count) is
+    log(conc) + log_conc_to_count), so the likelihoods are
+
+      forward = ke * exp(log(rt) - log(tp)),
+      reverse = rke * exp(log(pt) - log(tr)),
+
+    two exp calls per reaction instead of a conc_to_pow per reaction
+    term. A zero count gives a -inf log and a zero likelihood as in
+    lr8_gradient, and the quotient is formed before the exp so large
+    counts and coefficients do not overflow the products. Only a
+    coefficient other than 1 needs its own log(count+|c|). As in
+    conc_to_pow only the integer part of a coefficient is used as
+    the power.
+    A reaction with a negative count (an overshooting solver step) is
+    done with the repeated products of lr8_gradient.
+    The regulated activities are formed here too, with
+    (c/K)^p = exp(p*(log(c) - log(K))) from the same log concs and
+    the reg_log_constant vector, which is one exp per regulation in
+    place of the two log and two exp of update_regulation.
+    The results agree with lr8_gradient to rounding.
+    The flattened reaction terms (rxn_term_*) and the log vectors are
+    set by init_rxn_terms.
+
+    Called by: gradient
+    Calls:     log, exp, fprintf, fflush
+
+                                TMF
+    state                       *SI   Boltzmant state structure.
+                                      uses number_reactions,
+				           unique_moleules,
+					   rxn_term_*,
+					   log_conc_to_count,
+					   log_concs, log_counts_p1,
+					   reg_*, reg_log_constant,
+					   enzyme_level,
+					   ke, rke, activities,
+					   conc_to_count and lfp,
+
+    concs			D1I   molecule concentrations vector of length
+                                      nunique_moleucles
+
+    flux                        D1O   vector of length  unique_molecules
+                                      of concentration change per unit time.
+				      Set by this routine.
+
+    choice                      IOI   Not used by this routine.
+
+  */
+  struct  cvodes_params_struct *cvodes_params;
+  double  *activities;
+  double  *forward_lklhd;
+  double  *reverse_lklhd;
+  double  *rfc;
+  double  *ke;
+  double  *rke;
+  double  *counts;
+  double  *conc_to_count;
+  double  *log_conc_to_count;
+  double  *log_concs;
+  double  *log_counts_p1;
+  double  *kq;
+  double  *kqi;
+  double  *skq;
+  double  *skqi;
+  double  *rxn_term_coefs;
+  double  *rxn_term_flux_coefs;
+  double  *enzyme_level;
+  double  *reg_log_constant;
+  double  *reg_exponent;
+  double  *reg_drctn;
+  double  log_rt;
+  double  log_tr;
+  double  log_pt;
+  double  log_tp;
+  double  log_c;
+  double  log_cp;
+  double  pt;
+  double  rt;
+  double  tr;
+  double  tp;
+  double  pow_c;
+  double  pow_cp;
+  double  count_mi;
+  double  count_mi_plus;
+  double  coef;
+  double  abs_coef;
+  double  weight;
+  double  flklhd;
+  double  rlklhd;
+  double  rfci;
+  double  activity;
+  double  direction;
+  double  exp_arg;
+  double  ratio;
+
+  int64_t *rxn_ptrs;
+  int64_t *reg_species;
+  int64_t max_regs_per_rxn;
+  int64_t species;
+  int64_t reg_base;
+  int64_t r;
+  int     *rxn_term_mols;
+  int num_species;
+  int num_rxns;
+
+  int success;
+  int i;
+
+  int j;
+  int k;
+
+  int mi;
+  int ipow;
+
+  int use_regulation;
+  int compute_sensitivities;
+
+  int ode_solver_choice;
+  int negative;
+
+  FILE *lfp;
+  FILE *efp;
+
+  success             = 1;
+  lfp                 = state->lfp;
+  num_rxns            = state->number_reactions;
+  num_species         = state->nunique_molecules;
+  activities          = state->activities;
+  forward_lklhd       = state->ode_forward_lklhds;
+  reverse_lklhd       = state->ode_reverse_lklhds;
+  rxn_ptrs            = state->reactions_matrix->rxn_ptrs;
+  rxn_term_mols       = state->rxn_term_mols;
+  rxn_term_coefs      = state->rxn_term_coefs;
+  rxn_term_flux_coefs = state->rxn_term_flux_coefs;
+  log_conc_to_count   = state->log_conc_to_count;
+  log_concs           = state->log_concs;
+  log_counts_p1       = state->log_counts_p1;
+  ke                  = state->ke;
+  rke                 = state->rke;
+  rfc                 = state->rfc;
+  counts              = state->ode_counts;
+  conc_to_count       = state->conc_to_count;
+  use_regulation      = state->use_regulation;
+  kq                  = state->ode_kq;
+  kqi                 = state->ode_kqi;
+  skq                 = state->ode_skq;
+  skqi                = state->ode_skqi;
+  ode_solver_choice   = state->ode_solver_choice;
+  compute_sensitivities = state->compute_sensitivities;
+  /*
+    If we are using cvodes and computing sensitivites the
+    call may be made with perturbed equilibrium constants (the sensitivity
+    parameters), so take them from the cvodes_params vector.
+  */
+  if ((ode_solver_choice == 1) && compute_sensitivities) {
+    cvodes_params = state->cvodes_params;
+    ke = cvodes_params->p;
+    rke = cvodes_params->rp;
+    for (i=0;i<num_rxns;i++) {
+      rke[i] = 1.0/ke[i];
+    }
+  }
+  /*
+    The per species logs, log(0) is -inf.
+  */
+  for (i=0;i<num_species;i++) {
+    count_mi         = concs[i] * conc_to_count[i];
+    counts[i]        = count_mi;
+    log_concs[i]     = log(concs[i]);
+    log_counts_p1[i] = log(count_mi + 1.0);
+  }
+  if (use_regulation) {
+    /*
+      Log space form of update_regulations, with r = (c/K)^p
+        (1-d)K^p + d c^p       (1-d) + d r       (1-d)/r + d
+	----------------   =  -----------   =  -----------
+	   K^p + c^p              1 + r            1/r + 1
+      using the second form for r <= 1 and the third for r > 1.
+    */
+    enzyme_level     = state->enzyme_level;
+    reg_log_constant = state->reg_log_constant;
+    reg_exponent     = state->reg_exponent;
+    reg_drctn        = state->reg_drctn;
+    reg_species      = state->reg_species;
+    max_regs_per_rxn = state->max_regs_per_rxn;
+    for (i=0;((i<num_rxns) && success);i++) {
+      activity = enzyme_level[i];
+      reg_base = max_regs_per_rxn * i;
+      for (r=reg_base;r<reg_base+max_regs_per_rxn;r++) {
+	species = reg_species[r];
+	if (species < 0) break;
+	direction = reg_drctn[r];
+	if (concs[species] < 0.0) {
+	  success = 0;
+	  if (lfp) {
+	    fprintf(lfp,"lr16_gradient: negative conc for reaction %d, "
+		    "regulation %ld, species %ld\n",i,r,species);
+	    fflush(lfp);
+	  }
+	  break;
+	}
+	if (concs[species] > 0.0) {
+	  exp_arg = reg_exponent[r] * (log_concs[species] - reg_log_constant[r]);
+	  if (exp_arg <= 0.0) {
+	    ratio    = exp(exp_arg);
+	    activity *= ((1.0 - direction) + (direction * ratio))/(1.0 + ratio);
+	  } else {
+	    ratio    = exp(0.0 - exp_arg);
+	    activity *= (((1.0 - direction) * ratio) + direction)/(ratio + 1.0);
+	  }
+	} else {
+	  activity *= (1.0 - direction);
+	}
+      } /* end for (r...) */
+      activities[i] = activity;
+    } /* end for (i...) */
+  }
+  if (success) {
+    for (i=0;i<num_species;i++) {
+      flux[i] = 0.0;
+    }
+    for (i=0;i<num_rxns;i++) {
+      log_rt   = 0.0;
+      log_tr   = 0.0;
+      log_pt   = 0.0;
+      log_tp   = 0.0;
+      negative = 0;
+      for (j=rxn_ptrs[i];j<rxn_ptrs[i+1];j++) {
+	mi       = rxn_term_mols[j];
+	coef     = rxn_term_coefs[j];
+	count_mi = counts[mi];
+	if (count_mi < 0.0) {
+	  negative = 1;
+	  break;
+	}
+	abs_coef = coef;
+	if (coef < 0.0) {
+	  abs_coef = 0.0 - coef;
+	}
+	weight = (double)((int64_t)abs_coef);
+	if (weight > 0.0) {
+	  log_c = log_concs[mi] + log_conc_to_count[mi];
+	  if (abs_coef == 1.0) {
+	    log_cp = log_counts_p1[mi];
+	  } else {
+	    log_cp = log(count_mi + abs_coef);
+	  }
+	  if (coef < 0.0) {
+	    log_rt += weight * log_c;
+	    log_tr += weight * log_cp;
+	  } else {
+	    log_pt += weight * log_c;
+	    log_tp += weight * log_cp;
+	  }
+	}
+      } /* end for (j...) */
+      if (negative == 0) {
+	flklhd = ke[i] * exp(log_rt - log_tp);
+	rlklhd = rke[i] * exp(log_pt - log_tr);
+      } else {
+	/*
+	  Repeated products as in lr8_gradient.
+	*/
+	pt = 1.0;
+	rt = 1.0;
+	tr = 1.0;
+	tp = 1.0;
+	for (j=rxn_ptrs[i];j<rxn_ptrs[i+1];j++) {
+	  mi       = rxn_term_mols[j];
+	  coef     = rxn_term_coefs[j];
+	  count_mi = counts[mi];
+	  abs_coef = coef;
+	  if (coef < 0.0) {
+	    abs_coef = 0.0 - coef;
+	  }
+	  ipow          = (int)abs_coef;
+	  count_mi_plus = count_mi + abs_coef;
+	  pow_c         = 1.0;
+	  pow_cp        = 1.0;
+	  for (k=0;k<ipow;k++) {
+	    pow_c  = pow_c * count_mi;
+	    pow_cp = pow_cp * count_mi_plus;
+	  }
+	  if (coef < 0.0) {
+	    rt = rt * pow_c;
+	    tr = tr * pow_cp;
+	  } else {
+	    if (coef > 0.0) {
+	      pt = pt * pow_c;
+	      tp = tp * pow_cp;
+	    }
+	  }
+	} /* end for (j...) */
+	flklhd = ke[i] * (rt/tp);
+	rlklhd = rke[i] * (pt/tr);
+      }
+      rfci             = (flklhd - rlklhd) * activities[i];
+      forward_lklhd[i] = flklhd;
+      reverse_lklhd[i] = rlklhd;
+      kq[i]            = flklhd;
+      kqi[i]           = rlklhd;
+      skq[i]           = flklhd * activities[i];
+      skqi[i]          = rlklhd * activities[i];
+      rfc[i]           = rfci;
+      /*
+	Reactions are visited in order so each species flux is summed
+	in the lr8_gradient order, rxn_term_flux_coefs is 0 for fixed
+	species.
+      */
+      for (j=rxn_ptrs[i];j<rxn_ptrs[i+1];j++) {
+	if (rxn_term_flux_coefs[j] != 0.0) {
+	  flux[rxn_term_mols[j]] += rfci * rxn_term_flux_coefs[j];
+	}
+      }
+    } /* end for (i...) */
+  }
+  return (success);
+}
@@ -0,0 +1,7 @@
+#ifndef _LR16_GRADIENT_H_
+#define _LR16_GRADIENT_H_ 1
+extern int lr16_gradient(struct state_struct *state, 
+			 double *concs,
+			 double *flux, 
+			 int choice);
+#endif
@@ -27,11 +27,24 @@ int lr8_approximate_jacobian(struct state_struct *state,
     as it is a sparse matrix:  ia_dfdy, ja_dfdy, dfdy
     Also might want to make those fields in state instead of passing in
     as arguments.
+    In an OpenMP build with num_threads > 1 the drfc reaction loop and
+    the assembly of the dfdy rows are done in parallel. Each row is
+    formed in a per thread dense row (cvodes_params->thread_rows,
+    thread_masks) into its own segment of dfdy_a, bounded by the
+    sum of the lengths of the reactions of the species, and the rows
+    are then compacted. Each row sums its reaction contributions in the
+    same order as the serial loop, so the jacobian does not depend on
+    the number of threads.
 
 
+    With CODEGEN 1 the drfc reaction loop is the generated
+    state->codegen_drfc kernel from codegen_init, unless the loop is
+    threaded.
+
     Called by: approximate_jacobian
     Calls:     get_counts,
                update_regulations,
+	       state->codegen_drfc (CODEGEN 1),
 	       vec_set_constant,
 	       crs_column_sort_rows
 
@@ -52,6 +65,8 @@ int lr8_approximate_jacobian(struct state_struct *state,
 					   dfdy_jat[<-ny*ny]
 					   dfdy_ia[ny+1]
 					   dfdy_iat[ny+1]
+					   thread_rows[num_threads*ny]
+					   thread_masks[num_threads*ny]
 
     concs			D1I   molecule concentrations vector of length 
                                       nunique_moleucles
@@ -84,6 +99,10 @@ int lr8_approximate_jacobian(struct state_struct *state,
   double  *dfdy_a;
   double  *dfdy_at;
   double  *dfdy_row;
+#ifdef _OPENMP
+  double  *thread_rows;
+  double  *t_row;
+#endif
   double  *recip_coeffs;
   double  flux_scaling;
   double  pt;
@@ -120,6 +139,13 @@ int lr8_approximate_jacobian(struct state_struct *state,
   int     *dfdy_jat;
   int     *dfdy_iat;
   int     *column_mask;
+  void    (*codegen_drfc)(double *counts, double *concs,
+			  double *count_to_conc, double *ke, double *rke,
+			  double *activities, double *drfc);
+#ifdef _OPENMP
+  int     *thread_masks;
+  int     *t_mask;
+#endif
   int ny;
   int num_rxns;
 
@@ -141,7 +167,14 @@ int lr8_approximate_jacobian(struct state_struct *state,
   int mj;
 
   int ndfdy_pos;
-  int padi;
+#ifdef _OPENMP
+  int num_threads;
+  int row_start;
+  int row_len;
+
+  int tid;
+#endif
+  int num_drfc_rxns;
 
   int ode_solver_choice;
   int compute_sensitivities;
@@ -192,6 +225,14 @@ int lr8_approximate_jacobian(struct state_struct *state,
   dfdy_jat         = cvodes_params->dfdy_jat; 
   dfdy_row         = cvodes_params->prec_row;
   column_mask      = cvodes_params->column_mask;
+#ifdef _OPENMP
+  thread_rows      = cvodes_params->thread_rows;
+  thread_masks     = cvodes_params->thread_masks;
+  num_threads      = (int)state->num_threads;
+  if (thread_rows == NULL) {
+    num_threads = 1;
+  }
+#endif
   if (compute_sensitivities && (ode_solver_choice == 1)) {
     ke = cvodes_params->p;
     rke = cvodes_params->rp;
@@ -236,7 +277,26 @@ int lr8_approximate_jacobian(struct state_struct *state,
 	 reactants the rfc contribution is subtracted, and for products it
 	 is added.
   */
-  for (i=0;i<num_rxns;i++) {
+  /*
+    CODEGEN 1: the generated kernel fills drfc and the loop below is
+    skipped, except in a threaded jacobian.
+  */
+  codegen_drfc = state->codegen_drfc;
+#ifdef _OPENMP
+  if (num_threads > 1) {
+    codegen_drfc = NULL;
+  }
+#endif
+  if (codegen_drfc) {
+    codegen_drfc(counts,concs,count_to_conc,ke,rke,activities,drfc);
+    num_drfc_rxns = 0;
+  } else {
+    num_drfc_rxns = num_rxns;
+  }
+#ifdef _OPENMP
+#pragma omp parallel for if (num_threads > 1) num_threads(num_threads) schedule(static) private(i,j,pt,rt,tr,tp,activityi,mi,coef,count_mi,count_mi_plus,conc_mi,flklhd,rlklhd,molecule)
+#endif
+  for (i=0;i<num_drfc_rxns;i++) {
     pt = 1.0;
     rt = 1.0;
     tr = 1.0;
@@ -322,6 +382,97 @@ int lr8_approximate_jacobian(struct state_struct *state,
       } /* end if (molecule->variable) */
     } /* end for j */
   } /* end for i */
+#ifdef _OPENMP
+  if (num_threads > 1) {
+    /*
+      Segment bounds for the rows: a variable species row has at most
+      the sum of the lengths of its reactions entries (which includes
+      the diagonal) and never more than ny, a fixed species row only
+      has its diagonal. Row i is built in dfdy_a[dfdy_iat[i]:dfdy_iat[i+1]-1]
+      and its length saved in dfdy_ia[i+1].
+    */
+    dfdy_iat[0] = 0;
+    molecule = molecules;
+    for (i=0;i<ny;i++) {
+      row_len = 0;
+      if (molecule->variable == 1) {
+	for (j=molecules_ptrs[i];j<molecules_ptrs[i+1];j++) {
+	  rxn = rxn_indices[j];
+	  row_len += rxn_ptrs[rxn+1] - rxn_ptrs[rxn];
+	}
+      }
+      if (row_len > ny) {
+	row_len = ny;
+      }
+      if (row_len < 1) {
+	row_len = 1;
+      }
+      dfdy_iat[i+1] = dfdy_iat[i] + row_len;
+      molecule += 1; /* Caution address arithmetic here. */
+    }
+#pragma omp parallel for num_threads(num_threads) schedule(dynamic,32) private(i,j,k,rxn,coef,mk,mj,molecule,tid,t_row,t_mask,row_start,dfdy_pos,ndfdy_pos)
+    for (i=0;i<ny;i++) {
+      tid       = omp_get_thread_num();
+      t_row     = &thread_rows[tid * ny];
+      t_mask    = &thread_masks[tid * ny];
+      molecule  = (struct molecule_struct *)&molecules[i];
+      row_start = dfdy_iat[i];
+      t_mask[i] = 1;
+      dfdy_ja[row_start] = i;
+      dfdy_a[row_start]  = 0.0;
+      dfdy_pos  = row_start + 1;
+      ndfdy_pos = dfdy_pos;
+      if (molecule->variable == 1) {
+	for (j=molecules_ptrs[i];j<molecules_ptrs[i+1];j++) {
+	  rxn = rxn_indices[j];
+	  coef = coefficients[j];
+	  if (coef != 0.0) {
+	    for (k=rxn_ptrs[rxn];k<rxn_ptrs[rxn+1];k++) {
+	      mk = molecule_indices[k];
+	      if (t_mask[mk] == 0) {
+		t_mask[mk] = 1;
+		dfdy_ja[dfdy_pos] = mk;
+		dfdy_pos += 1;
+	      }
+	      t_row[mk] += drfc[k] * coef;
+	    }
+	  }
+	}
+	ndfdy_pos = row_start;
+	for (j=row_start;j<dfdy_pos;j++) {
+	  mj = dfdy_ja[j];
+	  if ((mj == i) || (t_row[mj] != 0.0)) {
+	    dfdy_a[ndfdy_pos] = t_row[mj];
+	    dfdy_ja[ndfdy_pos] = mj;
+	    ndfdy_pos += 1;
+	  }
+	  t_row[mj] = 0.0;
+	  t_mask[mj] = 0;
+	}
+      }
+      t_row[i]  = 0.0;
+      t_mask[i] = 0;
+      dfdy_ia[i+1] = ndfdy_pos - row_start;
+    } /* end parallel for (i...) */
+    /*
+      Compact the row segments, rows only move down so copying
+      forward is safe.
+    */
+    dfdy_ia[0] = 0;
+    for (i=0;i<ny;i++) {
+      row_start = dfdy_iat[i];
+      row_len   = dfdy_ia[i+1];
+      dfdy_pos  = dfdy_ia[i];
+      if (dfdy_pos != row_start) {
+	for (j=0;j<row_len;j++) {
+	  dfdy_a[dfdy_pos+j]  = dfdy_a[row_start+j];
+	  dfdy_ja[dfdy_pos+j] = dfdy_ja[row_start+j];
+	}
+      }
+      dfdy_ia[i+1] = dfdy_pos + row_len;
+    }
+  } else {
+#endif
   molecule = molecules;
   dfdy_pos = 0;
   ndfdy_pos = 0;
@@ -338,6 +489,7 @@ int lr8_approximate_jacobian(struct state_struct *state,
     column_mask[i] = 1;
     dfdy_pos = ndfdy_pos;
     dfdy_ja[dfdy_pos] = i;
+    dfdy_a[dfdy_pos]  = 0.0;
     dfdy_pos += 1;
     ndfdy_pos = dfdy_pos;
     if (molecule->variable == 1) {
@@ -398,6 +550,9 @@ int lr8_approximate_jacobian(struct state_struct *state,
     column_mask[i] = 0;
     molecule += 1; /* Caution address arithmetic here. */
   } /* end for (i...) */
+#ifdef _OPENMP
+  } /* end else serial assembly */
+#endif
   /*
     Now we want rows of dfdy in dfdy_a to be sorted by column number,
     This is best accomplished with a double transpose algorithm
@@ -20,6 +20,7 @@ int lr8_gradient(struct state_struct *state,
     Called by: gradient
     Calls:     get_counts,
                update_regulations,
+	       state->codegen_rfc, state->codegen_flux (CODEGEN 1)
 
                                 TMF
     state                       *SI   Boltzmant state structure.
@@ -194,6 +195,21 @@ int lr8_gradient(struct state_struct *state,
 	 reactants the rfc contribution is subtracted, and for products it
 	 is added.
   */
+  if (state->codegen_rfc) {
+    /*
+      CODEGEN 1: network specific kernels from codegen_init.
+    */
+    state->codegen_rfc(counts,ke,rke,activities,forward_lklhd,reverse_lklhd,
+		       rfc);
+    for (i=0;i<num_rxns;i++) {
+      kq[i]   = forward_lklhd[i];
+      skq[i]  = kq[i] * activities[i];
+      kqi[i]  = reverse_lklhd[i];
+      skqi[i] = kqi[i] * activities[i];
+    }
+    state->codegen_flux(rfc,flux);
+    return(success);
+  }
   for (i=0;i<num_rxns;i++) {
     pt = 1.0;
     rt = 1.0;
@@ -0,0 +1,172 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_cvodes_headers.h"
+#include "cvodes_params_struct.h"
+#include "boltzmann_size_jacobian.h"
+#include "order_newton_matrix.h"
+#include "lsq_newton_workspace.h"
+int lsq_newton_workspace(struct state_struct *state,
+			 struct cvodes_params_struct *saved_params,
+			 double **workspace_p) {
+  /*
+    Set up the sparse jacobian and Newton matrix workspace that
+    lr8_approximate_jacobian, build_newton_matrix, sparse_lu_symbolic
+    and sparse_lu_factor keep in cvodes_params, for lsq_steady_state
+    which runs outside of the ode solvers.
+    The cvodes_params struct is first copied to *saved_params, then
+    its nnz bounds are set by boltzmann_size_jacobian, its vectors
+    are pointed into a new workspace returned in *workspace_p and the
+    fill reducing ordering is computed by order_newton_matrix.
+    The caller frees slu_factors and the workspace when done and
+    restores cvodes_params from *saved_params. If the workspace can
+    not be allocated cvodes_params is restored here.
+
+    Called by: lsq_steady_state
+    Calls:     boltzmann_size_jacobian,
+               order_newton_matrix,
+	       calloc, fprintf, fflush
+  */
+  struct cvodes_params_struct *cvodes_params;
+  double *workspace;
+  double *drfc;
+  double *dfdy_a;
+  double *dfdy_at;
+  double *miter_m;
+  double *prec_row;
+  double *recip_diag_u;
+  double *frow;
+  double *srow;
+  int    *dfdy_ia;
+  int    *dfdy_ja;
+  int    *dfdy_iat;
+  int    *dfdy_jat;
+  int    *miter_im;
+  int    *miter_jm;
+  int    *prec_il;
+  int    *prec_iu;
+  int    *lindex;
+  int    *uindex;
+  int    *column_mask;
+  int    *sindex;
+  int    *perm;
+  int    *iperm;
+  int64_t ask_for;
+  int64_t one_l;
+  int ny;
+  int nnz;
+  int nnzm;
+  int drfc_len;
+  int num_doubles;
+  int num_ints;
+  int success;
+  int padi;
+  FILE *lfp;
+  FILE *efp;
+
+  success       = 1;
+  one_l         = (int64_t)1;
+  ny            = (int)state->nunique_molecules;
+  cvodes_params = state->cvodes_params;
+  lfp           = state->lfp;
+  *saved_params = *cvodes_params;
+  *workspace_p  = NULL;
+  /*
+    Workspace:
+    doubles:
+      drfc         (2*number_molecules)
+      dfdy_a       (nnz)
+      dfdy_at      (nnz)
+      miter_m      (nnzm)
+      prec_row     (ny)
+      recip_diag_u (ny)
+      frow         (ny)
+      srow         (ny)
+    ints:
+      dfdy_ia      (ny+1)
+      dfdy_ja      (nnz)
+      dfdy_iat     (ny+1)
+      dfdy_jat     (nnz)
+      miter_im     (ny+1)
+      miter_jm     (nnzm)
+      prec_il      (ny+1)
+      prec_iu      (ny+1)
+      lindex, uindex, column_mask, sindex, perm, iperm (ny each)
+    The L and U factors themselves are allocated by sparse_lu_symbolic
+    in slu_factors.
+  */
+  boltzmann_size_jacobian(state);
+  nnz         = cvodes_params->nnz;
+  nnzm        = cvodes_params->nnzm;
+  drfc_len    = (int)state->number_molecules * 2;
+  num_doubles = drfc_len + nnz + nnz + nnzm + (4*ny);
+  num_ints    = nnz + nnz + nnzm + (11*ny) + 5;
+  num_doubles = num_doubles + (num_ints + (num_ints & 1))/2;
+  ask_for     = ((int64_t)num_doubles) << 3;
+  workspace   = (double *)calloc(one_l,ask_for);
+  if (workspace == NULL) {
+    success = 0;
+    *cvodes_params = *saved_params;
+    if (lfp) {
+      fprintf(lfp,"lsq_newton_workspace: Error unable to allocate %ld bytes "
+	      "for workspace\n",ask_for);
+      fflush(lfp);
+    }
+  }
+  if (success) {
+    drfc         = workspace;
+    dfdy_a       = &drfc[drfc_len];
+    dfdy_at      = &dfdy_a[nnz];
+    miter_m      = &dfdy_at[nnz];
+    prec_row     = &miter_m[nnzm];
+    recip_diag_u = &prec_row[ny];
+    frow         = &recip_diag_u[ny];
+    srow         = &frow[ny];
+    dfdy_ia      = (int *)&srow[ny];
+    dfdy_ja      = &dfdy_ia[ny+1];
+    dfdy_iat     = &dfdy_ja[nnz];
+    dfdy_jat     = &dfdy_iat[ny+1];
+    miter_im     = &dfdy_jat[nnz];
+    miter_jm     = &miter_im[ny+1];
+    prec_il      = &miter_jm[nnzm];
+    prec_iu      = &prec_il[ny+1];
+    lindex       = &prec_iu[ny+1];
+    uindex       = &lindex[ny];
+    column_mask  = &uindex[ny];
+    sindex       = &column_mask[ny];
+    perm         = &sindex[ny];
+    iperm        = &perm[ny];
+
+    cvodes_params->drfc         = drfc;
+    cvodes_params->dfdy_a       = dfdy_a;
+    cvodes_params->dfdy_at      = dfdy_at;
+    cvodes_params->miter_m      = miter_m;
+    cvodes_params->prec_row     = prec_row;
+    cvodes_params->recip_diag_u = recip_diag_u;
+    cvodes_params->frow         = frow;
+    cvodes_params->srow         = srow;
+    cvodes_params->dfdy_ia      = dfdy_ia;
+    cvodes_params->dfdy_ja      = dfdy_ja;
+    cvodes_params->dfdy_iat     = dfdy_iat;
+    cvodes_params->dfdy_jat     = dfdy_jat;
+    cvodes_params->miter_im     = miter_im;
+    cvodes_params->miter_jm     = miter_jm;
+    cvodes_params->prec_il      = prec_il;
+    cvodes_params->prec_iu      = prec_iu;
+    cvodes_params->lindex       = lindex;
+    cvodes_params->uindex       = uindex;
+    cvodes_params->column_mask  = column_mask;
+    cvodes_params->sindex       = sindex;
+    cvodes_params->perm         = perm;
+    cvodes_params->iperm        = iperm;
+    cvodes_params->slu_factors  = NULL;
+    cvodes_params->prec_l       = NULL;
+    cvodes_params->prec_u       = NULL;
+    cvodes_params->prec_jl      = NULL;
+    cvodes_params->prec_ju      = NULL;
+    cvodes_params->thread_rows  = NULL;
+    cvodes_params->thread_masks = NULL;
+
+    success = order_newton_matrix(state);
+    *workspace_p = workspace;
+  }
+  return(success);
+}
@@ -0,0 +1,6 @@
+#ifndef _LSQ_NEWTON_WORKSPACE_H_
+#define _LSQ_NEWTON_WORKSPACE_H_ 1
+extern int lsq_newton_workspace(struct state_struct *state,
+				struct cvodes_params_struct *saved_params,
+				double **workspace_p);
+#endif
@@ -0,0 +1,361 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_cvodes_headers.h"
+#include "cvodes_params_struct.h"
+#include "non_cvode_blas.h"
+#include "gradient.h"
+#include "lr8_approximate_jacobian.h"
+#include "lsq_newton_workspace.h"
+#include "build_newton_matrix.h"
+#include "sparse_lu_symbolic.h"
+#include "sparse_lu_factor.h"
+#include "boltzmann_cvodes_fsolve.h"
+#include "boltzmann_cvodes_bsolve.h"
+#include "lsq_steady_state.h"
+int lsq_steady_state(struct state_struct *state, double *concs) {
+  /*
+    Solve f(concs) = 0 for the steady state concentrations directly,
+    instead of integrating the odes until ode_test_steady_state fires.
+    Enabled by USE_LSQNONLIN.
+
+    Each iteration forms the sparse lr8 jacobian J once and takes
+    the damped Newton (Levenberg-Marquardt style) step
+      (lambda I - J) delta = f,
+    solved as (I - J/lambda) delta = f/lambda with the in-tree sparse
+    LU of the CVODES_SOLVER SLU path (build_newton_matrix,
+    sparse_lu_symbolic, sparse_lu_factor) in the order_newton_matrix
+    ordering, refactoring with a larger lambda if the residual does
+    not decrease.
+    lambda starts at ||J||_inf and is reduced as ||f||_2 drops
+    (switched evolution relaxation), so the iteration moves from
+    small implicit Euler steps to full Newton steps near steady state.
+    As f and the columns of J lie in the range of the stoichiometry
+    matrix every step does too, so the conserved moieties of the
+    starting concentrations are kept without forming them.
+    Concentrations are kept nonnegative by shortening the step so
+    that no species drops by more than 90 percent in one iteration.
+    A step that would lower a species already at 0 is not taken
+    (alpha = 0) and lambda is raised instead, the step is never
+    clipped per species as that would break the moieties.
+    Fixed species have empty jacobian rows so their rows of the
+    Newton matrix are identity rows and they do not move.
+    If the residual has not decreased by the time lambda reaches
+    lambda_max the iteration stops as not converged, so the caller
+    falls back to integrating the odes.
+
+    As J is the lr8 jacobian, deq_run only calls this for the lr8, lr15
+    and lr16 derivatives (DELTA_CONCS_CHOICE 8, 15, 16).
+
+    Converged when ||f||_inf <= lsq_ftol * ||concs||_inf.
+    On return concs holds the last accepted iterate, the return value
+    is 1 if converged, 0 otherwise.
+
+    Called by: deq_run
+    Calls:     lsq_newton_workspace,
+	       lr8_approximate_jacobian,
+	       build_newton_matrix,
+	       sparse_lu_symbolic,
+	       sparse_lu_factor,
+	       boltzmann_cvodes_fsolve,
+	       boltzmann_cvodes_bsolve,
+	       gradient,
+	       dnrm2_,
+	       fabs, calloc, free, fprintf, fflush
+  */
+  struct molecule_struct *molecules;
+  struct cvodes_params_struct *cvodes_params;
+  struct cvodes_params_struct saved_params;
+  double *workspace;
+  double *newton_workspace;
+  double *dfdy_a;
+  double *f;
+  double *f_trial;
+  double *c_trial;
+  double *delta;
+  double *x;
+  double *w;
+  int    *dfdy_ia;
+  int    *perm;
+  int64_t ask_for;
+  int64_t one_l;
+  int64_t compute_sensitivities;
+  int64_t max_iters;
+  double ftol;
+  double lambda;
+  double lambda_min;
+  double lambda_max;
+  double jnorm;
+  double rowsum;
+  double fnorm;
+  double fnorm_trial;
+  double finf;
+  double cnorm;
+  double alpha;
+  double tau;
+  int ny;
+  int gradient_choice;
+  int success;
+  int converged;
+  int accepted;
+  int iter;
+  int retries;
+  int max_retries;
+  int linear_solves;
+  int factored;
+  int alg;
+  int inc1;
+  int i;
+  int j;
+  int k;
+  int padi;
+  FILE *lfp;
+  FILE *efp;
+
+  success         = 1;
+  converged       = 0;
+  one_l           = (int64_t)1;
+  inc1            = 1;
+  tau             = 0.9;
+  max_retries     = 20;
+  linear_solves   = 0;
+  iter            = 0;
+  fnorm           = 0.0;
+  fnorm_trial     = 0.0;
+  alpha           = 1.0;
+  lambda          = 0.0;
+  lambda_min      = 0.0;
+  lambda_max      = 0.0;
+  ny              = (int)state->nunique_molecules;
+  cvodes_params   = state->cvodes_params;
+  workspace       = NULL;
+  newton_workspace = NULL;
+  molecules       = state->sorted_molecules;
+  gradient_choice = (int)state->gradient_choice;
+  max_iters       = state->lsq_max_iters;
+  ftol            = state->lsq_ftol;
+  lfp             = state->lfp;
+  /*
+    Use the equilibrium constants in state->ke, not the cvodes
+    sensitivity parameters which may not be set yet.
+  */
+  compute_sensitivities        = state->compute_sensitivities;
+  state->compute_sensitivities = 0;
+  /*
+    Workspace:
+    doubles:
+      f       (ny)
+      f_trial (ny)
+      c_trial (ny)
+      delta   (ny)
+    The sparse jacobian and Newton matrix workspace is set up in
+    cvodes_params by lsq_newton_workspace.
+  */
+  ask_for   = ((int64_t)(4*ny)) << 3;
+  workspace = (double *)calloc(one_l,ask_for);
+  if (workspace == NULL) {
+    success = 0;
+    if (lfp) {
+      fprintf(lfp,"lsq_steady_state: Error unable to allocate %ld bytes "
+	      "for workspace\n",ask_for);
+      fflush(lfp);
+    }
+  }
+  if (success) {
+    success = lsq_newton_workspace(state,&saved_params,&newton_workspace);
+  }
+  if (success) {
+    f       = workspace;
+    f_trial = &f[ny];
+    c_trial = &f_trial[ny];
+    delta   = &c_trial[ny];
+    alg     = cvodes_params->sparse_matrix_ordering_alg;
+    perm    = cvodes_params->perm;
+    dfdy_a  = cvodes_params->dfdy_a;
+    dfdy_ia = cvodes_params->dfdy_ia;
+    factored = 0;
+    gradient(state,concs,f,gradient_choice);
+    fnorm = dnrm2_(&ny,f,&inc1);
+    for (iter=0;iter<=max_iters;iter++) {
+      finf  = 0.0;
+      cnorm = 0.0;
+      for (i=0;i<ny;i++) {
+	if (fabs(f[i]) > finf) {
+	  finf = fabs(f[i]);
+	}
+	if (fabs(concs[i]) > cnorm) {
+	  cnorm = fabs(concs[i]);
+	}
+      }
+      if (finf <= ftol * cnorm) {
+	converged = 1;
+	break;
+      }
+      if (iter == max_iters) {
+	break;
+      }
+      /*
+	f_trial is scratch for the derivatives lr8_approximate_jacobian
+	also computes.
+      */
+      success = lr8_approximate_jacobian(state,concs,f_trial,0.0,8);
+      if (success == 0) {
+	break;
+      }
+      if (iter == 0) {
+	jnorm = 0.0;
+	for (i=0;i<ny;i++) {
+	  rowsum = 0.0;
+	  for (j=dfdy_ia[i];j<dfdy_ia[i+1];j++) {
+	    rowsum += fabs(dfdy_a[j]);
+	  }
+	  if (rowsum > jnorm) {
+	    jnorm = rowsum;
+	  }
+	}
+	if (jnorm <= 0.0) {
+	  jnorm = 1.0;
+	}
+	lambda     = jnorm;
+	lambda_min = 1.0e-12 * jnorm;
+	lambda_max = 1.0e12 * jnorm;
+      }
+      accepted = 0;
+      for (retries=0;retries<max_retries;retries++) {
+	if (retries > 0) {
+	  if (lambda >= lambda_max) {
+	    break;
+	  }
+	  lambda = lambda * 10.0;
+	}
+	/*
+	  M = I - J/lambda, permuted by build_newton_matrix.
+	*/
+	success = build_newton_matrix(state,1.0/lambda,8);
+	if (success && (factored == 0)) {
+	  success = sparse_lu_symbolic(state);
+	  factored = success;
+	}
+	if (success == 0) {
+	  break;
+	}
+	k = sparse_lu_factor(state);
+	if (k == -1) {
+	  success = sparse_lu_symbolic(state);
+	  if (success == 0) {
+	    break;
+	  }
+	  k = sparse_lu_factor(state);
+	}
+	if (k != 1) {
+	  /*
+	    Zero pivot, or M still outside the symbolic structure.
+	  */
+	  continue;
+	}
+	/*
+	  delta = Q^T U^(-1) L^(-1) Q f/lambda, fixed species do not move.
+	*/
+	for (i=0;i<ny;i++) {
+	  if (molecules[i].variable != 1) {
+	    delta[i] = 0.0;
+	  } else {
+	    delta[i] = f[i]/lambda;
+	  }
+	}
+	x = delta;
+	if (alg != 0) {
+	  x = cvodes_params->frow;
+	  for (i=0;i<ny;i++) {
+	    x[i] = delta[perm[i]];
+	  }
+	}
+	w = cvodes_params->srow;
+	boltzmann_cvodes_fsolve(state,x,w);
+	if (alg == 0) {
+	  boltzmann_cvodes_bsolve(state,w,delta);
+	} else {
+	  x = cvodes_params->frow;
+	  boltzmann_cvodes_bsolve(state,w,x);
+	  for (i=0;i<ny;i++) {
+	    delta[perm[i]] = x[i];
+	  }
+	}
+	linear_solves += 1;
+	/*
+	  Fraction to the boundary rule to keep concentrations
+	  nonnegative, no step if a species at 0 would go negative.
+	*/
+	alpha = 1.0;
+	for (i=0;i<ny;i++) {
+	  if (delta[i] < 0.0) {
+	    if (concs[i] <= 0.0) {
+	      alpha = 0.0;
+	    } else if ((alpha * delta[i]) < (0.0 - (tau * concs[i]))) {
+	      alpha = (tau * concs[i])/(0.0 - delta[i]);
+	    }
+	  }
+	}
+	if (alpha <= 0.0) {
+	  continue;
+	}
+	for (i=0;i<ny;i++) {
+	  c_trial[i] = concs[i] + (alpha * delta[i]);
+	}
+	gradient(state,c_trial,f_trial,gradient_choice);
+	fnorm_trial = dnrm2_(&ny,f_trial,&inc1);
+	if (fnorm_trial < fnorm) {
+	  accepted = 1;
+	  break;
+	}
+      } /* end for (retries...) */
+      if (accepted == 0) {
+	break;
+      }
+      /*
+	Switched evolution relaxation, shrink lambda with the residual.
+      */
+      if (fnorm > 0.0) {
+	lambda = lambda * (fnorm_trial/fnorm);
+      }
+      if (lambda < lambda_min) {
+	lambda = lambda_min;
+      }
+      for (i=0;i<ny;i++) {
+	concs[i] = c_trial[i];
+	f[i]     = f_trial[i];
+      }
+      fnorm = fnorm_trial;
+      if (lfp && (state->print_output > 1)) {
+	fprintf(lfp,"lsq_steady_state: iter %d ||f||_2 = %le lambda = %le "
+		"alpha = %le\n",iter,fnorm,lambda,alpha);
+	fflush(lfp);
+      }
+    } /* end for (iter...) */
+    if (lfp) {
+      if (converged) {
+	fprintf(lfp,"lsq_steady_state: converged in %d iterations, "
+		"%d linear solves, ||f||_2 = %le\n",
+		iter,linear_solves,fnorm);
+      } else {
+	fprintf(lfp,"lsq_steady_state: did not converge in %d iterations, "
+		"%d linear solves, ||f||_2 = %le\n",
+		iter,linear_solves,fnorm);
+      }
+      fflush(lfp);
+    }
+  }
+  if (newton_workspace) {
+    if (cvodes_params->slu_factors) {
+      free(cvodes_params->slu_factors);
+    }
+    free(newton_workspace);
+    *cvodes_params = saved_params;
+  }
+  if (workspace) {
+    free(workspace);
+  }
+  state->compute_sensitivities = compute_sensitivities;
+  if (success) {
+    success = converged;
+  }
+  return(success);
+}
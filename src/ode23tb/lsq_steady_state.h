@@ -0,0 +1,4 @@
+#ifndef _LSQ_STEADY_STATE_H_
+#define _LSQ_STEADY_STATE_H_ 1
+extern int lsq_steady_state(struct state_struct *state, double *concs);
+#endif
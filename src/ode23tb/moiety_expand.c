@@ -0,0 +1,46 @@
+#include "boltzmann_structs.h"
+#include "moiety_expand.h"
+void moiety_expand(struct state_struct *state, double *yr, double *concs) {
+  /*
+    Rebuild the full concentration vector from the independent species
+    concentrations yr, the inverse of moiety_reduce:
+      concs[independent_species[j]] = yr[j],
+      concs[dependent_species[i]]   = moiety_totals[i] + 
+         sum_j link_matrix[i*nr+j] * yr[j].
+    Called by: boltzmann_cvodes, boltzmann_cvodes_rhs_reduced,
+               boltzmann_cvodes_jtimes_reduced
+    Calls:
+  */
+  double *link_matrix;
+  double *moiety_totals;
+  double *lrow;
+  double conc;
+  int    *independent_species;
+  int    *dependent_species;
+  int ny;
+  int nr;
+  int nd;
+  int i;
+  int j;
+  int padi;
+
+  ny                  = (int)state->nunique_molecules;
+  nr                  = (int)state->number_independent;
+  nd                  = ny - nr;
+  link_matrix         = state->link_matrix;
+  moiety_totals       = state->moiety_totals;
+  independent_species = state->independent_species;
+  dependent_species   = state->dependent_species;
+  for (j=0;j<nr;j++) {
+    concs[independent_species[j]] = yr[j];
+  }
+  lrow = link_matrix;
+  for (i=0;i<nd;i++) {
+    conc = moiety_totals[i];
+    for (j=0;j<nr;j++) {
+      conc += lrow[j] * yr[j];
+    }
+    concs[dependent_species[i]] = conc;
+    lrow += nr; /* Caution address arithmetic here. */
+  }
+}
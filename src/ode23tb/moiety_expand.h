@@ -0,0 +1,5 @@
+#ifndef _MOIETY_EXPAND_H_
+#define _MOIETY_EXPAND_H_ 1
+extern void moiety_expand(struct state_struct *state, double *yr,
+			  double *concs);
+#endif
@@ -0,0 +1,45 @@
+#include "boltzmann_structs.h"
+#include "moiety_reduce.h"
+void moiety_reduce(struct state_struct *state, double *concs, double *yr) {
+  /*
+    Gather the independent species concentrations of concs into yr
+    (length number_independent) and set the moiety totals so that
+    moiety_expand(state,yr,concs) reproduces concs:
+      moiety_totals[i] = concs[dependent_species[i]] -
+         sum_j link_matrix[i*nr+j] * concs[independent_species[j]].
+    Called by: boltzmann_cvodes
+    Calls:
+  */
+  double *link_matrix;
+  double *moiety_totals;
+  double *lrow;
+  double total;
+  int    *independent_species;
+  int    *dependent_species;
+  int ny;
+  int nr;
+  int nd;
+  int i;
+  int j;
+  int padi;
+
+  ny                  = (int)state->nunique_molecules;
+  nr                  = (int)state->number_independent;
+  nd                  = ny - nr;
+  link_matrix         = state->link_matrix;
+  moiety_totals       = state->moiety_totals;
+  independent_species = state->independent_species;
+  dependent_species   = state->dependent_species;
+  for (j=0;j<nr;j++) {
+    yr[j] = concs[independent_species[j]];
+  }
+  lrow = link_matrix;
+  for (i=0;i<nd;i++) {
+    total = concs[dependent_species[i]];
+    for (j=0;j<nr;j++) {
+      total -= lrow[j] * yr[j];
+    }
+    moiety_totals[i] = total;
+    lrow += nr; /* Caution address arithmetic here. */
+  }
+}
@@ -0,0 +1,5 @@
+#ifndef _MOIETY_REDUCE_H_
+#define _MOIETY_REDUCE_H_ 1
+extern void moiety_reduce(struct state_struct *state, double *concs,
+			  double *yr);
+#endif
@@ -21,6 +21,8 @@
 #include "ode23tb_enforce_nonneg.h"
 #include "ode_test_steady_state.h"
 #include "boltzmann_monitor_ode.h"
+#include "ode_dense_output_time.h"
+#include "ode23tb_hermite.h"
 #include "boltzmann_size_jacobian.h"
 #include "approximate_jacobian.h"
 #include "print_dense_jacobian.h"
@@ -54,6 +56,7 @@ int ode23tb (struct state_struct *state, double *concs) {
 	       ode23tb_build_factor_miter, ode23tb_max_abs_ration,
 	       ode23tb_nonneg_err, ode23tb_enforce_nonneg,
 	       boltzmann_monitor_ode, boltzmann_size_jacobian,
+	       ode_dense_output_time, ode23tb_hermite,
 	       dcopy_, dnrm2_, dgemv_, dscal_, idamax_
 	       sizeof, calloc, sqrt, pow, fabs, dgetrf_, dgetrs_
 
@@ -99,11 +102,14 @@ int ode23tb (struct state_struct *state, double *concs) {
   double *conc_to_count; /* length unique_molecules */
   double *counts;
   double *dbl_ptr;
+  double *y_dense; /* length nunique_molecules */
 
   double t0;
   double t;
   double t2;
   double tnew;
+  double t_dense;
+  double s_dense;
   double htspan;
   double tfinal;
   double third;
@@ -175,6 +181,8 @@ int ode23tb (struct state_struct *state, double *concs) {
   int64_t sqrt_eps_hex;
   int64_t ode_rxn_view_freq;
   int64_t ode_rxn_view_step;
+  int64_t dense_output;
+  int64_t dense_k;
 
   int *dfdy_ia;
   int *dfdy_iat;
@@ -316,6 +324,20 @@ int ode23tb (struct state_struct *state, double *concs) {
   if (ode_rxn_view_freq>0) {
     boltzmann_monitor_ode(state,t0,concs);
   }
+  /*
+    With dense output the concentrations are printed at the
+    ode_dense_output_time times, interpolated from the accepted steps,
+    instead of at every ode_rxn_view_freq'th step.
+  */
+  dense_output = 0;
+  dense_k      = 0;
+  t_dense      = 0.0;
+  if (print_output && (state->ode_dense_output > 0)) {
+    dense_output = state->ode_dense_output;
+    dense_k      = 1;
+    t_dense      = ode_dense_output_time(state,dense_k);
+    ode_print_concs(state,t0,concs);
+  }
   trans_chars[0] = 'N';
   trans_chars[1] = 'T';
   trans_chars[3] = 'C';
@@ -406,6 +428,7 @@ int ode23tb (struct state_struct *state, double *concs) {
     ode23tb_params->fdiff = fdiff;
     dfdy_tmp              = &fdiff[ny];
     ode23tb_params->dfdy_tmp = dfdy_tmp;
+    y_dense               = &dfdy_tmp[ny];
     forward_rxn_likelihoods = state->ode_forward_lklhds;
     reverse_rxn_likelihoods = state->ode_reverse_lklhds;
     counts                  = state->ode_counts;
@@ -1093,12 +1116,28 @@ int ode23tb (struct state_struct *state, double *concs) {
       fprintf(ode_grad_fp," After inner_loop, info = %d\n",info);
       fflush(ode_grad_fp);
 #endif
-      if (not_done) {
-	nsteps = nsteps + 1;
-	nnreset_znew = 0;
+      if ((unsuccessful_step == 0) && tolerance_met) {
 	if (nonnegative) {
 	  ode23tb_enforce_nonneg(ny,normcontrol,ynew,znew,&normynew);
 	}
+	/*
+	  Print the dense output times in (t,tnew] from the
+	  Hermite interpolant of the step, the last step included.
+	*/
+	while (dense_output && (dense_k <= dense_output) && 
+	       (t_dense <= tnew)) {
+	  s_dense = (t_dense - t)/h;
+	  ode23tb_hermite(ny,s_dense,y,z,ynew,znew,y_dense);
+	  ode_print_concs(state,t_dense,y_dense);
+	  dense_k += 1;
+	  if (dense_k <= dense_output) {
+	    t_dense = ode_dense_output_time(state,dense_k);
+	  }
+	}
+      }
+      if (not_done) {
+	nsteps = nsteps + 1;
+	nnreset_znew = 0;
 	/* 
 	  Advance the integration one step. 
 	*/
@@ -1178,6 +1217,10 @@ int ode23tb (struct state_struct *state, double *concs) {
   if (dfdy != NULL) {
     free(dfdy);
   }
+  if (drfc != NULL) {
+    free(drfc);
+    cvodes_params->drfc = NULL;
+  }
   return (success);
 }
 
@@ -0,0 +1,31 @@
+#include "system_includes.h"
+#include "ode23tb_hermite.h"
+void ode23tb_hermite(int ny, double s, double *y, double *z,
+		     double *ynew, double *znew, double *yout) {
+  /*
+    Cubic Hermite interpolant of an accepted ode23tb step from t to
+    tnew = t + h, evaluated at t + s*h, 0 <= s <= 1.
+    y and ynew are the solutions at t and tnew, z and znew are h times
+    their derivatives (the TR-BDF2 z vectors), so no extra gradient
+    evaluations are needed.
+    Called by: ode23tb
+    Calls:
+  */
+  double s2;
+  double s3;
+  double h00;
+  double h10;
+  double h01;
+  double h11;
+  int i;
+  int padi;
+  s2  = s * s;
+  s3  = s2 * s;
+  h00 = (2.0*s3) - (3.0*s2) + 1.0;
+  h10 = s3 - (2.0*s2) + s;
+  h01 = (3.0*s2) - (2.0*s3);
+  h11 = s3 - s2;
+  for (i=0;i<ny;i++) {
+    yout[i] = (h00*y[i]) + (h10*z[i]) + (h01*ynew[i]) + (h11*znew[i]);
+  }
+}
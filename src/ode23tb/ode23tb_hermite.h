@@ -0,0 +1,5 @@
+#ifndef _ODE23TB_HERMITE_H_
+#define _ODE23TB_HERMITE_H_ 1
+extern void ode23tb_hermite(int ny, double s, double *y, double *z,
+			    double *ynew, double *znew, double *yout);
+#endif
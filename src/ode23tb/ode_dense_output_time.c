@@ -0,0 +1,33 @@
+#include "boltzmann_structs.h"
+#include "ode_dense_output_time.h"
+double ode_dense_output_time(struct state_struct *state, int64_t k) {
+  /*
+    Return the k'th (1 <= k <= ode_dense_output) output time for
+    dense output of the ode concentrations.
+    If ode_dense_log_t0 > 0 the times are log spaced from ode_dense_log_t0
+    to ode_t_final, otherwise they are ode_t_final*k/ode_dense_output.
+    The last time is always ode_t_final.
+
+    Called by: ode23tb, boltzmann_cvodes
+    Calls:     log, exp
+  */
+  double tfinal;
+  double t0;
+  double tk;
+  double frac;
+  int64_t n;
+  tfinal = state->ode_t_final;
+  t0     = state->ode_dense_log_t0;
+  n      = state->ode_dense_output;
+  if (k >= n) {
+    tk = tfinal;
+  } else {
+    if ((t0 > 0.0) && (t0 < tfinal)) {
+      frac = ((double)(k - 1))/((double)(n - 1));
+      tk   = t0 * exp(frac * log(tfinal/t0));
+    } else {
+      tk   = (tfinal * ((double)k))/((double)n);
+    }
+  }
+  return(tk);
+}
@@ -0,0 +1,4 @@
+#ifndef _ODE_DENSE_OUTPUT_TIME_H_
+#define _ODE_DENSE_OUTPUT_TIME_H_ 1
+extern double ode_dense_output_time(struct state_struct *state, int64_t k);
+#endif
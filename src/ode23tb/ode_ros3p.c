@@ -0,0 +1,651 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_cvodes_headers.h"
+#include "cvodes_params_struct.h"
+
+#include "gradient.h"
+#include "ode_print_concs.h"
+#include "ode_print_grad.h"
+#include "non_cvode_blas.h"
+#include "ode23tb_normyp_o_wt.h"
+#include "ode23tb_limit_h.h"
+#include "ode23tb_init_wt.h"
+#include "ode23tb_update_wt.h"
+#include "vec_set_constant.h"
+#include "ode23tb_build_factor_miter.h"
+#include "ode23tb_max_abs_ratio.h"
+#include "ode23tb_nonneg_err.h"
+#include "ode23tb_enforce_nonneg.h"
+#include "ode_test_steady_state.h"
+#include "boltzmann_monitor_ode.h"
+#include "ode_dense_output_time.h"
+#include "ode23tb_hermite.h"
+#include "boltzmann_size_jacobian.h"
+#include "approximate_jacobian.h"
+
+#include "ode_ros3p.h"
+int ode_ros3p (struct state_struct *state, double *concs) {
+
+  /*
+    Linearly implicit Rosenbrock integrator, ROS3P of Lang and Verwer,
+    third order with an embedded second order error estimate,
+    selected with ODE_SOLVER_CHOICE 2.
+    Unlike ode23tb there are no Newton iterations: each step does one
+    jacobian, one LU factorization of miter = I - gamma*h*dfdy and three
+    solves, with two gradient evaluations at the stage points and one
+    at the new y. Our gradient does not depend on t, so the stage time
+    terms are dropped.
+
+    With W = I/(gamma*h) - dfdy the stages are
+      W u1 = f(y)
+      W u2 = f(y + a21*u1) + (c21/h)*u1
+      W u3 = f(y + a31*u1 + a32*u2) + (c31/h)*u1 + (c32/h)*u2
+    and
+      ynew = y + m1*u1 + m2*u2 + m3*u3
+      est  = (m1-mh1)*u1 + (m2-mh2)*u2 + (m3-mh3)*u3.
+    We factor miter = gamma*h*W with ode23tb_build_factor_miter, so the
+    right hand sides are scaled by gamma*h.
+
+    The jacobian comes from approximate_jacobian with ode_jacobian_choice,
+    tolerances, weights, step size limits and the nonnegativity handling
+    are those of ode23tb, and so are the monitoring and dense output.
+    concs is the vector of initial concentrations on input and the
+    final concentrations on output.
+
+    Called by: ode_solver
+    Calls:     gradient, approximate_jacobian, boltzmann_size_jacobian,
+               ode_print_concs, ode_print_grad, ode23tb_normyp_o_wt,
+	       ode23tb_limit_h, ode23tb_init_wt, ode23tb_update_wt,
+	       vec_set_constant, ode23tb_build_factor_miter,
+	       ode23tb_max_abs_ratio, ode23tb_nonneg_err,
+	       ode23tb_enforce_nonneg, ode_test_steady_state,
+	       boltzmann_monitor_ode, ode_dense_output_time, ode23tb_hermite,
+	       dcopy_, dnrm2_, dgemv_, dscal_, daxpy_, idamax_, dgetrs_,
+	       calloc, free, sqrt, pow, fabs, fprintf, fflush
+  */
+  struct ode23tb_params_struct *ode23tb_params;
+  struct cvodes_params_struct *cvodes_params;
+  double *dfdy; /* length nunique_molecules * nunique_molecules */
+  double *miter; /* length nunique_molecules * nunique_molecules */
+  double *y;  /* length nunique_molecules */
+  double *f0; /* length nunique_molecules */
+  double *ynew; /* length nunique_molecules */
+  double *fnew; /* length nunique_molecules */
+  double *u; /* length 3 * nunique_molecules, u1, u2, u3 */
+  double *u1; /* length nunique_molecules */
+  double *u2; /* length nunique_molecules */
+  double *u3; /* length nunique_molecules */
+  double *ytmp; /* length nunique_molecules */
+  double *fs; /* length nunique_molecules */
+  double *est; /* length nunique_molecules */
+  double *wt; /* length nunique_molecules */
+  double *fac; /* length nunique_molecules */
+  double *thresh; /* length nunique_molecules */
+  double *fdel; /* length nunique_molecules */
+  double *fdiff; /* length nunique_molecules */
+  double *dfdy_tmp; /* length nunique_molecules */
+  double *delfdelt; /* length nunique_molecules */
+  double *y_dense; /* length nunique_molecules */
+  double *z; /* length nunique_molecules */
+  double *znew; /* length nunique_molecules */
+  double *pivot; /* length nunique_molecules */
+
+  double *drfc; /* length 2*number_molecules. */
+  double *dfdy_row; /* length ny */
+  double *dfdy_a; /* length nnz */
+  double *dfdy_at; /* length nnz */
+  double *dbl_ptr;
+
+  double t0;
+  double t;
+  double tnew;
+  double tfinal;
+  double t_dense;
+  double s_dense;
+  double htspan;
+  double third;
+  double gamma;
+  double a21;
+  double a31;
+  double a32;
+  double c21;
+  double c31;
+  double c32;
+  double hg;
+  double scalar;
+  double eps;
+  double threshold;
+  double njthreshold;
+  double h;
+  double hmin;
+  double hmax;
+  double tdir;
+  double rh;
+  double recip_70p;
+  double recip_cube_root_rtol;
+  double normy;
+  double normynew;
+  double norm_delfdelt;
+  double norm_delfdelt_o_wt;
+  double err;
+  double absh;
+  double h_ratio;
+  double rtol;
+  double errnn_scale;
+  double dzero;
+  double htry;
+  double ynew_coeff[3];
+  double est_coeff[3];
+
+  int64_t ask_for;
+  int64_t one_l;
+  int64_t zero_l;
+  int64_t nfevals;
+  int64_t nsteps;
+  int64_t nfailed;
+  int64_t npds;
+  int64_t ndecomps;
+  int64_t nsolves;
+  int64_t nf;
+  int64_t eps_hex;
+  int64_t ode_rxn_view_freq;
+  int64_t ode_rxn_view_step;
+  int64_t dense_output;
+  int64_t dense_k;
+
+  int *dfdy_ia;
+  int *dfdy_iat;
+  int *dfdy_ja;
+  int *dfdy_jat;
+  int *column_mask;
+  int *ipivot;                  /* overlaid on pivot space */
+
+  int ny;
+  int nysq;
+
+  int inc1;
+  int ithree;
+
+  int not_done;
+  int done;
+
+  int success;
+  int nrhs;
+
+  int need_new_j;
+
+  int accepted;
+  int nnrejectstep;
+
+  int info;
+  int gradient_choice;
+
+  int print_output;
+  int nnz;
+
+  int normcontrol;
+  int nonnegative;
+
+  int num_ints;
+  int ode_jacobian_choice;
+
+  int num_doubles;
+  int drfc_len;
+
+  int ia_len;
+  int padi;
+
+  char  trans_chars[8];
+  char  *trans;
+
+  FILE *lfp;
+  FILE *efp;
+
+  success = 1;
+  ode23tb_params = state->ode23tb_params;
+  cvodes_params  = state->cvodes_params;
+  ode_jacobian_choice = state->ode_jacobian_choice;
+  t0      = 0.0;
+  t       = t0;
+  tnew    = t0;
+  tfinal  = state->ode_t_final;
+  tdir    = 1.0;
+  one_l   = (int64_t)1;
+  zero_l  = (int64_t)0;
+  nsteps   = (int64_t)0;
+  nfailed  = nsteps;
+  npds     = nsteps;
+  ndecomps = nsteps;
+  nsolves  = nsteps;
+  nfevals  = nsteps;
+  nonnegative = 1;
+  normcontrol = 0;
+  htry        = 0.0;
+  ode23tb_params->nonnegative = nonnegative;
+  ode23tb_params->normcontrol = normcontrol;
+  ode23tb_params->htry        = htry;
+  rtol     = 0.001;
+  dzero    = 0.0;
+  ny            = state->nunique_molecules;
+  nysq          = ny * ny;
+  print_output  = state->print_output;
+  gradient_choice = (int)state->gradient_choice;
+  lfp           = state->lfp;
+  ode_rxn_view_freq = state->ode_rxn_view_freq;
+  if (print_output == 0) {
+    ode_rxn_view_freq = 0;
+    state->ode_rxn_view_freq = 0;
+  }
+  ode_rxn_view_step = one_l;
+  if (ode_rxn_view_freq>0) {
+    boltzmann_monitor_ode(state,t0,concs);
+  }
+  dense_output = 0;
+  dense_k      = 0;
+  t_dense      = 0.0;
+  if (print_output && (state->ode_dense_output > 0)) {
+    dense_output = state->ode_dense_output;
+    dense_k      = 1;
+    t_dense      = ode_dense_output_time(state,dense_k);
+    ode_print_concs(state,t0,concs);
+  }
+  trans_chars[0] = 'N';
+  trans_chars[1] = 'T';
+  trans_chars[3] = 'C';
+  trans = &trans_chars[0];
+  inc1          = 1;
+  ithree        = 3;
+  nrhs          = 1;
+  info          = 0;
+
+  /*
+    ROS3P coefficients.
+  */
+  gamma = 7.886751345948129e-01;
+  a21   = 1.267949192431123;
+  a31   = 1.267949192431123;
+  a32   = 0.0;
+  c21   = -1.607695154586736;
+  c31   = -3.464101615137755;
+  c32   = -1.732050807568877;
+  ynew_coeff[0] = 2.0;
+  ynew_coeff[1] = 5.773502691896258e-01;
+  ynew_coeff[2] = 4.226497308103742e-01;
+  /*
+    m - mhat, mhat = (2.113248654051871, 1.0, 4.226497308103742e-01).
+  */
+  est_coeff[0]  = 2.0 - 2.113248654051871;
+  est_coeff[1]  = 5.773502691896258e-01 - 1.0;
+  est_coeff[2]  = 0.0;
+
+  dfdy      = NULL;
+  drfc      = NULL;
+  dfdy_row  = NULL;
+  dfdy_a    = NULL;
+  dfdy_at   = NULL;
+  dfdy_ia   = NULL;
+  dfdy_iat  = NULL;
+  dfdy_ja   = NULL;
+  dfdy_jat  = NULL;
+  column_mask = NULL;
+  /*
+    Allocate double space needed for scratch vectors and matrices,
+    24*ny are used.
+  */
+  ask_for = ((ny * 24) + (2*nysq)) * sizeof(double);
+  dfdy = (double*)calloc(ask_for,one_l);
+  ode23tb_params->dfdy = dfdy;
+  if (dfdy == NULL) {
+    success = 0;
+    if (lfp) {
+      fprintf(lfp,"ode_ros3p: Error could not allocate %ld bytes "
+	      "for scratch space.\n",ask_for);
+      fflush(lfp);
+    }
+  }
+  if (success) {
+    miter     = &dfdy[nysq];
+    y         = &miter[nysq];
+    f0        = &y[ny];
+    ynew      = &f0[ny];
+    fnew      = &ynew[ny];
+    u         = &fnew[ny];
+    u1        = u;
+    u2        = &u1[ny];
+    u3        = &u2[ny];
+    ytmp      = &u3[ny];
+    fs        = &ytmp[ny];
+    est       = &fs[ny];
+    wt        = &est[ny];
+    fac       = &wt[ny];
+    ode23tb_params->fac = fac;
+    thresh    = &fac[ny];
+    ode23tb_params->thresh = thresh;
+    fdel      = &thresh[ny];
+    ode23tb_params->fdel = fdel;
+    fdiff     = &fdel[ny];
+    ode23tb_params->fdiff = fdiff;
+    dfdy_tmp  = &fdiff[ny];
+    ode23tb_params->dfdy_tmp = dfdy_tmp;
+    delfdelt  = &dfdy_tmp[ny];
+    y_dense   = &delfdelt[ny];
+    z         = &y_dense[ny];
+    znew      = &z[ny];
+    pivot     = &znew[ny];
+    ipivot    = (int*)pivot;
+
+    threshold   = 1.0e-3;
+    njthreshold = state->nj_thresh;
+    ode23tb_params->threshold = threshold;
+    ode23tb_params->njthreshold = njthreshold;
+    dcopy_(&ny,concs,&inc1,y,&inc1);
+    vec_set_constant(ny,thresh,njthreshold);
+  }
+  if (success) {
+    if (ode_jacobian_choice != 0) {
+      /*
+	 The sparse jacobian vectors pointed to by cvodes_params,
+	 as in ode23tb.
+      */
+      drfc_len = state->number_molecules*2;
+      boltzmann_size_jacobian(state);
+      nnz = cvodes_params->nnz;
+      num_doubles = drfc_len + nnz + nnz + ny;
+      num_ints    = 2*nnz + 3*ny + 7;
+      num_ints    = num_ints + (num_ints & 1);
+      ask_for     = (num_doubles << 3) + (num_ints << 2);
+
+      drfc = (double *)calloc(one_l,ask_for);
+      if (drfc == NULL) {
+	success = 0;
+	if (lfp) {
+	  fprintf(lfp,"ode_ros3p: Error could not allocate %ld bytes "
+		  "for double scratch space.\n",ask_for);
+	  fflush(lfp);
+	}
+      } else {
+	dfdy_row = (double *)&drfc[drfc_len];
+	dfdy_a   = (double *)&dfdy_row[ny];
+	dfdy_at  = (double *)&dfdy_a[nnz];
+	dfdy_ia  = (int *)&dfdy_at[nnz];
+	if (ny & 1) {
+	  ia_len = ny + 1;
+	} else {
+	  ia_len = ny + 2;
+	}
+	dfdy_iat = (int*)&dfdy_ia[ia_len];
+	nnz      = nnz + (nnz &1);
+	dfdy_ja  = (int*)&dfdy_iat[ia_len];
+	dfdy_jat = (int*)&dfdy_ja[nnz];
+	column_mask = (int*)&dfdy_jat[nnz];
+	cvodes_params->drfc     = drfc;
+	cvodes_params->prec_row = dfdy_row;
+	cvodes_params->dfdy_a   = dfdy_a;
+	cvodes_params->dfdy_at  = dfdy_at;
+	cvodes_params->dfdy_ia  = dfdy_ia;
+	cvodes_params->dfdy_iat = dfdy_iat;
+	cvodes_params->dfdy_ja  = dfdy_ja;
+	cvodes_params->dfdy_jat = dfdy_jat;
+	cvodes_params->column_mask = column_mask;
+      }
+    }
+  }
+  if (success) {
+    gradient(state,y,f0,gradient_choice);
+    if (ode_rxn_view_freq > 0) {
+      ode_print_grad(state,t,f0);
+    }
+    nfevals = (int64_t)1;
+    nf = 0;
+    ode23tb_params->num_jac_first_time = 1;
+    ode23tb_params->nf                 = nf;
+    approximate_jacobian(state,y,f0,t0,ode_jacobian_choice);
+    nfevals += ode23tb_params->nf;
+    npds    += 1;
+    need_new_j = 0;
+
+    eps_hex       = 0x3CB0000000000000L;
+    dbl_ptr       = (double *)&eps_hex;
+    eps           = *dbl_ptr;
+    third         = 1.0/3.0;
+    recip_70p     = 1.43;
+    recip_cube_root_rtol = 10.0;
+    hmin          = 0.0;
+    hmax          = 1.0;
+    htspan        = tfinal - t0;
+    normy         = fabs(y[idamax_(&ny,y,&inc1)-1]);
+    ode23tb_init_wt(normcontrol,ny,normy,threshold,y,wt);
+    if (htry == 0.0) {
+      /*
+	Initial step size from the second derivative, dfdy * f0,
+	as in ode23tb.
+      */
+      scalar = 1.0;
+      dgemv_(trans,&ny,&ny,&scalar,dfdy,&ny,f0,&inc1,&dzero,delfdelt,&inc1,1);
+      norm_delfdelt = dnrm2_(&ny,delfdelt,&inc1);
+      norm_delfdelt_o_wt = ode23tb_normyp_o_wt(normcontrol,ny,norm_delfdelt,
+					       delfdelt,wt);
+      rh = (recip_70p * sqrt(.5*norm_delfdelt_o_wt)) * recip_cube_root_rtol;
+      absh = htspan;
+      ode23tb_limit_h(hmax,hmin,rh,tdir,&absh,&h);
+    } else {
+      rh = 1.0/hmax;
+      absh = htry;
+      ode23tb_limit_h(hmax,hmin,rh,tdir,&absh,&h);
+    }
+    rh = 1.0/hmax;
+    not_done = 1;
+    done     = 0;
+    /*
+      Main loop, one accepted step per pass.
+    */
+    while (not_done) {
+      hmin = 16.0*eps*fabs(t);
+      ode23tb_limit_h(hmax,hmin,rh,tdir,&absh,&h);
+      if ((1.1*absh) >= fabs(tfinal - t)) {
+	h = tfinal - t;
+	absh = fabs(h);
+	done = 1;
+      }
+      accepted = 0;
+      while (accepted == 0) {
+	if (need_new_j) {
+	  approximate_jacobian(state,y,f0,t,ode_jacobian_choice);
+	  nfevals += ode23tb_params->nf;
+	  npds += 1;
+	  need_new_j = 0;
+	}
+	ode23tb_init_wt(normcontrol,ny,normy,threshold,y,wt);
+	/*
+	  miter = I - gamma*h*dfdy, and its LU factors.
+	*/
+	success = ode23tb_build_factor_miter(ny,nysq,gamma,h,dfdy,
+					     miter,ipivot,&info,lfp);
+	if (success == 0) {
+	  break;
+	}
+	ndecomps += 1;
+	hg = gamma * h;
+	/*
+	  Stage 1.
+	*/
+	dcopy_(&ny,f0,&inc1,u1,&inc1);
+	dscal_(&ny,&hg,u1,&inc1);
+	dgetrs_(trans,&ny,&nrhs,miter,&ny,ipivot,u1,&ny,&info,1);
+	/*
+	  Stage 2.
+	*/
+	if (info == 0) {
+	  dcopy_(&ny,y,&inc1,ytmp,&inc1);
+	  daxpy_(&ny,&a21,u1,&inc1,ytmp,&inc1);
+	  gradient(state,ytmp,fs,gradient_choice);
+	  dcopy_(&ny,fs,&inc1,u2,&inc1);
+	  dscal_(&ny,&hg,u2,&inc1);
+	  scalar = gamma * c21;
+	  daxpy_(&ny,&scalar,u1,&inc1,u2,&inc1);
+	  dgetrs_(trans,&ny,&nrhs,miter,&ny,ipivot,u2,&ny,&info,1);
+	}
+	/*
+	  Stage 3.
+	*/
+	if (info == 0) {
+	  dcopy_(&ny,y,&inc1,ytmp,&inc1);
+	  daxpy_(&ny,&a31,u1,&inc1,ytmp,&inc1);
+	  daxpy_(&ny,&a32,u2,&inc1,ytmp,&inc1);
+	  gradient(state,ytmp,fs,gradient_choice);
+	  dcopy_(&ny,fs,&inc1,u3,&inc1);
+	  dscal_(&ny,&hg,u3,&inc1);
+	  scalar = gamma * c31;
+	  daxpy_(&ny,&scalar,u1,&inc1,u3,&inc1);
+	  scalar = gamma * c32;
+	  daxpy_(&ny,&scalar,u2,&inc1,u3,&inc1);
+	  dgetrs_(trans,&ny,&nrhs,miter,&ny,ipivot,u3,&ny,&info,1);
+	}
+	if (info != 0) {
+	  success = 0;
+	  if (lfp) {
+	    fprintf(lfp,"ode_ros3p: dgetrs_ call to compute stages failed "
+		    "with info = %d\n",info);
+	    fflush(lfp);
+	  }
+	  break;
+	}
+	nfevals += 2;
+	nsolves += 3;
+	/*
+	  ynew = y + (u1,u2,u3) * ynew_coeff,
+	  est  = (u1,u2,u3) * est_coeff.
+	*/
+	scalar = 1.0;
+	dcopy_(&ny,y,&inc1,ynew,&inc1);
+	dgemv_(trans,&ny,&ithree,&scalar,u,&ny,ynew_coeff,&inc1,
+	       &scalar,ynew,&inc1,1);
+	dgemv_(trans,&ny,&ithree,&scalar,u,&ny,est_coeff,&inc1,
+	       &dzero,est,&inc1,1);
+	normynew = fabs(ynew[idamax_(&ny,ynew,&inc1)-1]);
+	ode23tb_update_wt(normcontrol,ny,normynew,ynew,wt);
+	err = ode23tb_max_abs_ratio(ny,est,wt);
+	nnrejectstep = 0;
+	if (nonnegative) {
+	  errnn_scale  = 1.0/threshold;
+	  ode23tb_nonneg_err(ny,ynew,rtol,errnn_scale,&err,&nnrejectstep);
+	}
+	if (err > rtol) {
+	  /*
+	    Step failed, the jacobian at y is still good, only
+	    miter needs to be refactored for the smaller step.
+	  */
+	  nfailed += 1;
+	  if (absh <= hmin) {
+	    if (lfp) {
+	      fprintf(lfp,"ode_ros3p: Error integration tolerance not met, "
+		      "t= %le, hmin = %le\n",t,hmin);
+	      fflush(lfp);
+	    }
+	    success = 0;
+	    break;
+	  }
+	  if (nnrejectstep) {
+	    absh = 0.5 * absh;
+	  } else {
+	    h_ratio = 0.7 * pow((rtol/err),third);
+	    if (0.1 > h_ratio) {
+	      h_ratio = 0.1;
+	    }
+	    absh = h_ratio * absh;
+	  }
+	  if (hmin > absh) {
+	    absh = hmin;
+	  }
+	  h = tdir * absh;
+	  done = 0;
+	} else {
+	  accepted = 1;
+	}
+      } /* end while (accepted == 0) */
+      if (success == 0) {
+	break;
+      }
+      nsteps += 1;
+      tnew = t + h;
+      if (done) {
+	tnew = tfinal;
+      }
+      if (nonnegative) {
+	ode23tb_enforce_nonneg(ny,normcontrol,ynew,fnew,&normynew);
+      }
+      gradient(state,ynew,fnew,gradient_choice);
+      nfevals += 1;
+      /*
+	Print the dense output times in (t,tnew] from the
+	Hermite interpolant of the step, z = h*f.
+      */
+      if (dense_output) {
+	dcopy_(&ny,f0,&inc1,z,&inc1);
+	dscal_(&ny,&h,z,&inc1);
+	dcopy_(&ny,fnew,&inc1,znew,&inc1);
+	dscal_(&ny,&h,znew,&inc1);
+      }
+      while (dense_output && (dense_k <= dense_output) &&
+	     (t_dense <= tnew)) {
+	s_dense = (t_dense - t)/h;
+	ode23tb_hermite(ny,s_dense,y,z,ynew,znew,y_dense);
+	ode_print_concs(state,t_dense,y_dense);
+	dense_k += 1;
+	if (dense_k <= dense_output) {
+	  t_dense = ode_dense_output_time(state,dense_k);
+	}
+      }
+      t = tnew;
+      dcopy_(&ny,ynew,&inc1,y,&inc1);
+      dcopy_(&ny,fnew,&inc1,f0,&inc1);
+      normy = normynew;
+      need_new_j = 1;
+      if (ode_rxn_view_freq > 0) {
+	ode_rxn_view_step -= one_l;
+	if (ode_rxn_view_step == zero_l) {
+	  boltzmann_monitor_ode(state,t,y);
+	  ode_rxn_view_step = ode_rxn_view_freq;
+	}
+      }
+      /*
+	Next step size, h_ratio = min(5,max(0.2,0.8*(rtol/err)^(1/3))).
+      */
+      if (err > 0.0) {
+	h_ratio = 0.8 * pow((rtol/err),third);
+      } else {
+	h_ratio = 5.0;
+      }
+      if (.2 > h_ratio) {
+	h_ratio = .2;
+      }
+      if (h_ratio > 5.0) {
+	h_ratio = 5.0;
+      }
+      absh = h_ratio * absh;
+      if (done) {
+	not_done = 0;
+      } else {
+	done = ode_test_steady_state(state,ny,y,f0);
+	if (done) {
+	  not_done = 0;
+	}
+      }
+    } /* end while (not_done) MAIN loop */
+    if (lfp && print_output) {
+      fprintf(lfp,"ode_ros3p: t = %le, %ld steps, %ld failed, %ld gradients, "
+	      "%ld jacobians, %ld LU decompositions, %ld solves\n",
+	      t,nsteps,nfailed,nfevals,npds,ndecomps,nsolves);
+      fflush(lfp);
+    }
+  } /* end if success - allocation succeeded */
+  if (dfdy != NULL) {
+    dcopy_(&ny,y,&inc1,concs,&inc1);
+    free(dfdy);
+    ode23tb_params->dfdy = NULL;
+  }
+  if (drfc != NULL) {
+    free(drfc);
+    cvodes_params->drfc = NULL;
+  }
+  return (success);
+}
@@ -0,0 +1,4 @@
+#ifndef _ODE_ROS3P_H_
+#define _ODE_ROS3P_H_ 1
+extern int ode_ros3p (struct state_struct *state, double *concs);
+#endif
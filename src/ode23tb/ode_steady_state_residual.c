@@ -0,0 +1,86 @@
+#include "boltzmann_structs.h"
+#include "blas.h"
+#include "gradient.h"
+#include "ode_steady_state_residual.h"
+double ode_steady_state_residual(struct state_struct *state,
+				 int ny,
+				 double *y,
+				 double *f) {
+  /*
+    Return the steady state residual 
+      ||f||_a - threshold              if ode_stop_rel is 0,
+      ||f||_a - threshold * ||y||_a    if ode_stop_rel is 1,
+    where f is computed from y with the gradient routine and
+    ||.||_a is the infinity, 1, or 2 norm for ode_stop_norm = 0, 1, or 2.
+    Steady state is reached when the residual is negative, it is
+    continuous in y so it also serves as the cvodes root function.
+   
+    Called by ode_test_steady_state, boltzmann_cvodes_ss_root
+    Calls: gradient, idamax_, dnrm2_, fabs
+  */
+  double ode_stop_thresh;
+  double fnorm;
+  double ynorm;
+  double residual;
+  int gradient_choice;
+  int ode_stop_rel;
+
+  int ode_stop_norm;
+  int incx;
+
+  int i;
+  int padi;
+
+  ny                 = state->nunique_molecules;
+  gradient_choice    = state->gradient_choice;
+  ode_stop_thresh    = state->ode_stop_thresh;
+  ode_stop_rel       = state->ode_stop_rel;
+  ode_stop_norm      = state->ode_stop_norm;
+  incx               = 1;
+
+  gradient(state,y,f,gradient_choice);
+  if (ode_stop_norm == 1) {
+    /*
+      Use the 1 norm.
+    */
+    fnorm = 0.0;
+    for (i=0;i<ny;i++) {
+      fnorm += fabs(f[i]);
+    }
+  } else if (ode_stop_norm == 2) {
+    /*
+      Use the 2 norm.
+    */
+    fnorm = dnrm2_(&ny,f,&incx);
+  } else {
+    /*
+      Use the infinity norm - note idamax_ is a fortran function and
+      returns a fortran index from which we must subtract 1.
+    */
+    fnorm = fabs(f[idamax_(&ny,f,&incx)-1]);
+  }
+  if (ode_stop_rel) {
+    if (ode_stop_norm == 1) {
+      /*
+	Use the 1 norm.
+      */
+      ynorm = 0.0;
+      for (i=0;i<ny;i++) {
+	ynorm += fabs(y[i]);
+      }
+    } else if (ode_stop_norm == 2) {
+      /*
+	Use the 2 norm.
+      */
+      ynorm = dnrm2_(&ny,y,&incx);
+    } else {
+      /*
+	Use the infinity norm
+      */
+      ynorm = fabs(y[idamax_(&ny,y,&incx)-1]);
+    } 
+    ode_stop_thresh = ode_stop_thresh * ynorm;
+  } /* end if ode_stop_rel */
+  residual = fnorm - ode_stop_thresh;
+  return(residual);
+}
@@ -0,0 +1,7 @@
+#ifndef _ODE_STEADY_STATE_RESIDUAL_H_
+#define _ODE_STEADY_STATE_RESIDUAL_H_ 1
+extern double ode_steady_state_residual(struct state_struct *state,
+					int ny,
+					double *y,
+					double *f);
+#endif
@@ -0,0 +1 @@
+ode23tb/ode23tb_hermite.c
\ No newline at end of file
@@ -0,0 +1 @@
+ode23tb/ode_dense_output_time.c
\ No newline at end of file
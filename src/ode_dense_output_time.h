@@ -0,0 +1 @@
+ode23tb/ode_dense_output_time.h
\ No newline at end of file
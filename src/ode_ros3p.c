@@ -0,0 +1 @@
+ode23tb/ode_ros3p.c
\ No newline at end of file
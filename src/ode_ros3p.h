@@ -0,0 +1 @@
+ode23tb/ode_ros3p.h
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "boltzmann_structs.h"
 #include "ode23tb.h"
 #include "boltzmann_cvodes.h"
+#include "ode_ros3p.h"
 #include "compute_dfdke_dfdmu0.h"
 #include "ode_solver.h"
 int ode_solver (struct state_struct *state, double *concs, int choice) {
@@ -8,6 +9,7 @@ int ode_solver (struct state_struct *state, double *concs, int choice) {
     Called by: deq_run
     Calls:     ode23tb
                boltzmann_cvodes,
+               ode_ros3p,
                
                concs is the vector of molecule concentrations, 
 	       the concs_to_counts field in state can be used
@@ -19,8 +21,9 @@ int ode_solver (struct state_struct *state, double *concs, int choice) {
                htry, nonnegative, normcontrol, and print_concs are
 	       all input variables to ode23tb the default ode solver.
 
-	       choice is meant to be the indicator of which solver
-	       to use, right now we only offer ode23tb.
+	       choice is the indicator of which solver to use,
+	       0 for ode23tb, 1 for cvodes and 2 for the ode_ros3p
+	       Rosenbrock method.
 
 	       Other solvers could pass their arguments, if different
 	       through state. 
@@ -44,6 +47,9 @@ int ode_solver (struct state_struct *state, double *concs, int choice) {
   case 1:
     success = boltzmann_cvodes(state,concs);
     break;
+  case 2:
+    success = ode_ros3p(state,concs);
+    break;
   default:
     if (lfp) {
       fprintf(lfp,"ode_solver: invalid ode_solver_choice, using default\n");
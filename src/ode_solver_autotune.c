@@ -0,0 +1,311 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_cvodes_headers.h"
+#include "cvodes_params_struct.h"
+#include "boltzmann_size_jacobian.h"
+#include "boltzmann_cvodes_free.h"
+#include "ode_solver.h"
+#include "ode_solver_autotune.h"
+#include <sys/time.h>
+#define OSA_NUM_CANDIDATES 8
+int ode_solver_autotune(struct state_struct *state, double *concs) {
+  /*
+    Select the ode solver for ODE_SOLVER_CHOICE AUTO (ode_solver_choice -1).
+    Each candidate solver configuration integrates the odes from concs
+    to the probe time ode_auto_probe_t (ode_t_final/100 if 0) with
+    output turned off, cvodes candidates limited to ode_auto_probe_steps
+    steps per output interval. The fastest candidate that reaches the
+    probe time is chosen and its settings are left in state and
+    cvodes_params. concs is not changed.
+    Candidates:
+      0 cvodes Adams with functional iteration, for nonstiff problems,
+      1 cvodes BDF with GMRES and no preconditioner,
+      2-4 cvodes BDF with GMRES preconditioned by ILU(k), k = 0,1,2,
+      5 cvodes BDF with the sparse direct solver (CVODES_SOLVER SLU),
+      6 ode_ros3p, only with ODE_JACOBIAN_CHOICE 8,
+      7 ode23tb, only for ny <= 200 as it forms a dense jacobian.
+    The ILU(k) candidates are skipped when the jacobian bound has more than
+    a quarter of the ny*ny entries, as the factors are then nearly
+    complete and SLU covers them. The problem size, the probe timings and counters
+    (steps, rhs evaluations, error test and Newton convergence failures,
+    Newton and Krylov iterations, last step size) and the choice are
+    written to the log file so that the choice can be reproduced by
+    setting it in the parameter file.
+    The probes are run without sensitivities, so nothing is written to
+    the sensitivity file, but only cvodes BDF is tried when sensitivities
+    are requested.
+    Returns 1 on success, 0 if no candidate reached the probe time.
+    Called by: deq_run
+    Calls:     boltzmann_size_jacobian,
+               ode_solver,
+	       boltzmann_cvodes_free,
+	       CVodeGetNumSteps, CVodeGetNumRhsEvals,
+	       CVodeGetNumErrTestFails, CVodeGetNumNonlinSolvIters,
+	       CVodeGetNumNonlinSolvConvFails, CVodeGetLastStep,
+	       CVSpilsGetNumLinIters,
+	       gettimeofday, calloc, free, fprintf, fflush
+  */
+  static const char *names[OSA_NUM_CANDIDATES] = {
+    "cvodes ADAMS FUNCTIONAL",
+    "cvodes BDF GMRES",
+    "cvodes BDF GMRES ILU(0)",
+    "cvodes BDF GMRES ILU(1)",
+    "cvodes BDF GMRES ILU(2)",
+    "cvodes BDF SLU",
+    "ros3p",
+    "ode23tb"
+  };
+  /*
+    ode_solver choice, multistep method, iteration, linear solver,
+    preconditioner type and ILU fill level of the candidates.
+  */
+  static const int solvers[OSA_NUM_CANDIDATES]   = {1,1,1,1,1,1,2,0};
+  static const int lmms[OSA_NUM_CANDIDATES]      = {CV_ADAMS,CV_BDF,CV_BDF,
+						    CV_BDF,CV_BDF,CV_BDF,
+						    CV_BDF,CV_BDF};
+  static const int iters[OSA_NUM_CANDIDATES]     = {CV_FUNCTIONAL,CV_NEWTON,
+						    CV_NEWTON,CV_NEWTON,
+						    CV_NEWTON,CV_NEWTON,
+						    CV_NEWTON,CV_NEWTON};
+  static const int lsolvers[OSA_NUM_CANDIDATES]  = {0,0,0,0,0,10,0,0};
+  static const int pretypes[OSA_NUM_CANDIDATES]  = {PREC_NONE,PREC_NONE,
+						    PREC_LEFT,PREC_LEFT,
+						    PREC_LEFT,PREC_NONE,
+						    PREC_NONE,PREC_NONE};
+  static const int fills[OSA_NUM_CANDIDATES]     = {0,0,0,1,2,0,0,0};
+  struct cvodes_params_struct *cvodes_params;
+  struct timeval tv0;
+  struct timeval tv1;
+  void *cvode_mem;
+  double *probe_concs;
+  double ode_t_final;
+  double probe_t;
+  double secs;
+  double best_secs;
+  double hlast;
+  double density;
+  int64_t one_l;
+  int64_t ask_for;
+  int64_t print_output;
+  int64_t ode_rxn_view_freq;
+  int64_t ode_dense_output;
+  int64_t compute_sensitivities;
+  int64_t prec_choice;
+  int64_t prec_fill;
+  long int nst;
+  long int nfe;
+  long int netf;
+  long int nni;
+  long int ncfn;
+  long int nli;
+
+  int lmm;
+  int iter;
+
+  int linear_solver_method;
+  int pretype;
+
+  int ordering;
+  int mxsteps;
+
+  int reuse_context;
+  int ny;
+
+  int nnz;
+  int c;
+
+  int best;
+  int i;
+
+  int ok;
+  int skip;
+
+  int success;
+  int padi;
+
+  FILE *lfp;
+  FILE *efp;
+  success       = 1;
+  one_l         = (int64_t)1;
+  lfp           = state->lfp;
+  ny            = (int)state->nunique_molecules;
+  cvodes_params = state->cvodes_params;
+  ask_for       = ((int64_t)ny) * ((int64_t)sizeof(double));
+  probe_concs   = (double *)calloc(one_l,ask_for);
+  if (probe_concs == NULL) {
+    success = 0;
+    if (lfp) {
+      fprintf(lfp,"ode_solver_autotune: Error unable to allocate %ld bytes "
+	      "for probe_concs\n",ask_for);
+      fflush(lfp);
+    }
+  }
+  if (success) {
+    /*
+      Save the settings the probes change.
+    */
+    ode_t_final           = state->ode_t_final;
+    print_output          = state->print_output;
+    ode_rxn_view_freq     = state->ode_rxn_view_freq;
+    ode_dense_output      = state->ode_dense_output;
+    compute_sensitivities = state->compute_sensitivities;
+    prec_choice           = state->cvodes_prec_choice;
+    prec_fill             = state->cvodes_prec_fill;
+    lmm                   = cvodes_params->linear_multistep_method;
+    iter                  = cvodes_params->iterative_method;
+    linear_solver_method  = cvodes_params->linear_solver_method;
+    pretype               = cvodes_params->pretype;
+    ordering              = cvodes_params->sparse_matrix_ordering_alg;
+    mxsteps               = cvodes_params->mxsteps;
+    reuse_context         = cvodes_params->reuse_context;
+    probe_t               = state->ode_auto_probe_t;
+    if (probe_t <= 0.0) {
+      probe_t = ode_t_final * 0.01;
+    }
+    boltzmann_size_jacobian(state);
+    nnz     = cvodes_params->nnz;
+    density = ((double)nnz)/(((double)ny)*((double)ny));
+    if (lfp) {
+      fprintf(lfp,"ode_solver_autotune: ny = %d, jacobian nnz bound = %d "
+	      "(density %le), probe to t = %le, %ld steps per output\n",
+	      ny,nnz,density,probe_t,state->ode_auto_probe_steps);
+      fprintf(lfp,"ode_solver_autotune: candidate\tseconds\tsteps\t"
+	      "rhs_evals\terr_test_fails\tnewton_iters\tnewton_conv_fails\t"
+	      "krylov_iters\tlast_h\n");
+      fflush(lfp);
+    }
+    state->ode_t_final           = probe_t;
+    state->print_output          = (int64_t)0;
+    state->ode_dense_output      = (int64_t)0;
+    state->ode_rxn_view_freq     = (int64_t)0;
+    state->compute_sensitivities = (int64_t)0;
+    cvodes_params->mxsteps       = (int)state->ode_auto_probe_steps;
+    cvodes_params->reuse_context = 1;
+    best      = -1;
+    best_secs = 0.0;
+    for (c=0;c<OSA_NUM_CANDIDATES;c++) {
+      skip = ((solvers[c] == 2) && (state->ode_jacobian_choice != 8)) ||
+	((solvers[c] == 0) && (ny > 200)) ||
+	((pretypes[c] != PREC_NONE) && (density > 0.25)) ||
+	(compute_sensitivities && 
+	 ((solvers[c] != 1) || (lmms[c] != CV_BDF)));
+      if (skip) {
+	if (lfp) {
+	  fprintf(lfp,"ode_solver_autotune: %s\tskipped\n",names[c]);
+	  fflush(lfp);
+	}
+	continue;
+      }
+      /*
+	approximate_jacobian converts the jacobian for the solver
+	in ode_solver_choice.
+      */
+      state->ode_solver_choice     = (int64_t)solvers[c];
+      state->cvodes_prec_choice    = (int64_t)2;
+      state->cvodes_prec_fill      = (int64_t)fills[c];
+      cvodes_params->cvodes_prec_choice      = 2;
+      cvodes_params->prec_fill               = fills[c];
+      cvodes_params->linear_multistep_method = lmms[c];
+      cvodes_params->iterative_method        = iters[c];
+      cvodes_params->linear_solver_method    = lsolvers[c];
+      cvodes_params->pretype                 = pretypes[c];
+      if (lsolvers[c] == 10) {
+	cvodes_params->sparse_matrix_ordering_alg = 2;
+      } else {
+	cvodes_params->sparse_matrix_ordering_alg = ordering;
+      }
+      for (i=0;i<ny;i++) {
+	probe_concs[i] = concs[i];
+      }
+      gettimeofday(&tv0,NULL);
+      ok = ode_solver(state,probe_concs,solvers[c]);
+      gettimeofday(&tv1,NULL);
+      secs = ((double)(tv1.tv_sec - tv0.tv_sec)) +
+	1.0e-6 * ((double)(tv1.tv_usec - tv0.tv_usec));
+      nst  = 0;
+      nfe  = 0;
+      netf = 0;
+      nni  = 0;
+      ncfn = 0;
+      nli  = 0;
+      hlast = 0.0;
+      cvode_mem = cvodes_params->cvode_mem;
+      if ((solvers[c] == 1) && (cvode_mem != NULL)) {
+	/*
+	  The context is kept (reuse_context) so its counters can be read.
+	*/
+	CVodeGetNumSteps(cvode_mem,&nst);
+	CVodeGetNumRhsEvals(cvode_mem,&nfe);
+	CVodeGetNumErrTestFails(cvode_mem,&netf);
+	CVodeGetNumNonlinSolvIters(cvode_mem,&nni);
+	CVodeGetNumNonlinSolvConvFails(cvode_mem,&ncfn);
+	CVodeGetLastStep(cvode_mem,&hlast);
+	if ((iters[c] == CV_NEWTON) && (lsolvers[c] != 10)) {
+	  CVSpilsGetNumLinIters(cvode_mem,&nli);
+	}
+      }
+      boltzmann_cvodes_free(state);
+      if (lfp) {
+	fprintf(lfp,"ode_solver_autotune: %s\t%le\t%ld\t%ld\t%ld\t%ld\t%ld\t"
+		"%ld\t%le%s\n",names[c],secs,nst,nfe,netf,nni,ncfn,nli,hlast,
+		ok ? "" : "\tfailed");
+	fflush(lfp);
+      }
+      if (ok && ((best < 0) || (secs < best_secs))) {
+	best      = c;
+	best_secs = secs;
+      }
+    } /* end for (c...) */
+    /*
+      Restore the settings, then apply the chosen candidate.
+    */
+    state->ode_t_final           = ode_t_final;
+    state->print_output          = print_output;
+    state->ode_rxn_view_freq     = ode_rxn_view_freq;
+    state->ode_dense_output      = ode_dense_output;
+    state->compute_sensitivities = compute_sensitivities;
+    state->cvodes_prec_choice    = prec_choice;
+    state->cvodes_prec_fill      = prec_fill;
+    cvodes_params->cvodes_prec_choice         = (int)prec_choice;
+    cvodes_params->prec_fill                  = (int)prec_fill;
+    cvodes_params->linear_multistep_method    = lmm;
+    cvodes_params->iterative_method           = iter;
+    cvodes_params->linear_solver_method       = linear_solver_method;
+    cvodes_params->pretype                    = pretype;
+    cvodes_params->sparse_matrix_ordering_alg = ordering;
+    cvodes_params->mxsteps                    = mxsteps;
+    cvodes_params->reuse_context              = reuse_context;
+    state->ode_solver_choice     = (int64_t)-1;
+    if (best < 0) {
+      success = 0;
+      if (lfp) {
+	fprintf(lfp,"ode_solver_autotune: Error no candidate reached the "
+		"probe time\n");
+	fflush(lfp);
+      }
+    } else {
+      state->ode_solver_choice = (int64_t)solvers[best];
+      if (solvers[best] == 1) {
+	cvodes_params->linear_multistep_method = lmms[best];
+	cvodes_params->iterative_method        = iters[best];
+	cvodes_params->linear_solver_method    = lsolvers[best];
+	cvodes_params->pretype                 = pretypes[best];
+	if (lsolvers[best] == 10) {
+	  cvodes_params->sparse_matrix_ordering_alg = 2;
+	}
+	if (pretypes[best] != PREC_NONE) {
+	  state->cvodes_prec_choice         = (int64_t)2;
+	  state->cvodes_prec_fill           = (int64_t)fills[best];
+	  cvodes_params->cvodes_prec_choice = 2;
+	  cvodes_params->prec_fill          = fills[best];
+	}
+      }
+      if (lfp) {
+	fprintf(lfp,"ode_solver_autotune: chose %s, ODE_SOLVER_CHOICE %d\n",
+		names[best],solvers[best]);
+	fflush(lfp);
+      }
+    }
+    free(probe_concs);
+  }
+  return(success);
+}
@@ -0,0 +1,4 @@
+#ifndef _ODE_SOLVER_AUTOTUNE_H_
+#define _ODE_SOLVER_AUTOTUNE_H_ 1
+extern int ode_solver_autotune(struct state_struct *state, double *concs);
+#endif
@@ -0,0 +1 @@
+ode23tb/ode_steady_state_residual.c
\ No newline at end of file
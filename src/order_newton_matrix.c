@@ -0,0 +1,101 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_cvodes_headers.h"
+#include "cvodes_params_struct.h"
+#include "species_graph.h"
+#include "rcm_order.h"
+#include "min_degree_order.h"
+#include "order_newton_matrix.h"
+int order_newton_matrix(struct state_struct *state) {
+  /*
+    Set the perm and iperm fields of cvodes_params to the symmetric
+    permutation applied to the Newton iteration matrix M before it is
+    factored by precondition_newton_matrix.
+    The ordering is selected by the sparse_matrix_ordering_alg field
+    of cvodes_params (CVODES_PREC_ORDERING keyword):
+      0 natural order,
+      1 reverse Cuthill-McKee, which reduces the bandwidth/profile,
+      2 minimum degree, which reduces the fill in the factors.
+    Both are computed once from the molecule-reaction graph as that
+    determines the nonzero structure of the Jacobian.
+    If the ordering can not be computed the natural order is used.
+    Called by: boltzmann_cvodes
+    Calls:     species_graph, rcm_order, min_degree_order,
+               calloc, free, fprintf, fflush
+  */
+  struct cvodes_params_struct *cvodes_params;
+  int *perm;
+  int *iperm;
+  int *adj_ptr;
+  int *adj;
+  int *mask;
+  int *deg;
+  int *level;
+  int64_t one_l;
+  int64_t ask_for;
+  
+  int success;
+  int ny;
+
+  int alg;
+  int max_adj;
+
+  int i;
+  int ok;
+
+  FILE *lfp;
+  FILE *efp;
+
+  success       = 1;
+  one_l         = (int64_t)1;
+  lfp           = state->lfp;
+  ny            = state->nunique_molecules;
+  cvodes_params = state->cvodes_params;
+  alg           = cvodes_params->sparse_matrix_ordering_alg;
+  perm          = cvodes_params->perm;
+  iperm         = cvodes_params->iperm;
+  mask          = cvodes_params->lindex;
+  deg           = cvodes_params->uindex;
+  level         = cvodes_params->sindex;
+  max_adj       = cvodes_params->nnz;
+  ok            = 0;
+  if (alg != 0) {
+    ask_for = ((int64_t)(ny + 1 + max_adj)) * ((int64_t)sizeof(int));
+    adj_ptr = (int *)calloc(one_l,ask_for);
+    if (adj_ptr == NULL) {
+      if (lfp) {
+	fprintf(lfp,"order_newton_matrix: Warning unable to allocate %ld "
+		"bytes for the species graph, using natural order\n",ask_for);
+	fflush(lfp);
+      }
+    } else {
+      adj = &adj_ptr[ny+1];
+      ok = species_graph(state,max_adj,adj_ptr,adj,mask);
+      if (ok) {
+	if (alg == 1) {
+	  rcm_order(ny,adj_ptr,adj,perm,mask,deg,level);
+	} else {
+	  ok = min_degree_order(ny,adj_ptr,adj,perm,mask,deg,level);
+	}
+      }
+      if ((ok == 0) && lfp) {
+	fprintf(lfp,"order_newton_matrix: Warning unable to compute "
+		"ordering %d, using natural order\n",alg);
+	fflush(lfp);
+      }
+      free(adj_ptr);
+    }
+  }
+  if (ok == 0) {
+    cvodes_params->sparse_matrix_ordering_alg = 0;
+    for (i=0;i<ny;i++) {
+      perm[i] = i;
+    }
+  }
+  for (i=0;i<ny;i++) {
+    iperm[perm[i]] = i;
+  }
+  for (i=0;i<ny;i++) {
+    mask[i] = 0;
+  }
+  return(success);
+}
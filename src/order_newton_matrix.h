@@ -0,0 +1,4 @@
+#ifndef _ORDER_NEWTON_MATRIX_H_
+#define _ORDER_NEWTON_MATRIX_H_ 1
+extern int order_newton_matrix(struct state_struct *state);
+#endif
@@ -2,6 +2,10 @@
 #include "boltzmann_cvodes_headers.h"
 #include "cvodes_params_struct.h"
 #include "iluvf.h"
+#include "iluk.h"
+#include "compartment_block_matrix.h"
+#include "sparse_lu_symbolic.h"
+#include "sparse_lu_factor.h"
 #include "precondition_newton_matrix.h"
 int precondition_newton_matrix(struct state_struct *state) {
   /*
@@ -12,11 +16,17 @@ int precondition_newton_matrix(struct state_struct *state) {
     state.
     Produces lower and upper triangluar factors in prec_l, prec_il, pred_jl,
     prec_u, prec_iu, and prec_ju arrays (also fields of cvodes_params).
+    M has already been symmetrically permuted by build_newton_matrix
+    according to the perm field of cvodes_params.
     Called by: boltzmann_cvodes_psetup
+    Calls:     iluk, iluvf, compartment_block_matrix, sparse_lu_symbolic,
+               sparse_lu_factor
   */
+  struct cvodes_params_struct *cvodes_params;
   int choice;
   int success;
 
+  cvodes_params = state->cvodes_params;
   choice        = state->cvodes_prec_choice;
   success       = 1;  
   switch (choice) {
@@ -33,9 +43,10 @@ int precondition_newton_matrix(struct state_struct *state) {
     break;
   case 2:
     /*
-      This might be the traditional ILU preconditioner.
+      Traditional level of fill ILU(k) preconditioner, with k the fill
+      level.
     */
-    success = 0;
+    success  = iluk(state);
     break;
   case 3:
     /*
@@ -47,6 +58,34 @@ int precondition_newton_matrix(struct state_struct *state) {
     */
     success  = iluvf(state);
     break;
+  case 4:
+    /*
+      Compartment block preconditioner: the coupling between
+      compartments, through the few transport reactions, is dropped and
+      each compartment block of M is factored exactly. The blocks do not
+      interact so the complete LU factorization of the block diagonal
+      matrix has no fill between them. The factor structure is computed
+      on the first call and reused.
+    */
+    success = compartment_block_matrix(state);
+    if (success) {
+      if (cvodes_params->slu_factors == NULL) {
+	success = sparse_lu_symbolic(state);
+      }
+    }
+    if (success) {
+      success = sparse_lu_factor(state);
+      if (success == -1) {
+	success = sparse_lu_symbolic(state);
+	if (success) {
+	  success = sparse_lu_factor(state);
+	}
+      }
+      if (success == -1) {
+	success = 0;
+      }
+    }
+    break;
   }
   return(success);
 }
@@ -0,0 +1 @@
+tools/print_sweep_results.c
\ No newline at end of file
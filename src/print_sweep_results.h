@@ -0,0 +1 @@
+tools/print_sweep_results.h
\ No newline at end of file
@@ -0,0 +1,157 @@
+#include "boltzmann_structs.h"
+#include "rcm_order.h"
+void rcm_order(int n,
+	       int *adj_ptr,
+	       int *adj,
+	       int *perm,
+	       int *mask,
+	       int *deg,
+	       int *level) {
+  /*
+    Compute a reverse Cuthill-McKee ordering of the undirected graph
+    with n vertices whose adjacency lists are in adj[adj_ptr[i]:adj_ptr[i+1]-1]
+    (no self edges). On return perm[new] = old.
+    Each connected component is started from a pseudo-peripheral vertex
+    found by repeated breadth first searches from a minimum degree vertex
+    (George and Liu), neighbors are numbered in increasing degree order,
+    and the final Cuthill-McKee ordering is reversed.
+    mask, deg and level are scratch vectors of length n.
+    Called by: order_newton_matrix
+  */
+  int num;
+  int root;
+
+  int stamp;
+  int i;
+
+  int j;
+  int k;
+
+  int v;
+  int w;
+
+  int head;
+  int tail;
+
+  int first;
+  int mindeg;
+
+  int ecc;
+  int last;
+
+  int cand;
+  int iter;
+
+  for (i=0;i<n;i++) {
+    mask[i] = 0;
+    deg[i]  = adj_ptr[i+1] - adj_ptr[i];
+  }
+  num   = 0;
+  stamp = 0;
+  while (num < n) {
+    /*
+      Start from an unnumbered vertex of minimum degree.
+      Numbered vertices have a mask of -1.
+    */
+    root   = -1;
+    mindeg = n + 1;
+    for (i=0;i<n;i++) {
+      if (mask[i] != -1) {
+	if (deg[i] < mindeg) {
+	  mindeg = deg[i];
+	  root   = i;
+	}
+      }
+    }
+    /*
+      Look for a pseudo-peripheral vertex, using perm[num:n-1] as the
+      breadth first search queue.
+    */
+    ecc = -1;
+    for (iter=0;iter<n;iter++) {
+      stamp += 1;
+      head = num;
+      tail = num;
+      perm[tail] = root;
+      tail += 1;
+      mask[root]  = stamp;
+      level[root] = 0;
+      while (head < tail) {
+	v = perm[head];
+	head += 1;
+	for (j=adj_ptr[v];j<adj_ptr[v+1];j++) {
+	  w = adj[j];
+	  if ((mask[w] != -1) && (mask[w] != stamp)) {
+	    mask[w]  = stamp;
+	    level[w] = level[v] + 1;
+	    perm[tail] = w;
+	    tail += 1;
+	  }
+	}
+      }
+      last = level[perm[tail-1]];
+      if (last <= ecc) {
+	break;
+      }
+      ecc = last;
+      /*
+	Choose a minimum degree vertex in the last level.
+      */
+      cand   = root;
+      mindeg = n + 1;
+      for (k=tail-1;k>=num;k--) {
+	v = perm[k];
+	if (level[v] != last) {
+	  break;
+	}
+	if (deg[v] < mindeg) {
+	  mindeg = deg[v];
+	  cand   = v;
+	}
+      }
+      if (cand == root) {
+	break;
+      }
+      root = cand;
+    } /* end for (iter...) */
+    /*
+      Cuthill-McKee numbering of this component from root.
+    */
+    head = num;
+    tail = num;
+    perm[tail] = root;
+    tail += 1;
+    mask[root] = -1;
+    while (head < tail) {
+      v = perm[head];
+      head += 1;
+      first = tail;
+      for (j=adj_ptr[v];j<adj_ptr[v+1];j++) {
+	w = adj[j];
+	if (mask[w] != -1) {
+	  mask[w] = -1;
+	  /*
+	    Insertion sort the newly numbered neighbors by increasing
+	    degree.
+	  */
+	  k = tail;
+	  while ((k > first) && (deg[perm[k-1]] > deg[w])) {
+	    perm[k] = perm[k-1];
+	    k -= 1;
+	  }
+	  perm[k] = w;
+	  tail += 1;
+	}
+      }
+    }
+    num = tail;
+  } /* end while (num < n) */
+  /*
+    Reverse the ordering.
+  */
+  for (i=0,j=n-1;i<j;i++,j--) {
+    k       = perm[i];
+    perm[i] = perm[j];
+    perm[j] = k;
+  }
+}
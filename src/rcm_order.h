@@ -0,0 +1,10 @@
+#ifndef _RCM_ORDER_H_
+#define _RCM_ORDER_H_ 1
+extern void rcm_order(int n,
+		      int *adj_ptr,
+		      int *adj,
+		      int *perm,
+		      int *mask,
+		      int *deg,
+		      int *level);
+#endif
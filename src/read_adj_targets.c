@@ -0,0 +1 @@
+cvodes_interface/read_adj_targets.c
\ No newline at end of file
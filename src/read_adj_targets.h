@@ -0,0 +1 @@
+cvodes_interface/read_adj_targets.h
\ No newline at end of file
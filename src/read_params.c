@@ -140,6 +140,9 @@ int read_params (char *param_file_name, struct state_struct *state) {
     state->ode_counts_file[0]   = '\0';
     state->ode_sens_file[0]     = '\0';
     state->ode_dsens_file[0]    = '\0';
+    state->ode_adj_target_file[0] = '\0';
+    strcpy(state->codegen_dir,"./");
+    strcpy(state->codegen_cc,"cc");
     state->dfdke_file[0]        = '\0';
     state->dfdmu0_file[0]       = '\0';
     state->cmpts_echo_file[0]   = '\0';
@@ -196,6 +199,24 @@ int read_params (char *param_file_name, struct state_struct *state) {
     state->use_activities      	 = (int64_t)0;
     state->use_deq             	 = (int64_t)0;
     state->use_lsqnonlin       	 = (int64_t)0;
+    state->lsq_max_iters       	 = (int64_t)100;
+    state->lsq_ftol            	 = 1.0e-10;
+    state->lsq_seed_t          	 = 0.0;
+    state->reduce_moieties     	 = (int64_t)0;
+    state->ode_dense_output    	 = (int64_t)0;
+    state->stable_add_choice   	 = (int64_t)0;
+    state->ode_dense_log_t0    	 = 0.0;
+    state->ode_auto_probe_t    	 = 0.0;
+    state->ode_auto_probe_steps	 = (int64_t)500;
+    state->codegen             	 = (int64_t)0;
+    state->hybrid              	 = (int64_t)0;
+    state->hybrid_repartition_steps = (int64_t)10;
+    state->hybrid_count_threshold = 100.0;
+    state->hybrid_rate_threshold = 0.0;
+    state->hybrid_max_dt       	 = 0.0;
+    state->num_agents          	 = (int64_t)0;
+    state->num_workers         	 = (int64_t)0;
+    state->agent_data_compact  	 = (int64_t)0;
     state->no_round_from_deq   	 = (int64_t)0;
     state->adjust_steady_state 	 = (int64_t)0;
     state->print_output        	 = (int64_t)0;
@@ -219,6 +240,7 @@ int read_params (char *param_file_name, struct state_struct *state) {
     state->ode_stop_style      	 = (int64_t)0; /* none: integrate till t_final */
     state->print_ode_concs     	 = (int64_t)0;
     state->compute_sensitivities = (int64_t)0;
+    state->num_threads           = (int64_t)1;
 
     state->default_initial_count = (int64_t)0;
 
@@ -240,14 +262,29 @@ int read_params (char *param_file_name, struct state_struct *state) {
     cvodes_params->maxnef      = 7;
     cvodes_params->maxcor      = 3;
     cvodes_params->maxncf      = 10;
+    /*
+      The steady state root function decreases through 0.
+    */
+    cvodes_params->root_direction        = -1;
+    cvodes_params->no_inactive_root_warn = 1;
     cvodes_params->maxl        = 30;
     cvodes_params->pretype     = PREC_NONE;
     cvodes_params->gstype      = MODIFIED_GS;
     cvodes_params->num_cvode_steps = 100;
+    cvodes_params->adj_steps   = 100;
+    /*
+      Analytic forward sensitivity right hand side.
+    */
+    cvodes_params->sens_rhs_choice = 1;
     /*
       Linear solver choice for cvodes, (CVDense)
     */
     cvodes_params->linear_solver_method = 0;
+    cvodes_params->sparse_matrix_ordering_alg = 0;
+    /*
+      Build and free the cvodes context on every call.
+    */
+    cvodes_params->reuse_context = 0;
 
     param_buffer       = state->param_buffer;
     max_param_line_len = state->max_param_line_len;
@@ -324,6 +361,8 @@ int read_params (char *param_file_name, struct state_struct *state) {
 	sscan_ok = sscanf(value,"%s",state->ode_sens_file);
       } else if (strncmp(key,"ODE_DSENS_FILE",14) == 0) {
 	sscan_ok = sscanf(value,"%s",state->ode_dsens_file);
+      } else if (strncmp(key,"ODE_ADJ_TARGET_FILE",19) == 0) {
+	sscan_ok = sscanf(value,"%s",state->ode_adj_target_file);
       } else if (strncmp(key,"DFDKE_FILE",10) == 0) {
 	sscan_ok = sscanf(value,"%s",state->dfdke_file);
       } else if (strncmp(key,"DFDMU0_FILE",10) == 0) {
@@ -349,16 +388,16 @@ int read_params (char *param_file_name, struct state_struct *state) {
 	sscan_ok = sscanf(value,"%ld",&state->use_metropolis);
       } else if (strncmp(key,"USE_REGULATION",14) == 0) {
 	sscan_ok = sscanf(value,"%ld",&state->use_regulation);
-      } else if (strncmp(value,"CVODES_RHS_CHOICE",17) == 0) {
+      } else if (strncmp(key,"CVODES_RHS_CHOICE",17) == 0) {
 	sscan_ok = sscanf(value,"%ld",&state->cvodes_rhs_choice);
 	cvodes_params->cvodes_rhs_choice = (int)state->cvodes_rhs_choice;
-      } else if (strncmp(value,"CVODES_JTIMES_CHOICE",20) == 0) {
+      } else if (strncmp(key,"CVODES_JTIMES_CHOICE",20) == 0) {
 	sscan_ok = sscanf(value,"%ld",&state->cvodes_jtimes_choice);
 	cvodes_params->cvodes_jtimes_choice = (int)state->cvodes_jtimes_choice;
-      } else if (strncmp(value,"CVODES_PREC_CHOICE",18) == 0) {
+      } else if (strncmp(key,"CVODES_PREC_CHOICE",18) == 0) {
 	sscan_ok = sscanf(value,"%ld",&state->cvodes_prec_choice);
 	cvodes_params->cvodes_prec_choice = (int)state->cvodes_prec_choice;
-      } else if (strncmp(value,"CVODES_PREC_FILL",16) == 0) {
+      } else if (strncmp(key,"CVODES_PREC_FILL",16) == 0) {
 	sscan_ok = sscanf(value,"%ld",&state->cvodes_prec_fill);
 	cvodes_params->prec_fill = (int)state->cvodes_prec_fill;
       } else if (strncmp(key,"ODE_JACOBIAN_CHOICE",19) == 0) {
@@ -412,9 +451,8 @@ int read_params (char *param_file_name, struct state_struct *state) {
 	}
       } else if (strncmp(key,"ODE_STOP_STYLE",14) == 0) {
 	if (strncmp(value,"TIME",4) == 0) {
-	  state->ode_stop_style = 1;
-	}
-	if (strncmp(value,"VEC",3) == 0) {
+	  state->ode_stop_style = 0;
+	} else if (strncmp(value,"VEC",3) == 0) {
 	  state->ode_stop_style = 1;
 	} else {
 	  sscan_ok = sscanf(value,"%d",&ode_stop_style);
@@ -549,6 +587,20 @@ int read_params (char *param_file_name, struct state_struct *state) {
 	if (state->use_activities < 0) {
 	  state->use_activities = 0;
 	}
+      } else if (strncmp(key,"AGENT_DATA_COMPACT",18) == 0) {
+	sscan_ok = sscanf(value,"%ld",&(state->agent_data_compact));
+      } else if (strncmp(key,"NUM_AGENTS",10) == 0) {
+	sscan_ok = sscanf(value,"%ld",&(state->num_agents));
+	if (state->num_agents < 0) {
+	  state->num_agents = 0;
+	}
+      } else if (strncmp(key,"NUM_WORKERS",11) == 0) {
+	sscan_ok = sscanf(value,"%ld",&(state->num_workers));
+      } else if (strncmp(key,"NUM_THREADS",11) == 0) {
+	sscan_ok = sscanf(value,"%ld",&(state->num_threads));
+	if (state->num_threads < 1) {
+	  state->num_threads = 1;
+	}
       } else if (strncmp(key,"USE_DEQ",7) == 0) {
 	sscan_ok = sscanf(value,"%ld",&(state->use_deq));
 	if (state->use_deq < 0) {
@@ -559,6 +611,24 @@ int read_params (char *param_file_name, struct state_struct *state) {
 	if (state->use_lsqnonlin < 0) {
 	  state->use_lsqnonlin = 0;
 	} 
+      } else if (strncmp(key,"LSQ_MAX_ITERS",13) == 0) {
+	sscan_ok = sscanf(value,"%ld",&(state->lsq_max_iters));
+	if (state->lsq_max_iters < 1) {
+	  state->lsq_max_iters = 100;
+	}
+      } else if (strncmp(key,"LSQ_FTOL",8) == 0) {
+	sscan_ok = sscanf(value,"%le",&state->lsq_ftol);
+      } else if (strncmp(key,"LSQ_SEED_T",10) == 0) {
+	sscan_ok = sscanf(value,"%le",&state->lsq_seed_t);
+      } else if (strncmp(key,"REDUCE_MOIETIES",15) == 0) {
+	sscan_ok = sscanf(value,"%ld",&(state->reduce_moieties));
+      } else if (strncmp(key,"ODE_DENSE_OUTPUT",16) == 0) {
+	sscan_ok = sscanf(value,"%ld",&(state->ode_dense_output));
+	if (state->ode_dense_output < 0) {
+	  state->ode_dense_output = 0;
+	}
+      } else if (strncmp(key,"ODE_DENSE_LOG_T0",16) == 0) {
+	sscan_ok = sscanf(value,"%le",&state->ode_dense_log_t0);
       } else if (strncmp(key,"NO_ROUND_FROM_DEQ",17) == 0) {
 	sscan_ok = sscanf(value,"%ld",&(state->no_round_from_deq));
       } else if (strncmp(key,"USE_STEADY_STATE",19) == 0) {
@@ -581,11 +651,49 @@ int read_params (char *param_file_name, struct state_struct *state) {
       } else if (strncmp(key,"BASE_REACTION",13) == 0) {
 	sscan_ok = sscanf(value,"%ld",&(state->base_reaction));
       } else if (strncmp(key,"ODE_SOLVER_CHOICE",17) == 0) {
-	sscan_ok = sscanf(value,"%ld",&(state->ode_solver_choice));
+	if (strncmp(value,"AUTO",4) == 0) {
+	  state->ode_solver_choice = (int64_t)-1;
+	} else {
+	  sscan_ok = sscanf(value,"%ld",&(state->ode_solver_choice));
+	}
+      } else if (strncmp(key,"ODE_AUTO_PROBE_T",16) == 0) {
+	sscan_ok = sscanf(value,"%le",&state->ode_auto_probe_t);
+      } else if (strncmp(key,"ODE_AUTO_PROBE_STEPS",20) == 0) {
+	sscan_ok = sscanf(value,"%ld",&(state->ode_auto_probe_steps));
+	if (state->ode_auto_probe_steps < 1) {
+	  state->ode_auto_probe_steps = (int64_t)500;
+	}
+      } else if (strncmp(key,"CODEGEN_DIR",11) == 0) {
+	sscan_ok = sscanf(value,"%s",state->codegen_dir);
+      } else if (strncmp(key,"CODEGEN_CC",10) == 0) {
+	sscan_ok = sscanf(value,"%s",state->codegen_cc);
+      } else if (strncmp(key,"CODEGEN",7) == 0) {
+	sscan_ok = sscanf(value,"%ld",&(state->codegen));
+      } else if (strncmp(key,"HYBRID_REPARTITION_STEPS",24) == 0) {
+	sscan_ok = sscanf(value,"%ld",&(state->hybrid_repartition_steps));
+	if (state->hybrid_repartition_steps < 1) {
+	  state->hybrid_repartition_steps = (int64_t)1;
+	}
+      } else if (strncmp(key,"HYBRID_COUNT_THRESHOLD",22) == 0) {
+	sscan_ok = sscanf(value,"%le",&state->hybrid_count_threshold);
+      } else if (strncmp(key,"HYBRID_RATE_THRESHOLD",21) == 0) {
+	sscan_ok = sscanf(value,"%le",&state->hybrid_rate_threshold);
+      } else if (strncmp(key,"HYBRID_MAX_DT",13) == 0) {
+	sscan_ok = sscanf(value,"%le",&state->hybrid_max_dt);
+      } else if (strncmp(key,"HYBRID",6) == 0) {
+	sscan_ok = sscanf(value,"%ld",&(state->hybrid));
       } else if (strncmp(key,"DELTA_CONCS_CHOICE",18) == 0) {
 	sscan_ok = sscanf(value,"%ld",&(state->gradient_choice));
       } else if (strncmp(key,"GRADIENT_CHOICE",18) == 0) {
 	sscan_ok = sscanf(value,"%ld",&(state->gradient_choice));
+      } else if (strncmp(key,"STABLE_ADD_CHOICE",17) == 0) {
+	if (strncmp(value,"SORT",4) == 0) {
+	  state->stable_add_choice = (int64_t)0;
+	} else if (strncmp(value,"NEUMAIER",8) == 0) {
+	  state->stable_add_choice = (int64_t)1;
+	} else {
+	  sscan_ok = sscanf(value,"%ld",&(state->stable_add_choice));
+	}
       } else if (strncmp(key,"PRINT_OUTPUT",12) == 0) {
 	sscan_ok = sscanf(value,"%ld",&(state->print_output));
       } else if (strncmp(key,"RECORD_STEPS",12) == 0) {
@@ -633,6 +741,13 @@ int read_params (char *param_file_name, struct state_struct *state) {
 	  cvodes_params->linear_solver_method = 8; /* PBCG */
 	} else if (strncmp(value,"TFQMR",5) == 0) {
 	  cvodes_params->linear_solver_method = 9; /* PTFQMR */
+	} else if (strncmp(value,"SLU",3) == 0) {
+	  /*
+	    In-tree sparse direct solver, minimum degree ordering unless
+	    a later CVODES_PREC_ORDERING line says otherwise.
+	  */
+	  cvodes_params->linear_solver_method = 10; /* SLU */
+	  cvodes_params->sparse_matrix_ordering_alg = 2;
 	}
       } else if (strncmp(key,"CVODES_MAX_ORD",14) == 0) {
 	sscan_ok = sscanf(value,"%d",&cvodes_params->max_ord);
@@ -650,6 +765,13 @@ int read_params (char *param_file_name, struct state_struct *state) {
 	sscan_ok = sscanf(value,"%d",&cvodes_params->maxncf);
       } else if (strncmp(key,"CVODES_MAXL",11) == 0) {
 	sscan_ok = sscanf(value,"%d",&cvodes_params->maxl);
+      } else if (strncmp(key,"CVODES_ADJ_STEPS",16) == 0) {
+	sscan_ok = sscanf(value,"%d",&cvodes_params->adj_steps);
+	if (cvodes_params->adj_steps < 1) {
+	  cvodes_params->adj_steps = 100;
+	}
+      } else if (strncmp(key,"CVODES_SENS_RHS",15) == 0) {
+	sscan_ok = sscanf(value,"%d",&cvodes_params->sens_rhs_choice);
       } else if (strncmp(key,"CVODES_PRETYPE",14) == 0) {
 	if (strncmp(value,"NONE",4) == 0) {
 	  cvodes_params->pretype = PREC_NONE;
@@ -660,12 +782,23 @@ int read_params (char *param_file_name, struct state_struct *state) {
 	} else if (strncmp(value,"BOTH",4) == 0) {
 	  cvodes_params->pretype = PREC_BOTH;
 	}
+      } else if (strncmp(key,"CVODES_PREC_ORDERING",20) == 0) {
+	if (strncmp(value,"NATURAL",7) == 0) {
+	  cvodes_params->sparse_matrix_ordering_alg = 0;
+	} else if (strncmp(value,"RCM",3) == 0) {
+	  cvodes_params->sparse_matrix_ordering_alg = 1;
+	} else if ((strncmp(value,"AMD",3) == 0) || 
+		   (strncmp(value,"MD",2) == 0)) {
+	  cvodes_params->sparse_matrix_ordering_alg = 2;
+	}
       } else if (strncmp(key,"CVODES_GSTYPE",13) == 0) {
 	if (strncmp(value,"MODIFIED",8) == 0) {
 	  cvodes_params->gstype = MODIFIED_GS;
 	} else if (strncmp(value,"CLASSICAL",9) == 0) {
 	  cvodes_params->gstype = CLASSICAL_GS;
 	}
+      } else if (strncmp(key,"CVODES_REUSE_CONTEXT",20) == 0) {
+	sscan_ok = sscanf(value,"%d",&cvodes_params->reuse_context);
       } else if (strncmp(key,"CVODES_NUM_STEPS",16) == 0) {
 	sscan_ok = sscanf(value,"%d",&cvodes_params->num_cvode_steps);
       } else {
@@ -0,0 +1 @@
+tools/read_sweep_file.c
\ No newline at end of file
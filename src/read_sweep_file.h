@@ -0,0 +1 @@
+tools/read_sweep_file.h
\ No newline at end of file
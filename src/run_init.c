@@ -81,7 +81,7 @@ int run_init(struct state_struct *state) {
     Allocate work space vectors, 
   */
   if (success) {
-    if (state->use_deq || state->use_lsqnonlin) {
+    if (state->use_deq || state->use_lsqnonlin || state->hybrid) {
       success = alloc7(state);
     }
   }
@@ -135,7 +135,9 @@ double rxn_likelihood(double *counts,
   compute_sensitivities = state->compute_sensitivities;
   if (use_deq && compute_sensitivities && (ode_solver_choice == 1)) {
     cvodes_params = state->cvodes_params;
-    ke            = cvodes_params->p;
+    if (cvodes_params->p != NULL) {
+      ke          = cvodes_params->p;
+    }
   }
   /*
   kssr              = state->kssr;
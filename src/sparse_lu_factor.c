@@ -0,0 +1,134 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_cvodes_headers.h"
+#include "cvodes_params_struct.h"
+#include "sparse_lu_factor.h"
+int sparse_lu_factor(struct state_struct *state) {
+  /*
+    Numeric LU factorization of the newton iteration matrix M stored in
+    miter_m, miter_im, miter_jm, in the structure computed by
+    sparse_lu_symbolic, for the in-tree sparse direct solver
+    (CVODES_SOLVER SLU).
+    The factors have the layout iluk produces, L unit lower triangular
+    with the diagonal not stored in prec_l, prec_il, prec_jl, U strictly
+    upper triangular in prec_u, prec_iu, prec_ju and the reciprocals of
+    its diagonal in recip_diag_u, so boltzmann_cvodes_fsolve and
+    boltzmann_cvodes_bsolve apply them. There is no pivoting, M = I - gamma J
+    is factored in the fill reducing order.
+    Row i is scattered into prec_row over its factor structure, marked
+    in column_mask, and eliminated with the U rows of the columns in
+    its L row.
+    Returns 1 on success, 0 for a zero pivot and -1 if M has an entry
+    outside the symbolic structure, in which case sparse_lu_symbolic
+    needs to be called again.
+    Called by: boltzmann_cvodes_slu_setup, precondition_newton_matrix
+    Calls:     fprintf, fflush
+  */
+  struct cvodes_params_struct *cvodes_params;
+  double *miter;
+  double *l;
+  double *u;
+  double *recip_diag_u;
+  double *prec_row;
+  double multiplier;
+  int    *im;
+  int    *jm;
+  int    *il;
+  int    *jl;
+  int    *iu;
+  int    *ju;
+  int    *column_mask;
+
+  int i;
+  int j;
+
+  int k;
+  int m;
+
+  int ny;
+  int success;
+
+  FILE *lfp;
+  FILE *efp;
+  success       = 1;
+  lfp           = state->lfp;
+  ny            = state->nunique_molecules;
+  cvodes_params = state->cvodes_params;
+  miter         = cvodes_params->miter_m;
+  l             = cvodes_params->prec_l;
+  u             = cvodes_params->prec_u;
+  recip_diag_u  = cvodes_params->recip_diag_u;
+  prec_row      = cvodes_params->prec_row;
+  im            = cvodes_params->miter_im;
+  jm            = cvodes_params->miter_jm;
+  il            = cvodes_params->prec_il;
+  jl            = cvodes_params->prec_jl;
+  iu            = cvodes_params->prec_iu;
+  ju            = cvodes_params->prec_ju;
+  column_mask   = cvodes_params->column_mask;
+  for (i=0;i<ny;i++) {
+    /*
+      Clear and mark the structure of row i, then load row i of M.
+    */
+    for (k=il[i];k<il[i+1];k++) {
+      j = jl[k];
+      prec_row[j]    = 0.0;
+      column_mask[j] = 1;
+    }
+    prec_row[i]    = 0.0;
+    column_mask[i] = 1;
+    for (k=iu[i];k<iu[i+1];k++) {
+      j = ju[k];
+      prec_row[j]    = 0.0;
+      column_mask[j] = 1;
+    }
+    for (k=im[i];k<im[i+1];k++) {
+      j = jm[k];
+      if (column_mask[j] == 0) {
+	success = -1;
+	break;
+      }
+      prec_row[j] = miter[k];
+    }
+    if (success == 1) {
+      /*
+	Eliminate in increasing column order, the L structure is sorted.
+      */
+      for (k=il[i];k<il[i+1];k++) {
+	j = jl[k];
+	multiplier  = prec_row[j] * recip_diag_u[j];
+	l[k]        = multiplier;
+	if (multiplier != 0.0) {
+	  for (m=iu[j];m<iu[j+1];m++) {
+	    prec_row[ju[m]] -= multiplier * u[m];
+	  }
+	}
+      }
+      if (prec_row[i] == 0.0) {
+	success = 0;
+	if (lfp) {
+	  fprintf(lfp,"sparse_lu_factor: zero pivot in row %d\n",i);
+	  fflush(lfp);
+	}
+      } else {
+	recip_diag_u[i] = 1.0/prec_row[i];
+      }
+      for (k=iu[i];k<iu[i+1];k++) {
+	u[k] = prec_row[ju[k]];
+      }
+    }
+    /*
+      Reset column_mask.
+    */
+    for (k=il[i];k<il[i+1];k++) {
+      column_mask[jl[k]] = 0;
+    }
+    column_mask[i] = 0;
+    for (k=iu[i];k<iu[i+1];k++) {
+      column_mask[ju[k]] = 0;
+    }
+    if (success != 1) {
+      break;
+    }
+  } /* end for (i...) */
+  return(success);
+}
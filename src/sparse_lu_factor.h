@@ -0,0 +1,4 @@
+#ifndef _SPARSE_LU_FACTOR_H_
+#define _SPARSE_LU_FACTOR_H_ 1
+extern int sparse_lu_factor(struct state_struct *state);
+#endif
@@ -0,0 +1,210 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_cvodes_headers.h"
+#include "cvodes_params_struct.h"
+#include "sparse_lu_symbolic.h"
+int sparse_lu_symbolic(struct state_struct *state) {
+  /*
+    Compute the nonzero structure of the complete LU factors of the
+    newton iteration matrix M stored in miter_m, miter_im, miter_jm
+    with sorted column indices, for the in-tree sparse direct solver
+    (CVODES_SOLVER SLU). M has already been symmetrically permuted by
+    build_newton_matrix with the fill reducing ordering from
+    order_newton_matrix.
+    This is iluk with no limit on the fill level: row i of the factors
+    is the structure of row i of M merged with the U rows of the
+    columns to the left of the diagonal. As the structure of M does
+    not change with gamma or y it is computed once and reused by
+    sparse_lu_factor for every numeric factorization, until M has an
+    entry outside it.
+    The column indices of L and U go in prec_il, prec_jl, prec_iu and
+    prec_ju, and the slu_factors block of cvodes_params holding the
+    prec_l, prec_u, prec_jl and prec_ju vectors is (re)allocated when
+    nnzl or nnzu is too small for the factors.
+    Also used for the compartment block preconditioner
+    (CVODES_PREC_CHOICE 4) on the block diagonal part of M.
+    Called by: boltzmann_cvodes_slu_setup, precondition_newton_matrix
+    Calls:     calloc, free, fprintf, fflush
+  */
+  struct cvodes_params_struct *cvodes_params;
+  double *factors;
+  int    *im;
+  int    *jm;
+  int    *il;
+  int    *jl;
+  int    *iu;
+  int    *ju;
+  int    *next;
+  int    *column_mask;
+  int64_t ask_for;
+  int64_t one_l;
+
+  int lpos;
+  int upos;
+
+  int i;
+  int j;
+
+  int k;
+  int m;
+
+  int prev;
+  int first;
+
+  int nnzl;
+  int nnzu;
+
+  int ny;
+  int overflow;
+
+  int success;
+  int padi;
+
+  FILE *lfp;
+  FILE *efp;
+  success       = 1;
+  one_l         = (int64_t)1;
+  lfp           = state->lfp;
+  ny            = state->nunique_molecules;
+  cvodes_params = state->cvodes_params;
+  im            = cvodes_params->miter_im;
+  jm            = cvodes_params->miter_jm;
+  il            = cvodes_params->prec_il;
+  iu            = cvodes_params->prec_iu;
+  next          = cvodes_params->lindex;
+  column_mask   = cvodes_params->column_mask;
+  factors       = cvodes_params->slu_factors;
+  nnzl          = cvodes_params->nnzl;
+  nnzu          = cvodes_params->nnzu;
+  overflow      = 1;
+  while (success && overflow) {
+    if (factors == NULL) {
+      /*
+	prec_l (nnzl), prec_u (nnzu), prec_jl (nnzl), prec_ju (nnzu).
+      */
+      ask_for = ((int64_t)(nnzl + nnzu)) *
+	((int64_t)(sizeof(double) + sizeof(int)));
+      factors = (double *)calloc(one_l,ask_for);
+      if (factors == NULL) {
+	success = 0;
+	if (lfp) {
+	  fprintf(lfp,"sparse_lu_symbolic: Error unable to allocate %ld "
+		  "bytes for the LU factors\n",ask_for);
+	  fflush(lfp);
+	}
+	break;
+      }
+      cvodes_params->slu_factors = factors;
+      cvodes_params->prec_l      = factors;
+      cvodes_params->prec_u      = &factors[nnzl];
+      cvodes_params->prec_jl     = (int *)&factors[nnzl + nnzu];
+      cvodes_params->prec_ju     = &cvodes_params->prec_jl[nnzl];
+      cvodes_params->nnzl        = nnzl;
+      cvodes_params->nnzu        = nnzu;
+    }
+    jl       = cvodes_params->prec_jl;
+    ju       = cvodes_params->prec_ju;
+    overflow = 0;
+    lpos     = 0;
+    upos     = 0;
+    for (i=0;i<ny;i++) {
+      il[i] = lpos;
+      iu[i] = upos;
+      /*
+	Load the structure of row i of M with the diagonal in an
+	ordered linked list, ny terminates the list.
+      */
+      first = ny;
+      prev  = -1;
+      for (k=im[i];k<im[i+1];k++) {
+	j = jm[k];
+	column_mask[j] = 1;
+	if (prev < 0) {
+	  first = j;
+	} else {
+	  next[prev] = j;
+	}
+	prev = j;
+      }
+      if (prev >= 0) {
+	next[prev] = ny;
+      }
+      if (column_mask[i] == 0) {
+	column_mask[i] = 1;
+	if (first > i) {
+	  next[i] = first;
+	  first   = i;
+	} else {
+	  prev = first;
+	  while (next[prev] < i) {
+	    prev = next[prev];
+	  }
+	  next[i]    = next[prev];
+	  next[prev] = i;
+	}
+      }
+      /*
+	Merge in the U rows of the subdiagonal columns.
+      */
+      k = first;
+      while (k < i) {
+	prev = k;
+	for (m=iu[k];m<iu[k+1];m++) {
+	  j = ju[m];
+	  if (column_mask[j] == 0) {
+	    while (next[prev] < j) {
+	      prev = next[prev];
+	    }
+	    next[j]        = next[prev];
+	    next[prev]     = j;
+	    prev           = j;
+	    column_mask[j] = 1;
+	  }
+	}
+	k = next[k];
+      }
+      /*
+	Extract the row structure resetting column_mask.
+      */
+      k = first;
+      while (k < ny) {
+	if (k < i) {
+	  if (lpos < nnzl) {
+	    jl[lpos] = k;
+	  }
+	  lpos += 1;
+	} else if (k > i) {
+	  if (upos < nnzu) {
+	    ju[upos] = k;
+	  }
+	  upos += 1;
+	}
+	column_mask[k] = 0;
+	k = next[k];
+      }
+      if ((lpos > nnzl) || (upos > nnzu)) {
+	overflow = 1;
+	break;
+      }
+    } /* end for (i...) */
+    if (overflow) {
+      /*
+	Grow the factors and start over, a row of L or U
+	has at most ny-1 entries.
+      */
+      nnzl = nnzl + nnzl + ny;
+      nnzu = nnzu + nnzu + ny;
+      free(factors);
+      factors = NULL;
+      cvodes_params->slu_factors = NULL;
+    } else {
+      il[ny] = lpos;
+      iu[ny] = upos;
+    }
+  } /* end while (success && overflow) */
+  if (success && lfp && state->print_output) {
+    fprintf(lfp,"sparse_lu_symbolic: %d entries in L, %d in U, %d in M\n",
+	    il[ny],iu[ny],im[ny]);
+    fflush(lfp);
+  }
+  return(success);
+}
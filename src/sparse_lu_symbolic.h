@@ -0,0 +1,4 @@
+#ifndef _SPARSE_LU_SYMBOLIC_H_
+#define _SPARSE_LU_SYMBOLIC_H_ 1
+extern int sparse_lu_symbolic(struct state_struct *state);
+#endif
@@ -0,0 +1,112 @@
+#include "boltzmann_structs.h"
+#include "species_graph.h"
+int species_graph(struct state_struct *state,
+		  int max_adj,
+		  int *adj_ptr,
+		  int *adj,
+		  int *mask) {
+  /*
+    Build the adjacency structure of the species graph from the
+    molecule-reaction incidence matrices. Two variable species are
+    adjacent if they participate in a common reaction, which is the
+    nonzero pattern of the Jacobian (and so the Newton iteration matrix
+    M = I - gamma J) with the diagonal and the fixed concentration 
+    species removed. Fixed species are isolated vertices.
+
+    The adjacency is returned in compressed row format in adj_ptr[0:ny] and
+    adj[0:adj_ptr[ny]-1], max_adj is the length of adj.
+    mask is a scratch vector of length ny.
+
+    Called by: order_newton_matrix
+    Calls:     fprintf, fflush
+  */
+  struct reactions_matrix_struct *reactions_matrix;
+  struct molecules_matrix_struct *molecules_matrix;
+  struct molecule_struct *molecules;
+  struct molecule_struct *molecule;
+  int64_t *rxn_ptrs;
+  int64_t *molecules_indices;
+  int64_t *molecules_ptrs;
+  int64_t *rxn_indices;
+
+  int ny;
+  int success;
+
+  int i;
+  int j;
+
+  int k;
+  int rxn;
+
+  int mk;
+  int pos;
+
+
+  FILE *lfp;
+  FILE *efp;
+
+  success           = 1;
+  lfp               = state->lfp;
+  ny                = state->nunique_molecules;
+  molecules         = state->sorted_molecules;
+  reactions_matrix  = state->reactions_matrix;
+  rxn_ptrs          = reactions_matrix->rxn_ptrs;
+  molecules_indices = reactions_matrix->molecules_indices;
+  molecules_matrix  = state->molecules_matrix;
+  molecules_ptrs    = molecules_matrix->molecules_ptrs;
+  rxn_indices       = molecules_matrix->reaction_indices;
+  for (i=0;i<ny;i++) {
+    mask[i] = 0;
+  }
+  pos = 0;
+  adj_ptr[0] = 0;
+  for (i=0;i<ny;i++) {
+    molecule  = (struct molecule_struct *)&molecules[i];
+    if (molecule->variable) {
+      /*
+	Do not store the diagonal.
+      */
+      mask[i] = 1;
+      for (j=molecules_ptrs[i];j<molecules_ptrs[i+1];j++) {
+	rxn = rxn_indices[j];
+	for (k=rxn_ptrs[rxn];k<rxn_ptrs[rxn+1];k++) {
+	  mk = molecules_indices[k];
+	  if (mask[mk] == 0) {
+	    mask[mk] = 1;
+	    if (molecules[mk].variable) {
+	      if (pos >= max_adj) {
+		success = 0;
+		break;
+	      }
+	      adj[pos] = mk;
+	      pos += 1;
+	    }
+	  }
+	} /* end for (k...) */
+	if (success == 0) {
+	  break;
+	}
+      } /* end for (j...) */
+      /*
+	Reset the mask.
+      */
+      mask[i] = 0;
+      for (j=molecules_ptrs[i];j<molecules_ptrs[i+1];j++) {
+	rxn = rxn_indices[j];
+	for (k=rxn_ptrs[rxn];k<rxn_ptrs[rxn+1];k++) {
+	  mask[molecules_indices[k]] = 0;
+	}
+      }
+    } /* end if (molecule->variable) */
+    if (success == 0) {
+      if (lfp) {
+	fprintf(lfp,"species_graph: Error adjacency length exceeds %d\n",
+		max_adj);
+	fflush(lfp);
+      }
+      break;
+    }
+    adj_ptr[i+1] = pos;
+  } /* end for (i...) */
+  return(success);
+}
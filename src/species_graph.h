@@ -0,0 +1,8 @@
+#ifndef _SPECIES_GRAPH_H_
+#define _SPECIES_GRAPH_H_ 1
+extern int species_graph(struct state_struct *state,
+			 int max_adj,
+			 int *adj_ptr,
+			 int *adj,
+			 int *mask);
+#endif
@@ -166,9 +166,37 @@ struct state_struct {
   int64_t ode_stop_norm; /* 0 for infinity(max), 1 for 1(sum abs), 2 for Euclidian.*/
   int64_t ode_stop_rel;  /* 0 for absolute  1 for relative */
   int64_t ode_stop_style; /*0 for termination time, 1 for adaptive */
-  int64_t compute_sensitivities; 
+  int64_t compute_sensitivities; /* 0 none, 1 forward, 2 adjoint (cvodes) */
   int64_t use_lsqnonlin;
   /* 0 for no, 1 for yes, only when ode_solver_choice == 1 */
+  int64_t num_threads; /* threads used in gradient and jacobian evaluation,
+			  needs an OpenMP build, see Makefile.head */
+  int64_t lsq_max_iters; /* iteration limit for lsq_steady_state */
+  int64_t reduce_moieties; /* 1 to integrate only the independent species,
+			      cvodes only, see init_moieties */
+  int64_t number_independent; /* rank of the variable species stoichiometry,
+				 set by init_moieties */
+  int64_t ode_dense_output; /* number of interpolated output times for the
+			       ode concentrations file, 0 for per step */
+  int64_t stable_add_choice; /* flux accumulation in lr11/lr12_gradient,
+				0 sort and pairwise sum (stable_add),
+				1 compensated summation (neumaier_sum) */
+  int64_t ode_auto_probe_steps; /* cvodes step limit per output interval
+				   in the ODE_SOLVER_CHOICE AUTO probes */
+  int64_t codegen; /* 1 to compile and load network specific lr8
+		      kernels, see codegen_init */
+  int64_t hybrid; /* 1 for the hybrid ode/stochastic engine, see
+		     hybrid_run */
+  int64_t hybrid_repartition_steps; /* steps between hybrid_run
+				       reaction partitions */
+  int64_t num_agents; /* > 0 to run that many agents with
+			 boltzmann_fork_agents */
+  int64_t num_workers; /* worker processes for boltzmann_fork_agents,
+			  the number of processors if < 1 */
+  int64_t agent_data_compact; /* 1 for the delta encoded agent_data
+				 counts, see boltzmann_pack_agent_counts */
+  int64_t advance_warm; /* 1 when the reaction likelihoods match
+			   current_counts for boltzmann_advance */
   /*
     offsets used to self-describe this state vector.
     only needed for parallel version multiple instantiations
@@ -238,6 +266,33 @@ struct state_struct {
     Numerical Jacobian threshold for ode_num_jac thresh vector initialization.
   */
   double nj_thresh;
+  /*
+    Steady state solve (use_lsqnonlin): converged when
+    ||f||_inf <= lsq_ftol * ||concs||_inf, after an optional ode
+    transient of length lsq_seed_t.
+  */
+  double lsq_ftol;
+  double lsq_seed_t;
+  /*
+    Dense output (ode_dense_output > 0): output times are log spaced
+    from ode_dense_log_t0 to ode_t_final if ode_dense_log_t0 > 0,
+    uniformly spaced otherwise.
+  */
+  double ode_dense_log_t0;
+  /*
+    Length of the probe integrations of ODE_SOLVER_CHOICE AUTO,
+    ode_t_final/100 if 0.
+  */
+  double ode_auto_probe_t;
+  /*
+    hybrid_run partition: a reaction is fast if its firing rate is at
+    least hybrid_rate_threshold (10/hybrid_max_dt if 0) and all of its
+    variable species counts are at least hybrid_count_threshold.
+    hybrid_max_dt bounds the ode segments, ode_t_final/100 if 0.
+  */
+  double hybrid_count_threshold;
+  double hybrid_rate_threshold;
+  double hybrid_max_dt;
 
 
   int64_t *workspace_base;
@@ -361,6 +416,9 @@ struct state_struct {
   char *cmpts_echo_file;   /* max_filename_len */
   char *ode_kq_file;       /* max_filename_len */
   char *ode_skq_file;      /* max_filename_len */
+  char *ode_adj_target_file; /* max_filename_len */
+  char *codegen_dir;       /* max_filename_len */
+  char *codegen_cc;        /* max_filename_len */
   
   char *solvent_string;    /* Length is 64. Allocated in alloc0 */
 
@@ -412,6 +470,55 @@ struct state_struct {
   double *ode_skqi;
   double *ode_forward_lklhds;
   double *ode_reverse_lklhds;
+  /*
+    Flattened copy of the reactions matrix used by the fused lr15_gradient
+    kernel, allocated in alloc7 and filled by init_rxn_terms, all of
+    length number_molecules (the number of reactions matrix entries).
+  */
+  double *rxn_term_coefs;      /* signed stoichiometric coefficients */
+  double *rxn_term_flux_coefs; /* coefficients, 0 for fixed species */
+  int    *rxn_term_mols;       /* species index of each entry */
+  int    *rxn_term_pows;       /* |coefficient| if integral, else -1 */
+  /*
+    Log space lr16_gradient vectors, allocated in alloc7, the first and
+    last filled by init_rxn_terms.
+  */
+  double *log_conc_to_count;   /* nunique_molecules */
+  double *log_concs;           /* nunique_molecules, scratch */
+  double *log_counts_p1;       /* nunique_molecules, scratch log(count+1) */
+  double *reg_log_constant;    /* number_reactions * max_regs_per_rxn */
+  /*
+    Conserved moiety reduction (reduce_moieties), allocated in alloc7
+    and filled by init_moieties. With nd = nunique_molecules -
+    number_independent dependent species,
+      concs[dependent_species[i]] = moiety_totals[i] +
+         sum_j link_matrix[i*number_independent+j] *
+               concs[independent_species[j]]
+  */
+  double *link_matrix;         /* nd * number_independent <= ny*ny/4 + 1 */
+  double *moiety_totals;       /* nunique_molecules */
+  double *moiety_concs;        /* nunique_molecules, expanded concs scratch */
+  double *moiety_flux;         /* nunique_molecules, full gradient scratch */
+  double *moiety_dir;          /* nunique_molecules, jtimes scratch */
+  int    *independent_species; /* nunique_molecules */
+  int    *dependent_species;   /* nunique_molecules */
+  /*
+    Network specific lr8 kernels loaded by codegen_init (CODEGEN 1),
+    NULL when the interpreted lr8_gradient and lr8_approximate_jacobian
+    loops are used.
+  */
+  void (*codegen_rfc)(double *counts, double *ke, double *rke,
+		      double *activities, double *forward_lklhd,
+		      double *reverse_lklhd, double *rfc);
+  void (*codegen_flux)(double *rfc, double *flux);
+  void (*codegen_drfc)(double *counts, double *concs,
+		       double *count_to_conc, double *ke, double *rke,
+		       double *activities, double *drfc);
+  /*
+    Counts the compact agent data (AGENT_DATA_COMPACT 1) is encoded
+    against, allocated and set by boltzmann_build_agent_data_block.
+  */
+  double *agent_base_counts;   /* nunique_molecules */
   int *rxn_has_flux; /* Indicator as to whether a reaction contributes to 
 		       species flux  length is number_reactions */
   int  *base_reactants;            /* List of reactant species (by number)
@@ -0,0 +1 @@
+tools/sweep_clone_state.c
\ No newline at end of file
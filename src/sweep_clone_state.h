@@ -0,0 +1 @@
+tools/sweep_clone_state.h
\ No newline at end of file
@@ -0,0 +1 @@
+tools/sweep_run_sample.c
\ No newline at end of file
@@ -0,0 +1 @@
+tools/sweep_run_sample.h
\ No newline at end of file
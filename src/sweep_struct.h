@@ -0,0 +1 @@
+tools/sweep_struct.h
\ No newline at end of file
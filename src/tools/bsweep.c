@@ -0,0 +1,168 @@
+/* bsweep.c
+*******************************************************************************
+boltzmann
+
+Pacific Northwest National Laboratory, Richland, WA 99352.
+
+Copyright (c) 2010 Battelle Memorial Institute.
+
+Publications based on work performed using the software should include
+the following citation as a reference:
+
+
+Licensed under the Educational Community License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+The terms and conditions of the License may be found in
+ECL-2.0_LICENSE_TERMS.TXT in the directory containing this file.
+
+Unless required by applicable law or agreed to in writing, software distributed
+under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+CONDITIONS OF ANY KIND, either express or implied. See the License for the
+specific language governing permissions and limitations under the License.
+******************************************************************************/
+#include "boltzmann_structs.h"
+
+/*
+  Initialize the boltzmann system once and solve the ode's to steady
+  state for every sample of a sweep file, each sample changing
+  equilibrium constants, activities and initial concentrations of the
+  base model (see read_sweep_file for the format).
+
+  usage: bsweep param_file sweep_file [summary_file]
+
+  The summary, one row per sample, goes to summary_file or stdout.
+  With an OpenMP build (OMP_FLAGS in Makefile.head) NUM_THREADS samples
+  run at once, each thread on its own copy of the state from
+  sweep_clone_state. Results do not depend on the number of threads.
+  With CODEGEN 1 the generated kernels are compiled and loaded once on
+  the base state, before it is cloned, so every clone shares them.
+
+  Calls:  boltzmann_init, read_sweep_file, codegen_init, sweep_clone_state,
+          sweep_run_sample, print_sweep_results
+*/
+#include "boltzmann_init.h"
+#include "sweep_struct.h"
+#include "read_sweep_file.h"
+#include "codegen_init.h"
+#include "sweep_clone_state.h"
+#include "sweep_run_sample.h"
+#include "print_sweep_results.h"
+int main(int argc, char **argv)
+{
+  struct state_struct *state;
+  struct state_struct **clones;
+  struct state_struct *clone;
+  struct sweep_struct sweep;
+  char *param_file_name;
+  char *sweep_file_name;
+  char *summary_file_name;
+  int64_t one_l;
+  int success;
+  int nthreads;
+  int number_samples;
+  int num_failed;
+  int tid;
+  int k;
+  FILE *ofp;
+  FILE *lfp;
+
+  one_l             = (int64_t)1;
+  param_file_name   = NULL;
+  sweep_file_name   = NULL;
+  summary_file_name = NULL;
+  clones            = NULL;
+  ofp               = stdout;
+  if (argc > 2) {
+    param_file_name = argv[1];
+    sweep_file_name = argv[2];
+    if (argc > 3) {
+      summary_file_name = argv[3];
+    }
+    success = 1;
+  } else {
+    fprintf(stderr,"usage: bsweep param_file sweep_file [summary_file]\n");
+    fflush(stderr);
+    success = 0;
+  }
+  if (success) {
+    success = boltzmann_init(param_file_name,&state);
+  }
+  if (success) {
+    lfp = state->lfp;
+    if ((state->use_deq == 0) && (state->use_lsqnonlin == 0)) {
+      success = 0;
+      if (lfp) {
+	fprintf(lfp,"bsweep: Error USE_DEQ or USE_LSQNONLIN must be set\n");
+	fflush(lfp);
+      }
+    }
+  }
+  if (success) {
+    success = read_sweep_file(state,sweep_file_name,&sweep);
+  }
+  if (success) {
+    success = codegen_init(state);
+  }
+  if (success) {
+    number_samples = (int)sweep.number_samples;
+    nthreads       = 1;
+#ifdef _OPENMP
+    nthreads       = (int)state->num_threads;
+#endif
+    if (nthreads > number_samples) {
+      nthreads = number_samples;
+    }
+    clones = (struct state_struct **)calloc(one_l,
+					    nthreads*sizeof(clones[0]));
+    if (clones == NULL) {
+      success = 0;
+    }
+    for (tid=0;((tid<nthreads) && success);tid++) {
+      success = sweep_clone_state(state,&clones[tid]);
+    }
+  }
+  if (success) {
+#ifdef _OPENMP
+#pragma omp parallel num_threads(nthreads) private(tid,clone,k)
+    {
+      tid   = omp_get_thread_num();
+      clone = clones[tid];
+#pragma omp for schedule(dynamic,1)
+      for (k=0;k<number_samples;k++) {
+	sweep_run_sample(state,clone,&sweep,k);
+      }
+    }
+#else
+    clone = clones[0];
+    for (k=0;k<number_samples;k++) {
+      sweep_run_sample(state,clone,&sweep,k);
+    }
+#endif
+    num_failed = 0;
+    for (k=0;k<number_samples;k++) {
+      if (sweep.statuses[k] == 0) {
+	num_failed += 1;
+      }
+    }
+    if (lfp) {
+      fprintf(lfp,"bsweep: ran %d samples on %d threads, %d failed\n",
+	      number_samples,nthreads,num_failed);
+      fflush(lfp);
+    }
+    if (summary_file_name) {
+      ofp = fopen(summary_file_name,"w");
+      if (ofp == NULL) {
+	if (lfp) {
+	  fprintf(lfp,"bsweep: Error unable to open %s\n",summary_file_name);
+	  fflush(lfp);
+	}
+      }
+    }
+    print_sweep_results(state,&sweep,ofp);
+    if (ofp && (ofp != stdout)) {
+      fclose(ofp);
+    }
+  }
+  fflush(stdout);
+  exit(0);
+}
@@ -153,7 +153,7 @@ int bwarmup_run(struct state_struct *state) {
 	    "\nWarmup_step rxn_choice forward_likelihood "
 	    "reverse_likelihood\n");
   }
-  if (use_deq == zero_l) {
+  if ((use_deq == zero_l) && (state->use_lsqnonlin == zero_l)) {
     for (i=0;i<n_warmup_steps;i++) {
       /*
 	Compute the reaction likelihoods: forward_rxn_likelihood, 
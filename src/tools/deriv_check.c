@@ -0,0 +1,320 @@
+/* deriv_check.c
+*******************************************************************************
+boltzmann
+
+Pacific Northwest National Laboratory, Richland, WA 99352.
+
+Copyright (c) 2010 Battelle Memorial Institute.
+
+Publications based on work performed using the software should include
+the following citation as a reference:
+
+
+Licensed under the Educational Community License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+The terms and conditions of the License may be found in
+ECL-2.0_LICENSE_TERMS.TXT in the directory containing this file.
+
+Unless required by applicable law or agreed to in writing, software distributed
+under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+CONDITIONS OF ANY KIND, either express or implied. See the License for the
+specific language governing permissions and limitations under the License.
+******************************************************************************/
+#include "boltzmann_structs.h"
+#include "boltzmann_cvodes_headers.h"
+#include "cvodes_params_struct.h"
+
+/*
+  Consistency checks of the derivative and sensitivity code on a model.
+
+  usage: deriv_check param_file [reaction]
+
+  1. The lr15 (fused) and lr16 (log space) gradients are compared
+     with the lr8 gradient at the initial concentrations. The state
+     is initialized as boltzmann_init does, but with gradient_choice
+     16 so that alloc7 allocates the reaction term vectors.
+  2. If the param_file names an ODE_ADJ_TARGET_FILE, dG/dke for the
+     given reaction (default 0) from the adjoint sensitivities
+     (COMPUTE_SENSITIVITIES 2) is compared with
+       sum_j w_j (y_j(T) - target_j) dy_j/dke
+     from the forward sensitivities (COMPUTE_SENSITIVITIES 1), each
+     computed by a deq_run with cvodes on a freshly initialized state.
+     The values are read back from the ODE_SENS_FILE, so they agree
+     to the 6 printed digits at best. CVODES_RELTOL and CVODES_ABSTOL
+     need to be well below that relative to dG/dke, which is often
+     much smaller than the concentrations (a CVODES_ABSTOL of 1e-18
+     or less).
+  Prints one line per comparison and exits with 1 if any fails.
+
+  Calls:  alloc0, read_params, boltzmann_init_core,
+          boltzmann_init, init_base_reactants, init_rxn_terms, gradient,
+          deq_run, read_adj_targets, fopen, fgets, sscanf, fclose,
+	  calloc, free, fprintf
+*/
+#include "alloc0.h"
+#include "read_params.h"
+#include "boltzmann_init_core.h"
+#include "boltzmann_init.h"
+#include "init_base_reactants.h"
+#include "init_rxn_terms.h"
+#include "gradient.h"
+#include "deq_run.h"
+#include "read_adj_targets.h"
+int main(int argc, char **argv)
+{
+  struct state_struct *state;
+  struct cvodes_params_struct *cvodes_params;
+  double *concs;
+  double *flux8;
+  double *flux;
+  double *sens_row;
+  double *adj_target;
+  double *adj_weight;
+  double *current_counts;
+  double *count_to_conc;
+  char   *param_file_name;
+  char   *line;
+  char   *pos;
+  FILE   *sens_fp;
+  double gtol;
+  double stol;
+  double fmax;
+  double dmax;
+  double diff;
+  double adj_dgdke;
+  double fwd_dgdke;
+  double value;
+  int64_t ask_for;
+  int64_t one_l;
+  int choices[2];
+  int ny;
+  int ns;
+  int rxn;
+  int row;
+  int c;
+  int i;
+  int j;
+  int n;
+  int success;
+  int failures;
+  int line_len;
+  int padi;
+
+  gtol       = 1.0e-10;
+  stol       = 1.0e-4;
+  one_l      = (int64_t)1;
+  line_len   = 65536;
+  choices[0] = 15;
+  choices[1] = 16;
+  failures   = 0;
+  adj_dgdke  = 0.0;
+  fwd_dgdke  = 0.0;
+  concs      = NULL;
+  line       = NULL;
+  if (argc > 1) {
+    param_file_name = argv[1];
+  } else {
+    fprintf(stderr,"usage: deriv_check param_file [reaction]\n");
+    exit(1);
+  }
+  rxn = 0;
+  if (argc > 2) {
+    rxn = atoi(argv[2]);
+  }
+  success = alloc0(&state,1);
+  if (success) {
+    success = read_params(param_file_name,state);
+  }
+  if (success) {
+    state->gradient_choice = 16;
+    success = boltzmann_init_core(state);
+  }
+  if (success) {
+    ny = (int)state->nunique_molecules;
+    ns = (int)state->number_reactions;
+    if ((rxn < 0) || (rxn >= ns)) {
+      fprintf(stderr,"deriv_check: reaction %d not in 0..%d\n",rxn,ns-1);
+      success = 0;
+    }
+  }
+  if (success) {
+    ask_for = ((int64_t)(4*ny)) * ((int64_t)sizeof(double));
+    concs   = (double *)calloc(one_l,ask_for);
+    line    = (char *)calloc(one_l,(int64_t)line_len);
+    if ((concs == NULL) || (line == NULL)) {
+      fprintf(stderr,"deriv_check: unable to allocate scratch space\n");
+      success = 0;
+    }
+  }
+  /*
+    1. lr15 and lr16 against lr8.
+  */
+  if (success) {
+    flux8    = &concs[ny];
+    flux     = &flux8[ny];
+    sens_row = &flux[ny];
+    state->compute_sensitivities = 0;
+    current_counts = state->current_counts;
+    count_to_conc  = state->count_to_conc;
+    for (i=0;i<ny;i++) {
+      concs[i] = current_counts[i] * count_to_conc[i];
+    }
+    success = init_base_reactants(state);
+    if (success) {
+      success = init_rxn_terms(state);
+    }
+    if (success) {
+      success = gradient(state,concs,flux8,8);
+    }
+    if (success) {
+      fmax = 0.0;
+      for (j=0;j<ny;j++) {
+	if (fabs(flux8[j]) > fmax) {
+	  fmax = fabs(flux8[j]);
+	}
+      }
+      for (c=0;c<2;c++) {
+	success = gradient(state,concs,flux,choices[c]);
+	if (success == 0) break;
+	dmax = 0.0;
+	for (j=0;j<ny;j++) {
+	  diff = fabs(flux[j] - flux8[j]);
+	  if (diff > dmax) {
+	    dmax = diff;
+	  }
+	}
+	if (dmax > gtol * fmax) {
+	  failures += 1;
+	}
+	fprintf(stdout,"lr%d vs lr8 gradient: max |diff| %le, max |lr8| %le %s\n",
+		choices[c],dmax,fmax,(dmax > gtol * fmax) ? "FAIL" : "ok");
+      }
+    }
+    if (success == 0) {
+      fprintf(stderr,"deriv_check: gradient evaluation failed\n");
+    }
+  }
+  /*
+    2. Adjoint against forward sensitivities for reaction rxn.
+  */
+  if (success) {
+    if (state->ode_adj_target_file[0] == '\0') {
+      fprintf(stdout,"no ODE_ADJ_TARGET_FILE, sensitivity check skipped\n");
+    } else {
+      success = boltzmann_init(param_file_name,&state);
+      if (success) {
+	state->ode_solver_choice     = 1;
+	state->use_lsqnonlin         = 0;
+	state->compute_sensitivities = 2;
+	success = deq_run(state);
+      }
+      /*
+	The adjoint ode_sens_file has the objective and t_final lines,
+	a header line and then one "reaction dG/dke" line per reaction.
+      */
+      if (success) {
+	sens_fp = fopen(state->ode_sens_file,"r");
+	success = 0;
+	if (sens_fp) {
+	  while (fgets(line,line_len,sens_fp)) {
+	    if (sscanf(line,"%d %le",&row,&value) == 2) {
+	      if (row == rxn) {
+		adj_dgdke = value;
+		success   = 1;
+	      }
+	    }
+	  }
+	  fclose(sens_fp);
+	}
+	if (success == 0) {
+	  fprintf(stderr,"deriv_check: no adjoint dG/dke for reaction %d in %s\n",
+		  rxn,state->ode_sens_file);
+	}
+      }
+      if (success) {
+	success = boltzmann_init(param_file_name,&state);
+      }
+      if (success) {
+	state->ode_solver_choice     = 1;
+	state->use_lsqnonlin         = 0;
+	state->compute_sensitivities = 1;
+	success = deq_run(state);
+      }
+      /*
+	The forward ode_sens_file has a header line and then one
+	"reaction dy_0/dke ... dy_(ny-1)/dke" line per reaction.
+      */
+      if (success) {
+	sens_fp = fopen(state->ode_sens_file,"r");
+	success = 0;
+	if (sens_fp) {
+	  while (fgets(line,line_len,sens_fp)) {
+	    pos = line;
+	    if (sscanf(pos,"%d%n",&row,&n) != 1) continue;
+	    if (row != rxn) continue;
+	    pos += n;
+	    for (j=0;j<ny;j++) {
+	      if (sscanf(pos,"%le%n",&sens_row[j],&n) != 1) break;
+	      pos += n;
+	    }
+	    success = (j == ny);
+	  }
+	  fclose(sens_fp);
+	}
+	if (success == 0) {
+	  fprintf(stderr,"deriv_check: no forward dy/dke for reaction %d in %s\n",
+		  rxn,state->ode_sens_file);
+	}
+      }
+      /*
+	Read the objective targets and weights, as
+	boltzmann_cvodes_adj_init does, into a block of our own.
+      */
+      if (success) {
+	cvodes_params = state->cvodes_params;
+	ask_for       = ((int64_t)(2*ny)) * ((int64_t)sizeof(double));
+	adj_target    = (double *)calloc(one_l,ask_for);
+	if (adj_target == NULL) {
+	  success = 0;
+	  fprintf(stderr,"deriv_check: unable to allocate targets\n");
+	} else {
+	  adj_weight = &adj_target[ny];
+	  cvodes_params->adj_target = adj_target;
+	  cvodes_params->adj_weight = adj_weight;
+	  success = read_adj_targets(state);
+	  if (success) {
+	    fwd_dgdke = 0.0;
+	    for (j=0;j<ny;j++) {
+	      fwd_dgdke += adj_weight[j] * (state->ode_concs[j] - adj_target[j]) *
+		sens_row[j];
+	    }
+	  }
+	  cvodes_params->adj_target = NULL;
+	  cvodes_params->adj_weight = NULL;
+	  free(adj_target);
+	}
+      }
+      if (success) {
+	diff = fabs(adj_dgdke - fwd_dgdke);
+	if (diff > stol * fabs(fwd_dgdke)) {
+	  failures += 1;
+	}
+	fprintf(stdout,"reaction %d dG/dke: adjoint %le, forward %le %s\n",
+		rxn,adj_dgdke,fwd_dgdke,
+		(diff > stol * fabs(fwd_dgdke)) ? "FAIL" : "ok");
+      } else {
+	fprintf(stderr,"deriv_check: sensitivity check failed\n");
+      }
+    }
+  }
+  if (concs) {
+    free(concs);
+  }
+  if (line) {
+    free(line);
+  }
+  if ((success == 0) || (failures > 0)) {
+    exit(1);
+  }
+  exit(0);
+}
@@ -0,0 +1,49 @@
+#include "boltzmann_structs.h"
+#include "sweep_struct.h"
+#include "print_mlcls_cmpts_header.h"
+#include "print_sweep_results.h"
+void print_sweep_results(struct state_struct *state,
+			 struct sweep_struct *sweep,
+			 FILE *ofp) {
+  /*
+    Print one tab separated summary row per sweep sample, in the
+    order of the sweep file: the sample label, the deq_run status
+    (1 success, 0 failure) and the steady state concentrations, with
+    the same columns as the ode concentrations file.
+
+    Called by: bsweep
+    Calls:     print_mlcls_cmpts_header, fprintf, fflush
+  */
+  struct molecule_struct *molecules;
+  struct molecule_struct *cur_molecule;
+  double *result;
+  char *label;
+  int64_t label_len;
+  int ny;
+  int number_samples;
+  int k;
+  int i;
+  int padi;
+
+  ny             = (int)state->nunique_molecules;
+  molecules      = state->sorted_molecules;
+  number_samples = (int)sweep->number_samples;
+  label_len      = sweep->label_len;
+  if (ofp) {
+    print_mlcls_cmpts_header(state,"Sample\tStatus",ofp);
+    for (k=0;k<number_samples;k++) {
+      label  = (char *)&sweep->labels[k*label_len];
+      result = &sweep->results[((int64_t)k) * ny];
+      fprintf(ofp,"%s\t%d",label,sweep->statuses[k]);
+      cur_molecule = molecules;
+      for (i=0;i<ny;i++) {
+	if ((cur_molecule->solvent == 0) || (cur_molecule->variable == 1)) {
+	  fprintf(ofp,"\t%le",result[i]);
+	}
+	cur_molecule += 1; /* caution address arithmetic.*/
+      }
+      fprintf(ofp,"\n");
+    }
+    fflush(ofp);
+  }
+}
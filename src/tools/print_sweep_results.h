@@ -0,0 +1,6 @@
+#ifndef _PRINT_SWEEP_RESULTS_H_
+#define _PRINT_SWEEP_RESULTS_H_ 1
+extern void print_sweep_results(struct state_struct *state,
+				struct sweep_struct *sweep,
+				FILE *ofp);
+#endif
@@ -0,0 +1,309 @@
+#include "boltzmann_structs.h"
+#include "sweep_struct.h"
+#include "molecules_lookup.h"
+#include "compartment_lookup.h"
+#include "upcase.h"
+#include "read_sweep_file.h"
+int read_sweep_file(struct state_struct *state, char *sweep_file,
+		    struct sweep_struct *sweep) {
+  /*
+    Read the sample table for bsweep and allocate the sweep vectors.
+    Each non blank line not starting with # is one sample:
+
+      label [ke:rxn=multiplier] [act:rxn=activity] [conc:species=conc] ...
+
+    rxn is a reaction title or a 0-based reaction index,
+    species is molecule[:compartment]. ke overrides multiply the
+    equilibrium constant from the reactions file, act overrides replace
+    the reaction activity, and conc overrides replace the initial
+    concentration of the species. Species and reactions not listed keep
+    their values from the base model.
+    The file is read twice, once to size the sweep vectors and once to
+    fill them.
+
+    Called by: bsweep
+    Calls:     molecules_lookup,
+               compartment_lookup,
+	       upcase,
+	       fopen, fgets, rewind, sscanf, strchr, strrchr,
+	       strcmp, strncpy, calloc, fclose, fprintf, fflush (intrinsic)
+  */
+  struct reaction_struct *reactions;
+  double *values;
+  double value;
+  char *buffer;
+  char *token;
+  char *name;
+  char *eq_pos;
+  char *colon_pos;
+  char *compartment_name;
+  char *rxn_title_text;
+  char *title;
+  char *fgp;
+  char *pos;
+  char *labels;
+  int64_t buff_len;
+  int64_t ask_for;
+  int64_t one_l;
+  int64_t label_len;
+  int    *kinds;
+  int    *indices;
+  int    *sample_ptrs;
+  int    *statuses;
+  int ny;
+  int num_rxns;
+
+  int number_samples;
+  int number_overrides;
+
+  int pass;
+  int ns;
+
+  int no;
+  int nscan;
+
+  int nchars;
+  int kind;
+
+  int index;
+  int ci;
+
+  int i;
+  int line_count;
+
+  int success;
+  int padi;
+
+  FILE *sweep_fp;
+  FILE *lfp;
+  FILE *efp;
+
+  success          = 1;
+  one_l            = (int64_t)1;
+  lfp              = state->lfp;
+  ny               = (int)state->nunique_molecules;
+  num_rxns         = (int)state->number_reactions;
+  reactions        = state->reactions;
+  rxn_title_text   = state->rxn_title_text;
+  label_len        = (int64_t)64;
+  buff_len         = (int64_t)65536;
+  number_samples   = 0;
+  number_overrides = 0;
+  values           = NULL;
+  kinds            = NULL;
+  indices          = NULL;
+  sample_ptrs      = NULL;
+  statuses         = NULL;
+  labels           = NULL;
+  sweep_fp         = NULL;
+  /*
+    Line buffer and token buffer.
+  */
+  buffer = (char *)calloc(one_l,buff_len + buff_len);
+  if (buffer == NULL) {
+    success = 0;
+    if (lfp) {
+      fprintf(lfp,"read_sweep_file: Error unable to allocate %ld bytes "
+	      "for line buffers\n",buff_len + buff_len);
+      fflush(lfp);
+    }
+  } else {
+    token = buffer + buff_len;
+  }
+  if (success) {
+    sweep_fp = fopen(sweep_file,"r");
+    if (sweep_fp == NULL) {
+      success = 0;
+      if (lfp) {
+	fprintf(lfp,"read_sweep_file: Error unable to open %s\n",sweep_file);
+	fflush(lfp);
+      }
+    }
+  }
+  for (pass=0;((pass<2) && success);pass++) {
+    if (pass == 1) {
+      /*
+	Allocate the sweep vectors.
+	doubles:
+	  values      (number_overrides)
+	  results     (number_samples * ny)
+	ints:
+	  kinds       (number_overrides)
+	  indices     (number_overrides)
+	  sample_ptrs (number_samples + 1)
+	  statuses    (number_samples)
+	chars:
+	  labels      (number_samples * label_len)
+      */
+      ask_for = ((int64_t)(number_overrides + (number_samples * ny))) << 3;
+      ask_for += ((int64_t)(number_overrides + number_overrides +
+			    number_samples + number_samples + 2)) << 2;
+      ask_for += number_samples * label_len;
+      values = (double *)calloc(one_l,ask_for);
+      if (values == NULL) {
+	success = 0;
+	if (lfp) {
+	  fprintf(lfp,"read_sweep_file: Error unable to allocate %ld bytes "
+		  "for %d samples\n",ask_for,number_samples);
+	  fflush(lfp);
+	}
+	break;
+      }
+      sweep->values           = values;
+      sweep->results          = &values[number_overrides];
+      kinds                   = (int *)&sweep->results[number_samples * ny];
+      indices                 = &kinds[number_overrides];
+      sample_ptrs             = &indices[number_overrides];
+      statuses                = &sample_ptrs[number_samples + 1];
+      labels                  = (char *)&statuses[number_samples + 1];
+      sweep->kinds            = kinds;
+      sweep->indices          = indices;
+      sweep->sample_ptrs      = sample_ptrs;
+      sweep->statuses         = statuses;
+      sweep->labels           = labels;
+      sweep->number_samples   = (int64_t)number_samples;
+      sweep->number_overrides = (int64_t)number_overrides;
+      sweep->label_len        = label_len;
+      rewind(sweep_fp);
+    }
+    ns         = 0;
+    no         = 0;
+    line_count = 0;
+    while (success && !feof(sweep_fp)) {
+      fgp = fgets(buffer,buff_len,sweep_fp);
+      if (fgp == NULL) {
+	break;
+      }
+      line_count += 1;
+      pos   = buffer;
+      nscan = sscanf(pos,"%s%n",token,&nchars);
+      if ((nscan < 1) || (token[0] == '#')) {
+	continue;
+      }
+      if (pass == 1) {
+	strncpy((char *)&labels[ns*label_len],token,label_len-1);
+	sample_ptrs[ns] = no;
+      }
+      pos += nchars;
+      while (success) {
+	nscan = sscanf(pos,"%s%n",token,&nchars);
+	if (nscan < 1) {
+	  break;
+	}
+	pos += nchars;
+	if (pass == 0) {
+	  no += 1;
+	  continue;
+	}
+	/*
+	  Split kind:name=value.
+	*/
+	colon_pos = strchr(token,':');
+	eq_pos    = strrchr(token,'=');
+	kind      = 0;
+	if ((colon_pos != NULL) && (eq_pos != NULL) && (eq_pos > colon_pos)) {
+	  *colon_pos = '\0';
+	  *eq_pos    = '\0';
+	  name       = colon_pos + 1;
+	  if (strcmp(token,"ke") == 0) {
+	    kind = SWEEP_KE;
+	  } else if (strcmp(token,"act") == 0) {
+	    kind = SWEEP_ACT;
+	  } else if (strcmp(token,"conc") == 0) {
+	    kind = SWEEP_CONC;
+	  }
+	}
+	if (kind != 0) {
+	  if (sscanf(eq_pos+1,"%le",&value) != 1) {
+	    kind = 0;
+	  }
+	}
+	if (kind == 0) {
+	  success = 0;
+	  if (lfp) {
+	    fprintf(lfp,"read_sweep_file: Error, line %d, could not parse "
+		    "override, expected ke:rxn=mult, act:rxn=value or "
+		    "conc:species=value\n",line_count);
+	    fflush(lfp);
+	  }
+	  break;
+	}
+	index = -1;
+	if (kind == SWEEP_CONC) {
+	  compartment_name = strchr(name,':');
+	  ci = 0;
+	  if (compartment_name != NULL) {
+	    *compartment_name = '\0';
+	    compartment_name += 1;
+	    upcase(strlen(compartment_name),compartment_name);
+	    ci = compartment_lookup(compartment_name,state);
+	  }
+	  if (ci >= 0) {
+	    upcase(strlen(name),name);
+	    index = molecules_lookup(name,ci,state);
+	  }
+	  if (index >= ny) {
+	    index = -1;
+	  }
+	} else {
+	  /*
+	    Reaction title, or failing that a 0-based reaction index.
+	  */
+	  for (i=0;i<num_rxns;i++) {
+	    if (reactions[i].title >= 0) {
+	      title = (char *)&rxn_title_text[reactions[i].title];
+	      if (strcmp(title,name) == 0) {
+		index = i;
+		break;
+	      }
+	    }
+	  }
+	  if (index < 0) {
+	    if (sscanf(name,"%d%n",&index,&nchars) != 1) {
+	      index = -1;
+	    } else {
+	      if ((name[nchars] != '\0') || (index >= num_rxns)) {
+		index = -1;
+	      }
+	    }
+	  }
+	}
+	if (index < 0) {
+	  success = 0;
+	  if (lfp) {
+	    fprintf(lfp,"read_sweep_file: Error, line %d, %s is not a %s "
+		    "in the reactions file\n",line_count,name,
+		    (kind == SWEEP_CONC) ? "species" : "reaction");
+	    fflush(lfp);
+	  }
+	  break;
+	}
+	kinds[no]   = kind;
+	indices[no] = index;
+	values[no]  = value;
+	no += 1;
+      } /* end while (success) over overrides */
+      ns += 1;
+    } /* end while (success && !feof(sweep_fp)) */
+    if (pass == 0) {
+      number_samples   = ns;
+      number_overrides = no;
+      if (number_samples == 0) {
+	success = 0;
+	if (lfp) {
+	  fprintf(lfp,"read_sweep_file: Error no samples in %s\n",sweep_file);
+	  fflush(lfp);
+	}
+      }
+    } else {
+      sample_ptrs[ns] = no;
+    }
+  } /* end for (pass...) */
+  if (sweep_fp) {
+    fclose(sweep_fp);
+  }
+  if (buffer) {
+    free(buffer);
+  }
+  return(success);
+}
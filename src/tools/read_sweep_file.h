@@ -0,0 +1,5 @@
+#ifndef _READ_SWEEP_FILE_H_
+#define _READ_SWEEP_FILE_H_ 1
+extern int read_sweep_file(struct state_struct *state, char *sweep_file,
+			   struct sweep_struct *sweep);
+#endif
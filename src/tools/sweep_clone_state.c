@@ -0,0 +1,117 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_cvodes_headers.h"
+#include "cvodes_params_struct.h"
+#include "alloc7.h"
+#include "alloc8.h"
+#include "sweep_clone_state.h"
+int sweep_clone_state(struct state_struct *state,
+		      struct state_struct **clone_p) {
+  /*
+    Make a copy of state that one bsweep thread can pass to deq_run
+    while other threads run their own copies.
+    The parsed model (reactions, molecules, compartments, the
+    reactions and molecules matrices, text and regulation data) is
+    shared read only. The vectors a sample changes or deq_run writes,
+    current_counts, ke, rke, activities, enzyme_level, the alloc7 and
+    alloc8 workspaces and the cvodes and ode23tb parameter structs are
+    private to the copy.
+    Output, ode monitoring and sensitivities are turned off in the
+    copy, and its gradient and jacobian are serial as the threads are
+    used across samples. lfp is shared, each log message is a single
+    fprintf.
+
+    Called by: bsweep
+    Calls:     alloc7, alloc8, calloc, memcpy, fprintf, fflush
+  */
+  struct state_struct *clone;
+  struct cvodes_params_struct *cvodes_params;
+  struct ode23tb_params_struct *ode23tb_params;
+  double *vectors;
+  int64_t ask_for;
+  int64_t one_l;
+  int ny;
+  int num_rxns;
+  int success;
+  int padi;
+  FILE *lfp;
+  FILE *efp;
+
+  success  = 1;
+  one_l    = (int64_t)1;
+  ny       = (int)state->nunique_molecules;
+  num_rxns = (int)state->number_reactions;
+  lfp      = state->lfp;
+  vectors  = NULL;
+  clone    = (struct state_struct *)calloc(one_l,sizeof(struct state_struct));
+  if (clone == NULL) {
+    success = 0;
+    if (lfp) {
+      fprintf(lfp,"sweep_clone_state: Error unable to allocate state copy\n");
+      fflush(lfp);
+    }
+  } else {
+    memcpy(clone,state,sizeof(struct state_struct));
+    clone->print_output          = (int64_t)0;
+    clone->print_ode_concs       = (int64_t)0;
+    clone->ode_rxn_view_freq     = (int64_t)0;
+    clone->compute_sensitivities = (int64_t)0;
+    clone->num_threads           = (int64_t)1;
+  }
+  /*
+    current_counts (ny), ke, rke, activities, enzyme_level (num_rxns).
+  */
+  if (success) {
+    ask_for = ((int64_t)(ny + (4*num_rxns))) << 3;
+    vectors = (double *)calloc(one_l,ask_for);
+    if (vectors == NULL) {
+      success = 0;
+      if (lfp) {
+	fprintf(lfp,"sweep_clone_state: Error unable to allocate %ld bytes "
+		"for sample vectors\n",ask_for);
+	fflush(lfp);
+      }
+    } else {
+      clone->current_counts = vectors;
+      clone->ke             = &clone->current_counts[ny];
+      clone->rke            = &clone->ke[num_rxns];
+      clone->activities     = &clone->rke[num_rxns];
+      clone->enzyme_level   = &clone->activities[num_rxns];
+      memcpy(clone->current_counts,state->current_counts,ny*sizeof(double));
+      memcpy(clone->ke,state->ke,num_rxns*sizeof(double));
+      memcpy(clone->rke,state->rke,num_rxns*sizeof(double));
+      memcpy(clone->activities,state->activities,num_rxns*sizeof(double));
+      if (state->enzyme_level) {
+	memcpy(clone->enzyme_level,state->enzyme_level,
+	       num_rxns*sizeof(double));
+      }
+    }
+  }
+  if (success) {
+    cvodes_params = (struct cvodes_params_struct *)
+      calloc(one_l,state->cvodes_params_size);
+    ode23tb_params = (struct ode23tb_params_struct *)
+      calloc(one_l,state->ode23tb_params_size);
+    if ((cvodes_params == NULL) || (ode23tb_params == NULL)) {
+      success = 0;
+      if (lfp) {
+	fprintf(lfp,"sweep_clone_state: Error unable to allocate ode "
+		"parameter structs\n");
+	fflush(lfp);
+      }
+    } else {
+      memcpy(cvodes_params,state->cvodes_params,state->cvodes_params_size);
+      memcpy(ode23tb_params,state->ode23tb_params,
+	     state->ode23tb_params_size);
+      clone->cvodes_params  = cvodes_params;
+      clone->ode23tb_params = ode23tb_params;
+    }
+  }
+  if (success) {
+    success = alloc7(clone);
+  }
+  if (success) {
+    success = alloc8(clone);
+  }
+  *clone_p = clone;
+  return(success);
+}
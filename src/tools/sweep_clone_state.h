@@ -0,0 +1,5 @@
+#ifndef _SWEEP_CLONE_STATE_H_
+#define _SWEEP_CLONE_STATE_H_ 1
+extern int sweep_clone_state(struct state_struct *state,
+			     struct state_struct **clone_p);
+#endif
@@ -0,0 +1,99 @@
+#include "boltzmann_structs.h"
+#include "boltzmann_cvodes_headers.h"
+#include "cvodes_params_struct.h"
+#include "sweep_struct.h"
+#include "deq_run.h"
+#include "sweep_run_sample.h"
+int sweep_run_sample(struct state_struct *state,
+		     struct state_struct *clone,
+		     struct sweep_struct *sweep,
+		     int sample) {
+  /*
+    Run sample number sample of the sweep on clone, a copy of state
+    made by sweep_clone_state. The clone's counts, equilibrium constants,
+    activities and ode parameter structs are reset from state, the
+    sample overrides applied and deq_run called. The steady state
+    concentrations go in row sample of sweep->results and the deq_run
+    return value in sweep->statuses[sample].
+    Resetting from state every time makes each sample's result
+    independent of which thread ran it and what it ran before.
+    ke multipliers also scale the reverse constants, rke = 1/ke.
+    Activity overrides set enzyme_level as well, so regulated
+    reactions are scaled from the new level.
+
+    Called by: bsweep
+    Calls:     deq_run, memcpy
+  */
+  double *ke;
+  double *rke;
+  double *activities;
+  double *enzyme_level;
+  double *values;
+  double *concs;
+  double *result;
+  int    *kinds;
+  int    *indices;
+  int    *sample_ptrs;
+  int ny;
+  int num_rxns;
+  int i;
+  int j;
+  int index;
+  int success;
+
+  ny           = (int)state->nunique_molecules;
+  num_rxns     = (int)state->number_reactions;
+  values       = sweep->values;
+  kinds        = sweep->kinds;
+  indices      = sweep->indices;
+  sample_ptrs  = sweep->sample_ptrs;
+  ke           = clone->ke;
+  rke          = clone->rke;
+  activities   = clone->activities;
+  enzyme_level = clone->enzyme_level;
+
+  memcpy(clone->current_counts,state->current_counts,ny*sizeof(double));
+  memcpy(ke,state->ke,num_rxns*sizeof(double));
+  memcpy(activities,state->activities,num_rxns*sizeof(double));
+  if (state->enzyme_level) {
+    memcpy(enzyme_level,state->enzyme_level,num_rxns*sizeof(double));
+  }
+  /*
+    A cvodes context kept by the clone (CVODES_REUSE_CONTEXT 1) is
+    re-armed from scratch by the next boltzmann_cvodes call, so the
+    clone's cvodes_params, which point into it, are left alone.
+  */
+  if (clone->cvodes_params->cvode_mem == NULL) {
+    memcpy(clone->cvodes_params,state->cvodes_params,
+	   state->cvodes_params_size);
+  }
+  memcpy(clone->ode23tb_params,state->ode23tb_params,
+	 state->ode23tb_params_size);
+  clone->flux_scaling = state->flux_scaling;
+  for (j=sample_ptrs[sample];j<sample_ptrs[sample+1];j++) {
+    index = indices[j];
+    switch (kinds[j]) {
+    case SWEEP_KE:
+      ke[index] = ke[index] * values[j];
+      break;
+    case SWEEP_ACT:
+      activities[index]   = values[j];
+      enzyme_level[index] = values[j];
+      break;
+    case SWEEP_CONC:
+      clone->current_counts[index] = values[j] * state->conc_to_count[index];
+      break;
+    }
+  }
+  for (i=0;i<num_rxns;i++) {
+    rke[i] = 1.0/ke[i];
+  }
+  success = deq_run(clone);
+  concs   = clone->ode_concs;
+  result  = &sweep->results[((int64_t)sample) * ny];
+  for (i=0;i<ny;i++) {
+    result[i] = concs[i];
+  }
+  sweep->statuses[sample] = success;
+  return(success);
+}
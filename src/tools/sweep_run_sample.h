@@ -0,0 +1,7 @@
+#ifndef _SWEEP_RUN_SAMPLE_H_
+#define _SWEEP_RUN_SAMPLE_H_ 1
+extern int sweep_run_sample(struct state_struct *state,
+			    struct state_struct *clone,
+			    struct sweep_struct *sweep,
+			    int sample);
+#endif
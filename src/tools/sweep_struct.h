@@ -0,0 +1,46 @@
+#ifndef _SWEEP_STRUCT_H_
+#define _SWEEP_STRUCT_H_ 1
+/*
+  Sample table for the bsweep parameter sweep tool, filled by
+  read_sweep_file. Sample k applies overrides
+  sample_ptrs[k] .. sample_ptrs[k+1]-1 to the base model.
+*/
+#define SWEEP_KE   1
+#define SWEEP_ACT  2
+#define SWEEP_CONC 3
+struct sweep_struct {
+  /*
+    Override values, length number_overrides.
+    ke multipliers, activities, or initial concentrations.
+  */
+  double *values;
+  /*
+    Steady state concentrations, number_samples rows of
+    nunique_molecules.
+  */
+  double *results;
+  /*
+    Override kind (SWEEP_KE, SWEEP_ACT, SWEEP_CONC) and the
+    reaction or species index it applies to, length number_overrides.
+  */
+  int    *kinds;
+  int    *indices;
+  /*
+    Start of each sample in the override vectors,
+    length number_samples + 1.
+  */
+  int    *sample_ptrs;
+  /*
+    deq_run return value for each sample, length number_samples.
+  */
+  int    *statuses;
+  /*
+    Sample labels, number_samples strings of label_len bytes.
+  */
+  char   *labels;
+  int64_t number_samples;
+  int64_t number_overrides;
+  int64_t label_len;
+  int64_t padl;
+};
+#endif